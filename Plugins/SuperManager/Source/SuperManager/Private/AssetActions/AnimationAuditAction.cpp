@@ -0,0 +1,319 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetActions/AnimationAuditAction.h"
+#include "DebugHeader.h"
+#include "SuperManager.h"
+#include "AssetAnalysis/AssetSnapshot.h"
+#include "AssetAnalysis/BulkAssetProcessing.h"
+#include "SlateWidgets/ResultsPanelWidget.h"
+
+#include "EditorUtilityLibrary.h"
+#include "Animation/AnimBoneCompressionCodec.h"
+#include "Animation/AnimBoneCompressionSettings.h"
+#include "Animation/AnimCurveCompressionSettings.h"
+#include "Animation/AnimMontage.h"
+#include "Animation/AnimSequence.h"
+#include "Engine/Blueprint.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/World.h"
+#include "Rendering/SkeletalMeshRenderData.h"
+
+namespace
+{
+	// Translation, rotation and scale as floats, one key per sampled frame
+	constexpr int64 RawBytesPerTrackKey = sizeof(FVector3f) + sizeof(FQuat4f) + sizeof(FVector3f);
+
+	FString DescribeBoneCompression(const UAnimBoneCompressionSettings* Settings)
+	{
+		if (Settings == nullptr) { return TEXT("no bone compression"); }
+
+		TArray<FString> CodecNames;
+		for (const UAnimBoneCompressionCodec* Codec : Settings->Codecs)
+		{
+			if (Codec == nullptr) { continue; }
+
+			CodecNames.Add(Codec->GetClass()->GetName());
+		}
+
+		return Settings->GetName() + TEXT(" [") + FString::Join(CodecNames, TEXT(", ")) + TEXT("]");
+	}
+
+	double ToMegabytes(int64 Bytes)
+	{
+		return Bytes / (1024.0 * 1024.0);
+	}
+}
+
+FString FSkeletalMeshAuditEntry::Describe() const
+{
+	return FString::Printf(TEXT("%s %d bones %d LODs %d vertices ~%.2f MB"), *AssetData.AssetName.ToString(), NumBones, NumLODs, NumVertices,
+		ToMegabytes(ResourceSize));
+}
+
+FString FAnimSequenceAuditEntry::Describe() const
+{
+	return FString::Printf(TEXT("%s %.2fs %.0f fps %d tracks, %.2f MB raw -> %.2f MB (%.0f%%), %s"), *AssetData.AssetName.ToString(), PlayLength,
+		FrameRate, NumBoneTracks, ToMegabytes(RawSize), ToMegabytes(CompressedSize), GetCompressionRatio() * 100.f, *BoneCompression);
+}
+
+void UAnimationAuditAction::AuditAnimations(int32 MaxBones, float MaxFrameRate, float MinCompressionRatio)
+{
+	TArray<FAssetData> SelectedAssetsData = UEditorUtilityLibrary::GetSelectedAssetData();
+
+	// Bone counts, LODs, codecs and compressed sizes live on the loaded assets only, so they are read in waves
+	SelectedAssetsData.RemoveAll([](const FAssetData& AssetData)
+		{
+			return AssetData.IsInstanceOf(USkeletalMesh::StaticClass()) == false && AssetData.IsInstanceOf(UAnimSequence::StaticClass()) == false;
+		});
+
+	if (SelectedAssetsData.Num() == 0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Please select skeletal meshes or anim sequences"));
+		return;
+	}
+
+	TArray<FSkeletalMeshAuditEntry> MeshEntries;
+	TArray<FAnimSequenceAuditEntry> SequenceEntries;
+
+	FSuperManagerBulkSettings Settings;
+	Settings.bSaveModifiedAssets = false;
+
+	SuperManagerBulk::ProcessAssets(SelectedAssetsData, [&MeshEntries, &SequenceEntries](UObject* LoadedAsset)
+		{
+			if (USkeletalMesh* SkeletalMesh = Cast<USkeletalMesh>(LoadedAsset))
+			{
+				AuditSkeletalMesh(SkeletalMesh, MeshEntries.AddDefaulted_GetRef());
+			}
+			else if (UAnimSequence* AnimSequence = Cast<UAnimSequence>(LoadedAsset))
+			{
+				AuditAnimSequence(AnimSequence, SequenceEntries.AddDefaulted_GetRef());
+			}
+
+			return false;
+		},
+		Settings);
+
+	MeshEntries.Sort([](const FSkeletalMeshAuditEntry& A, const FSkeletalMeshAuditEntry& B) { return A.ResourceSize > B.ResourceSize; });
+	SequenceEntries.Sort([](const FAnimSequenceAuditEntry& A, const FAnimSequenceAuditEntry& B) { return A.CompressedSize > B.CompressedSize; });
+
+	int64 TotalMeshSize = 0;
+	int64 TotalRawSize = 0;
+	int64 TotalCompressedSize = 0;
+
+	TSharedRef<FSuperManagerResultsReport> Report = MakeShared<FSuperManagerResultsReport>();
+	Report->Title = TEXT("Animation Audit");
+
+	for (const FSkeletalMeshAuditEntry& Entry : MeshEntries)
+	{
+		TotalMeshSize += Entry.ResourceSize;
+
+		const TCHAR* Group = TEXT("Skeletal meshes");
+		if (Entry.NumBones > MaxBones) { Group = TEXT("Skeletal meshes over the bone budget"); }
+		else if (Entry.NumLODs < 2) { Group = TEXT("Skeletal meshes without LODs"); }
+
+		Report->AddItem(Group, Entry.Describe(), Entry.AssetData.GetSoftObjectPath().ToString());
+	}
+
+	for (const FAnimSequenceAuditEntry& Entry : SequenceEntries)
+	{
+		TotalRawSize += Entry.RawSize;
+		TotalCompressedSize += Entry.CompressedSize;
+
+		const TCHAR* Group = TEXT("Anim sequences");
+		if (Entry.GetCompressionRatio() > MinCompressionRatio) { Group = TEXT("Anim sequences compressing poorly"); }
+		else if (Entry.FrameRate > MaxFrameRate + KINDA_SMALL_NUMBER) { Group = TEXT("Anim sequences above the frame rate budget"); }
+
+		Report->AddItem(Group, Entry.Describe(), Entry.AssetData.GetSoftObjectPath().ToString());
+	}
+
+	Report->Summary = FString::Printf(TEXT("%d skeletal meshes ~%.2f MB, %d anim sequences %.2f MB raw -> %.2f MB compressed"),
+		MeshEntries.Num(), ToMegabytes(TotalMeshSize), SequenceEntries.Num(), ToMegabytes(TotalRawSize), ToMegabytes(TotalCompressedSize));
+
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	SuperManagerModule.ShowResultsReport(Report);
+}
+
+void UAnimationAuditAction::ListUnusedAnimSequences()
+{
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	const FSuperManagerAssetSnapshotRef Snapshot = SuperManagerModule.GetProjectAssetSnapshot();
+
+	const int32 NumPackages = Snapshot->NumPackages();
+
+	// Blueprints (anim blueprints included), montages and maps play animations; blend spaces, composites and the
+	// like only pass them on, so a sequence counts as used when a player reaches it through those alone
+	TBitArray<> PlayerPackages(false, NumPackages);
+	TBitArray<> AnimationPackages(false, NumPackages);
+
+	for (int32 AssetIndex = 0; AssetIndex < Snapshot->NumAssets(); AssetIndex++)
+	{
+		const FAssetData& AssetData = Snapshot->GetAsset(AssetIndex);
+		const int32 PackageIndex = Snapshot->GetAssetPackageIndex(AssetIndex);
+
+		if (AssetData.IsInstanceOf(UBlueprint::StaticClass()) || AssetData.IsInstanceOf(UAnimMontage::StaticClass()) || AssetData.IsInstanceOf(UWorld::StaticClass()))
+		{
+			PlayerPackages[PackageIndex] = true;
+		}
+		else if (AssetData.IsInstanceOf(UAnimationAsset::StaticClass()))
+		{
+			AnimationPackages[PackageIndex] = true;
+		}
+	}
+
+	// One sweep from every player at once instead of a referencer search per selected sequence
+	TBitArray<> UsedPackages(false, NumPackages);
+	TArray<int32> PackageStack;
+
+	for (TConstSetBitIterator<> It(PlayerPackages); It; ++It)
+	{
+		PackageStack.Push(It.GetIndex());
+	}
+
+	while (PackageStack.Num() > 0)
+	{
+		const int32 Package = PackageStack.Pop(false);
+		const TConstArrayView<int32> Dependencies = Snapshot->GetDependencies(Package);
+		const TConstArrayView<ESuperManagerDependencyKind> DependencyKinds = Snapshot->GetDependencyKinds(Package);
+
+		for (int32 EdgeIndex = 0; EdgeIndex < Dependencies.Num(); EdgeIndex++)
+		{
+			const int32 Dependency = Dependencies[EdgeIndex];
+			if (UsedPackages[Dependency] || EnumHasAnyFlags(DependencyKinds[EdgeIndex], ESuperManagerDependencyKind::Package) == false) { continue; }
+
+			UsedPackages[Dependency] = true;
+
+			if (AnimationPackages[Dependency])
+			{
+				PackageStack.Push(Dependency);
+			}
+		}
+	}
+
+	TArray<FAssetData> SelectedAssetsData = UEditorUtilityLibrary::GetSelectedAssetData();
+	TArray<FAssetData> UnusedSequences;
+
+	for (const FAssetData& SelectedAssetData : SelectedAssetsData)
+	{
+		if (SelectedAssetData.IsInstanceOf(UAnimSequence::StaticClass()) == false) { continue; }
+
+		const int32 PackageIndex = Snapshot->FindPackageIndex(SelectedAssetData.PackageName);
+		if (PackageIndex != INDEX_NONE && UsedPackages[PackageIndex]) { continue; }
+
+		UnusedSequences.Add(SelectedAssetData);
+	}
+
+	if (UnusedSequences.Num() == 0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("Every selected anim sequence is used by a blueprint, montage or map"));
+		return;
+	}
+
+	TSharedRef<FSuperManagerResultsReport> Report = MakeShared<FSuperManagerResultsReport>();
+	Report->Title = TEXT("Unused Anim Sequences");
+	Report->Summary = FString::FromInt(UnusedSequences.Num()) + TEXT(" anim sequences no blueprint, montage or map uses, directly or through other animation assets");
+
+	for (const FAssetData& UnusedSequence : UnusedSequences)
+	{
+		Report->AddItem(FString(), UnusedSequence.AssetName.ToString(), UnusedSequence.GetSoftObjectPath().ToString());
+	}
+
+	SuperManagerModule.ShowResultsReport(Report);
+}
+
+void UAnimationAuditAction::ApplyAnimCompression(UAnimBoneCompressionSettings* BoneCompressionSettings, UAnimCurveCompressionSettings* CurveCompressionSettings, int32 WaveSize, int32 MemoryCeilingMB)
+{
+	if (BoneCompressionSettings == nullptr && CurveCompressionSettings == nullptr)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Please pick bone or curve compression settings to apply"));
+		return;
+	}
+
+	if (WaveSize <= 0 || MemoryCeilingMB <= 0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Please enter a VALID wave size and memory ceiling"));
+		return;
+	}
+
+	TArray<FAssetData> SelectedAssetsData = UEditorUtilityLibrary::GetSelectedAssetData();
+	SelectedAssetsData.RemoveAll([](const FAssetData& AssetData) { return AssetData.IsInstanceOf(UAnimSequence::StaticClass()) == false; });
+
+	if (SelectedAssetsData.Num() == 0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Please select anim sequences"));
+		return;
+	}
+
+	FSuperManagerBulkSettings Settings;
+	Settings.WaveSize = WaveSize;
+	Settings.MemoryCeilingMB = MemoryCeilingMB;
+
+	const FSuperManagerBulkStats Stats = SuperManagerBulk::ProcessAssets(SelectedAssetsData, [BoneCompressionSettings, CurveCompressionSettings](UObject* LoadedAsset)
+		{
+			UAnimSequence* AnimSequence = Cast<UAnimSequence>(LoadedAsset);
+			if (AnimSequence == nullptr) { return false; }
+
+			const bool bShouldChangeBones = BoneCompressionSettings && AnimSequence->BoneCompressionSettings != BoneCompressionSettings;
+			const bool bShouldChangeCurves = CurveCompressionSettings && AnimSequence->CurveCompressionSettings != CurveCompressionSettings;
+
+			if (bShouldChangeBones == false && bShouldChangeCurves == false) { return false; }
+
+			AnimSequence->Modify();
+
+			if (bShouldChangeBones) { AnimSequence->BoneCompressionSettings = BoneCompressionSettings; }
+			if (bShouldChangeCurves) { AnimSequence->CurveCompressionSettings = CurveCompressionSettings; }
+
+			AnimSequence->PostEditChange();
+
+			// Recompress now rather than in the background, the wave is saved and may be unloaded right after
+			AnimSequence->CacheDerivedDataForCurrentPlatform();
+
+			return true;
+		},
+		Settings);
+
+	DebugHeader::PrintLog(Stats.Describe());
+
+	if (Stats.NumModified == 0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("Selected anim sequences already use these compression settings"));
+		return;
+	}
+
+	DebugHeader::ShowNotifyInfo(TEXT("Successfully recompressed " + FString::FromInt(Stats.NumModified) + " anim sequences"));
+}
+
+void UAnimationAuditAction::AuditSkeletalMesh(USkeletalMesh* SkeletalMesh, FSkeletalMeshAuditEntry& OutEntry)
+{
+	OutEntry.AssetData = FAssetData(SkeletalMesh);
+	OutEntry.NumBones = SkeletalMesh->GetRefSkeleton().GetRawBoneNum();
+	OutEntry.NumLODs = SkeletalMesh->GetLODNum();
+	OutEntry.ResourceSize = SkeletalMesh->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+
+	if (const FSkeletalMeshRenderData* RenderData = SkeletalMesh->GetResourceForRendering())
+	{
+		if (RenderData->LODRenderData.Num() > 0)
+		{
+			OutEntry.NumVertices = RenderData->LODRenderData[0].GetNumVertices();
+		}
+	}
+}
+
+void UAnimationAuditAction::AuditAnimSequence(UAnimSequence* AnimSequence, FAnimSequenceAuditEntry& OutEntry)
+{
+	OutEntry.AssetData = FAssetData(AnimSequence);
+	OutEntry.NumKeys = AnimSequence->GetNumberOfSampledKeys();
+	OutEntry.FrameRate = AnimSequence->GetSamplingFrameRate().AsDecimal();
+	OutEntry.PlayLength = AnimSequence->GetPlayLength();
+
+	if (const IAnimationDataModel* DataModel = AnimSequence->GetDataModel())
+	{
+		OutEntry.NumBoneTracks = DataModel->GetNumBoneTracks();
+	}
+
+	OutEntry.BoneCompression = DescribeBoneCompression(AnimSequence->BoneCompressionSettings);
+	OutEntry.CurveCompression = AnimSequence->CurveCompressionSettings ? AnimSequence->CurveCompressionSettings->GetName() : TEXT("no curve compression");
+
+	OutEntry.RawSize = int64(OutEntry.NumBoneTracks) * OutEntry.NumKeys * RawBytesPerTrackKey;
+	OutEntry.CompressedSize = AnimSequence->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+}
@@ -0,0 +1,265 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetActions/AudioAuditAction.h"
+#include "DebugHeader.h"
+#include "SuperManager.h"
+#include "SlateWidgets/ResultsPanelWidget.h"
+
+#include "EditorUtilityLibrary.h"
+#include "EditorAssetLibrary.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Sound/SoundCue.h"
+
+namespace
+{
+	// The first chunk a streaming wave keeps resident so playback can start immediately
+	constexpr int64 StreamingChunkBytes = 256 * 1024;
+
+	FString GetTagString(const FAssetData& AssetData, const TCHAR* TagName)
+	{
+		FString TagValue;
+		AssetData.GetTagValue(FName(TagName), TagValue);
+
+		return TagValue;
+	}
+
+	// Inherited (and a missing tag) only resolves through the sound class chain, which takes the loaded wave
+	bool GetExplicitLoadingBehavior(const FString& LoadingBehaviorTag, ESoundWaveLoadingBehavior& OutLoadingBehavior)
+	{
+		const int64 LoadingBehaviorValue = StaticEnum<ESoundWaveLoadingBehavior>()->GetValueByNameString(LoadingBehaviorTag);
+		if (LoadingBehaviorValue == INDEX_NONE) { return false; }
+
+		OutLoadingBehavior = ESoundWaveLoadingBehavior(LoadingBehaviorValue);
+
+		return OutLoadingBehavior != ESoundWaveLoadingBehavior::Inherited && OutLoadingBehavior != ESoundWaveLoadingBehavior::Uninitialized;
+	}
+
+	float GetCompressionRatio(ESoundAssetCompressionType CompressionFormat, int32 CompressionQuality)
+	{
+		if (CompressionFormat == ESoundAssetCompressionType::PCM) { return 1.f; }
+		if (CompressionFormat == ESoundAssetCompressionType::ADPCM) { return 0.28f; }
+
+		// Bink, Opus and Ogg all land somewhere around a tenth of PCM
+		return 0.05f + 0.15f * FMath::Clamp(CompressionQuality, 1, 100) / 100.f;
+	}
+
+	int64 EstimateResidentMemory(const FSoundWaveAuditEntry& Entry)
+	{
+		const double PCMBytes = double(Entry.Duration) * Entry.SampleRate * FMath::Max(Entry.NumChannels, 1) * sizeof(int16);
+		const int64 CompressedBytes = int64(PCMBytes * GetCompressionRatio(Entry.CompressionFormat, Entry.CompressionQuality));
+
+		return Entry.bStreaming ? FMath::Min(CompressedBytes, StreamingChunkBytes) : CompressedBytes;
+	}
+}
+
+FString FSoundWaveAuditEntry::Describe() const
+{
+	return FString::Printf(TEXT("%s %.1fs %dHz %dch %s q%d %s ~%.2f MB resident"), *AssetData.AssetName.ToString(), Duration, SampleRate, NumChannels,
+		*CompressionType, CompressionQuality, bStreaming ? TEXT("streaming") : TEXT("inline"), EstimatedResidentMemory / (1024.0 * 1024.0));
+}
+
+void UAudioAuditAction::AuditSoundWaves(float LongWaveSeconds)
+{
+	TArray<FAssetData> SelectedAssetsData = UEditorUtilityLibrary::GetSelectedAssetData();
+	TArray<FSoundWaveAuditEntry> FlaggedWaves;
+	int64 TotalResidentMemory = 0;
+
+	for (const FAssetData& SelectedAssetData : SelectedAssetsData)
+	{
+		FSoundWaveAuditEntry Entry;
+		if (AuditSoundWave(SelectedAssetData, Entry) == false) { continue; }
+
+		TotalResidentMemory += Entry.EstimatedResidentMemory;
+
+		// Long waves should stream and nothing should ship as raw PCM
+		if (Entry.IsUncompressed() || (Entry.Duration > LongWaveSeconds && Entry.bStreaming == false))
+		{
+			FlaggedWaves.Add(MoveTemp(Entry));
+		}
+	}
+
+	if (FlaggedWaves.Num() == 0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("No sound wave issues found amoung selected assets"));
+		return;
+	}
+
+	FlaggedWaves.Sort([](const FSoundWaveAuditEntry& A, const FSoundWaveAuditEntry& B) { return A.EstimatedResidentMemory > B.EstimatedResidentMemory; });
+
+	TSharedRef<FSuperManagerResultsReport> Report = MakeShared<FSuperManagerResultsReport>();
+	Report->Title = TEXT("Sound Wave Audit");
+	Report->Summary = FString::Printf(TEXT("%d sound waves flagged, ~%.2f MB estimated resident memory in selection"),
+		FlaggedWaves.Num(), TotalResidentMemory / (1024.0 * 1024.0));
+
+	for (const FSoundWaveAuditEntry& Entry : FlaggedWaves)
+	{
+		Report->AddItem(Entry.IsUncompressed() ? TEXT("Uncompressed") : TEXT("Long and not streaming"), Entry.Describe(), Entry.AssetData.GetSoftObjectPath().ToString());
+	}
+
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	SuperManagerModule.ShowResultsReport(Report);
+}
+
+void UAudioAuditAction::FixSoundWaves(float StreamingThresholdSeconds, int32 CompressionQuality)
+{
+	if (CompressionQuality <= 0 || CompressionQuality > 100)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Please enter a VALID compression quality (1-100)"));
+		return;
+	}
+
+	TArray<UObject*> SelectedWaves = UEditorUtilityLibrary::GetSelectedAssetsOfClass(USoundWave::StaticClass());
+	TArray<UObject*> ModifiedWaves;
+
+	for (UObject* SelectedObject : SelectedWaves)
+	{
+		USoundWave* SoundWave = Cast<USoundWave>(SelectedObject);
+		if (SoundWave == nullptr) { continue; }
+
+		// Resolved through the sound class chain, so a wave inheriting ForceInline is caught as well
+		const bool bShouldStream = SoundWave->Duration > StreamingThresholdSeconds && SoundWave->IsStreaming() == false;
+		const bool bShouldCompress = SoundWave->GetSoundAssetCompressionType() == ESoundAssetCompressionType::PCM;
+		const bool bShouldChangeQuality = SoundWave->CompressionQuality != CompressionQuality;
+
+		if (bShouldStream == false && bShouldCompress == false && bShouldChangeQuality == false) { continue; }
+
+		SoundWave->Modify();
+
+		if (bShouldStream) { SoundWave->LoadingBehavior = ESoundWaveLoadingBehavior::LoadOnDemand; }
+		if (bShouldCompress) { SoundWave->SetSoundAssetCompressionType(ESoundAssetCompressionType::BinkAudio, false); }
+		if (bShouldChangeQuality) { SoundWave->CompressionQuality = CompressionQuality; }
+
+		SoundWave->PostEditChange();
+		ModifiedWaves.Add(SoundWave);
+	}
+
+	if (ModifiedWaves.Num() == 0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("Selected sound waves already match these settings"));
+		return;
+	}
+
+	// One save for every touched package instead of one per wave
+	UEditorAssetLibrary::SaveLoadedAssets(ModifiedWaves, true);
+
+	DebugHeader::ShowNotifyInfo(TEXT("Successfully fixed " + FString::FromInt(ModifiedWaves.Num()) + " sound waves"));
+}
+
+void UAudioAuditAction::ListOrphanedSounds()
+{
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	TArray<FAssetData> SelectedAssetsData = UEditorUtilityLibrary::GetSelectedAssetData();
+	TArray<FAssetData> EmptyCues;
+	TArray<FAssetData> UnusedWaves;
+
+	for (const FAssetData& SelectedAssetData : SelectedAssetsData)
+	{
+		if (SelectedAssetData.IsInstanceOf(USoundCue::StaticClass()))
+		{
+			TArray<FName> Dependencies;
+			AssetRegistry.GetDependencies(SelectedAssetData.PackageName, Dependencies);
+
+			bool bReferencesWave = false;
+			for (const FName& Dependency : Dependencies)
+			{
+				TArray<FAssetData> DependencyAssets;
+				AssetRegistry.GetAssetsByPackageName(Dependency, DependencyAssets);
+
+				bReferencesWave = DependencyAssets.ContainsByPredicate([](const FAssetData& AssetData) { return AssetData.IsInstanceOf(USoundWave::StaticClass()); });
+				if (bReferencesWave) { break; }
+			}
+
+			if (bReferencesWave == false)
+			{
+				EmptyCues.Add(SelectedAssetData);
+			}
+		}
+		else if (SelectedAssetData.IsInstanceOf(USoundWave::StaticClass()))
+		{
+			TArray<FName> Referencers;
+			AssetRegistry.GetReferencers(SelectedAssetData.PackageName, Referencers);
+
+			if (Referencers.Num() == 0)
+			{
+				UnusedWaves.Add(SelectedAssetData);
+			}
+		}
+	}
+
+	if (EmptyCues.Num() == 0 && UnusedWaves.Num() == 0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("No orphaned sounds found amoung selected assets"));
+		return;
+	}
+
+	TSharedRef<FSuperManagerResultsReport> Report = MakeShared<FSuperManagerResultsReport>();
+	Report->Title = TEXT("Orphaned Sounds");
+	Report->Summary = FString::FromInt(EmptyCues.Num()) + TEXT(" sound cues reference no waves, ")
+		+ FString::FromInt(UnusedWaves.Num()) + TEXT(" sound waves are not used");
+
+	for (const FAssetData& EmptyCue : EmptyCues)
+	{
+		Report->AddItem(TEXT("Sound cues without waves"), EmptyCue.AssetName.ToString(), EmptyCue.GetSoftObjectPath().ToString());
+	}
+
+	for (const FAssetData& UnusedWave : UnusedWaves)
+	{
+		Report->AddItem(TEXT("Sound waves nothing uses"), UnusedWave.AssetName.ToString(), UnusedWave.GetSoftObjectPath().ToString());
+	}
+
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	SuperManagerModule.ShowResultsReport(Report);
+}
+
+bool UAudioAuditAction::AuditSoundWave(const FAssetData& SoundWaveAssetData, FSoundWaveAuditEntry& OutEntry)
+{
+	if (SoundWaveAssetData.IsInstanceOf(USoundWave::StaticClass()) == false) { return false; }
+
+	OutEntry.AssetData = SoundWaveAssetData;
+
+	const FString DurationTag = GetTagString(SoundWaveAssetData, TEXT("Duration"));
+	const FString LoadingBehaviorTag = GetTagString(SoundWaveAssetData, TEXT("LoadingBehavior"));
+
+	ESoundWaveLoadingBehavior LoadingBehavior = ESoundWaveLoadingBehavior::Inherited;
+
+	if (DurationTag.IsEmpty() == false && GetExplicitLoadingBehavior(LoadingBehaviorTag, LoadingBehavior))
+	{
+		OutEntry.Duration = FCString::Atof(*DurationTag);
+		OutEntry.SampleRate = FCString::Atoi(*GetTagString(SoundWaveAssetData, TEXT("SampleRate")));
+		OutEntry.NumChannels = FCString::Atoi(*GetTagString(SoundWaveAssetData, TEXT("NumChannels")));
+		OutEntry.CompressionQuality = FCString::Atoi(*GetTagString(SoundWaveAssetData, TEXT("CompressionQuality")));
+		OutEntry.CompressionType = GetTagString(SoundWaveAssetData, TEXT("SoundAssetCompressionType"));
+
+		// The tag holds the enumerator name, matched whole since ADPCM ends in PCM
+		const int64 CompressionValue = StaticEnum<ESoundAssetCompressionType>()->GetValueByNameString(OutEntry.CompressionType);
+		if (CompressionValue != INDEX_NONE) { OutEntry.CompressionFormat = ESoundAssetCompressionType(CompressionValue); }
+
+		OutEntry.LoadingBehavior = UEnum::GetValueAsString(LoadingBehavior);
+		OutEntry.bStreaming = LoadingBehavior != ESoundWaveLoadingBehavior::ForceInline;
+	}
+	else if (USoundWave* SoundWave = Cast<USoundWave>(SoundWaveAssetData.GetAsset()))
+	{
+		OutEntry.Duration = SoundWave->Duration;
+		OutEntry.SampleRate = SoundWave->GetSampleRateForCurrentPlatform();
+		OutEntry.NumChannels = SoundWave->NumChannels;
+		OutEntry.CompressionQuality = SoundWave->CompressionQuality;
+		OutEntry.CompressionFormat = SoundWave->GetSoundAssetCompressionType();
+		OutEntry.CompressionType = UEnum::GetValueAsString(OutEntry.CompressionFormat);
+		OutEntry.LoadingBehavior = UEnum::GetValueAsString(SoundWave->GetLoadingBehavior());
+		OutEntry.bStreaming = SoundWave->IsStreaming();
+	}
+	else
+	{
+		return false;
+	}
+
+	// Tags may lack the sample rate on older assets; assume the common 48k
+	if (OutEntry.SampleRate <= 0) { OutEntry.SampleRate = 48000; }
+
+	OutEntry.EstimatedResidentMemory = EstimateResidentMemory(OutEntry);
+
+	return true;
+}
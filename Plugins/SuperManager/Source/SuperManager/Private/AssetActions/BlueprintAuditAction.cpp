@@ -0,0 +1,243 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetActions/BlueprintAuditAction.h"
+#include "DebugHeader.h"
+#include "SuperManager.h"
+#include "AssetAnalysis/BulkAssetProcessing.h"
+#include "SlateWidgets/ResultsPanelWidget.h"
+
+#include "EditorUtilityLibrary.h"
+#include "EditorAssetLibrary.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Blueprint.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "K2Node_Event.h"
+#include "EdGraphSchema_K2.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+
+namespace
+{
+	bool HasTickLogic(const UBlueprint* Blueprint)
+	{
+		for (const UEdGraph* Graph : Blueprint->UbergraphPages)
+		{
+			for (const UEdGraphNode* Node : Graph->Nodes)
+			{
+				const UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node);
+				if (EventNode == nullptr || EventNode->EventReference.GetMemberName() != FName(TEXT("ReceiveTick"))) { continue; }
+
+				const UEdGraphPin* ThenPin = EventNode->FindPin(UEdGraphSchema_K2::PN_Then);
+				if (ThenPin && ThenPin->LinkedTo.Num() > 0)
+				{
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
+	int32 CountPlacedInstances(IAssetRegistry& AssetRegistry, FName BlueprintPackageName)
+	{
+		TArray<FName> Referencers;
+		AssetRegistry.GetReferencers(BlueprintPackageName, Referencers);
+
+		int32 NumPlacedInstances = 0;
+
+		for (const FName& Referencer : Referencers)
+		{
+			// World partition saves every placed actor as its own package
+			if (Referencer.ToString().Contains(FPackagePath::GetExternalActorsFolderName()))
+			{
+				NumPlacedInstances++;
+				continue;
+			}
+
+			TArray<FAssetData> ReferencerAssets;
+			AssetRegistry.GetAssetsByPackageName(Referencer, ReferencerAssets);
+
+			if (ReferencerAssets.ContainsByPredicate([](const FAssetData& AssetData) { return AssetData.IsInstanceOf(UWorld::StaticClass()); }))
+			{
+				NumPlacedInstances++;
+			}
+		}
+
+		return NumPlacedInstances;
+	}
+}
+
+FString FBlueprintTickAuditEntry::Describe() const
+{
+	return FString::Printf(TEXT("%s: %s, interval %.3fs, tick graph %s, %d nodes, ~%d placed%s"), *AssetData.AssetName.ToString(),
+		bStartWithTickEnabled ? TEXT("starts ticking") : TEXT("tick disabled at start"), TickInterval, bHasTickLogic ? TEXT("used") : TEXT("empty"),
+		NumGraphNodes, NumPlacedInstances, bIsDataOnly ? TEXT(", data only") : TEXT(""));
+}
+
+void UBlueprintAuditAction::AuditBlueprintTick()
+{
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	TArray<FAssetData> BlueprintsData;
+	GetSelectedActorBlueprintsData(BlueprintsData);
+
+	TArray<FBlueprintTickAuditEntry> TickingBlueprints;
+
+	FSuperManagerBulkSettings Settings;
+	Settings.bSaveModifiedAssets = false;
+
+	// Only the entries outlive a wave; the Blueprints this pass loaded are unloaded again once memory runs high
+	SuperManagerBulk::ProcessAssets(BlueprintsData, [&AssetRegistry, &TickingBlueprints](UObject* LoadedAsset)
+		{
+			const UBlueprint* Blueprint = Cast<UBlueprint>(LoadedAsset);
+			if (Blueprint == nullptr || Blueprint->GeneratedClass == nullptr) { return false; }
+
+			const AActor* ActorDefaults = Blueprint->GeneratedClass->GetDefaultObject<AActor>();
+			if (ActorDefaults == nullptr || ActorDefaults->PrimaryActorTick.bCanEverTick == false) { return false; }
+
+			FBlueprintTickAuditEntry Entry;
+			Entry.AssetData = FAssetData(Blueprint);
+			Entry.bCanEverTick = true;
+			Entry.bStartWithTickEnabled = ActorDefaults->PrimaryActorTick.bStartWithTickEnabled;
+			Entry.TickInterval = ActorDefaults->PrimaryActorTick.TickInterval;
+			Entry.bHasTickLogic = HasTickLogic(Blueprint);
+			Entry.bIsDataOnly = FBlueprintEditorUtils::IsDataOnlyBlueprint(Blueprint);
+
+			TArray<UEdGraph*> Graphs;
+			Blueprint->GetAllGraphs(Graphs);
+			for (const UEdGraph* Graph : Graphs)
+			{
+				Entry.NumGraphNodes += Graph->Nodes.Num();
+			}
+
+			Entry.NumPlacedInstances = CountPlacedInstances(AssetRegistry, Entry.AssetData.PackageName);
+
+			TickingBlueprints.Add(MoveTemp(Entry));
+			return false;
+		},
+		Settings);
+
+	if (TickingBlueprints.Num() == 0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("No tick enabled Blueprints found amoung selected assets"));
+		return;
+	}
+
+	// Every frame tickers with many placed copies and nothing in their tick graph are the cheapest wins
+	TickingBlueprints.Sort([](const FBlueprintTickAuditEntry& A, const FBlueprintTickAuditEntry& B)
+		{
+			if (A.TicksEveryFrame() != B.TicksEveryFrame()) { return A.TicksEveryFrame(); }
+			return A.NumPlacedInstances > B.NumPlacedInstances;
+		});
+
+	TSharedRef<FSuperManagerResultsReport> Report = MakeShared<FSuperManagerResultsReport>();
+	Report->Title = TEXT("Blueprint Tick Audit");
+
+	int32 NumWastedTicks = 0;
+
+	for (const FBlueprintTickAuditEntry& Entry : TickingBlueprints)
+	{
+		const bool bWastedTick = Entry.bStartWithTickEnabled && Entry.bHasTickLogic == false;
+		NumWastedTicks += bWastedTick ? 1 : 0;
+
+		Report->AddItem(bWastedTick ? TEXT("Ticking with an empty tick graph") : TEXT("Ticking"), Entry.Describe(), Entry.AssetData.GetSoftObjectPath().ToString());
+	}
+
+	Report->Summary = FString::FromInt(TickingBlueprints.Num()) + TEXT(" Blueprints can tick, ")
+		+ FString::FromInt(NumWastedTicks) + TEXT(" of them start ticking with an empty tick graph");
+
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	SuperManagerModule.ShowResultsReport(Report);
+}
+
+void UBlueprintAuditAction::ApplyTickInterval(float TickInterval)
+{
+	if (TickInterval < 0.f)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Please enter a VALID tick interval"));
+		return;
+	}
+
+	ModifyActorDefaults([TickInterval](const AActor* ActorDefaults)
+		{
+			return FMath::IsNearlyEqual(ActorDefaults->PrimaryActorTick.TickInterval, TickInterval) == false;
+		},
+		[TickInterval](AActor* ActorDefaults)
+		{
+			ActorDefaults->PrimaryActorTick.TickInterval = TickInterval;
+		},
+		TEXT("Applied tick interval to "));
+}
+
+void UBlueprintAuditAction::DisableStartWithTick()
+{
+	ModifyActorDefaults([](const AActor* ActorDefaults)
+		{
+			return ActorDefaults->PrimaryActorTick.bStartWithTickEnabled;
+		},
+		[](AActor* ActorDefaults)
+		{
+			ActorDefaults->PrimaryActorTick.bStartWithTickEnabled = false;
+		},
+		TEXT("Disabled start with tick on "));
+}
+
+void UBlueprintAuditAction::GetSelectedActorBlueprintsData(TArray<FAssetData>& OutBlueprintsData) const
+{
+	OutBlueprintsData.Empty();
+
+	for (const FAssetData& SelectedAssetData : UEditorUtilityLibrary::GetSelectedAssetData())
+	{
+		if (SelectedAssetData.IsInstanceOf(UBlueprint::StaticClass()) == false) { continue; }
+
+		const FString NativeParentClassPath = FPackageName::ExportTextPathToObjectPath(SelectedAssetData.GetTagValueRef<FString>(FBlueprintTags::NativeParentClassPath));
+		const UClass* NativeParentClass = FindObject<UClass>(nullptr, *NativeParentClassPath);
+
+		if (NativeParentClass && NativeParentClass->IsChildOf(AActor::StaticClass()))
+		{
+			OutBlueprintsData.Add(SelectedAssetData);
+		}
+	}
+}
+
+void UBlueprintAuditAction::ModifyActorDefaults(TFunctionRef<bool(const AActor*)> NeedsChange, TFunctionRef<void(AActor*)> ApplyChange, const FString& ActionDescription)
+{
+	TArray<FAssetData> BlueprintsData;
+	GetSelectedActorBlueprintsData(BlueprintsData);
+
+	TArray<UObject*> ModifiedBlueprints;
+
+	for (const FAssetData& BlueprintData : BlueprintsData)
+	{
+		UBlueprint* Blueprint = Cast<UBlueprint>(BlueprintData.GetAsset());
+		if (Blueprint == nullptr || Blueprint->GeneratedClass == nullptr) { continue; }
+
+		AActor* ActorDefaults = Blueprint->GeneratedClass->GetDefaultObject<AActor>();
+		if (ActorDefaults == nullptr) { continue; }
+
+		// Defaults that already match stay out of the transaction buffer and are not dirtied
+		if (NeedsChange(ActorDefaults) == false) { continue; }
+
+		ActorDefaults->Modify();
+		ApplyChange(ActorDefaults);
+
+		FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+		FKismetEditorUtilities::CompileBlueprint(Blueprint);
+
+		ModifiedBlueprints.Add(Blueprint);
+	}
+
+	if (ModifiedBlueprints.Num() == 0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("Selected Blueprints already match these settings"));
+		return;
+	}
+
+	// One save for every touched package instead of one per Blueprint
+	UEditorAssetLibrary::SaveLoadedAssets(ModifiedBlueprints, true);
+
+	DebugHeader::ShowNotifyInfo(ActionDescription + FString::FromInt(ModifiedBlueprints.Num()) + TEXT(" Blueprints"));
+}
@@ -0,0 +1,177 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetActions/EffectsAuditAction.h"
+#include "DebugHeader.h"
+#include "SuperManager.h"
+#include "AssetAnalysis/BulkAssetProcessing.h"
+#include "SlateWidgets/ResultsPanelWidget.h"
+
+#include "EditorUtilityLibrary.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Particles/ParticleSystem.h"
+#include "NiagaraSystem.h"
+#include "NiagaraEmitter.h"
+#include "NiagaraScript.h"
+#include "Misc/FileHelper.h"
+
+namespace
+{
+	// Systems requested from the async loader together
+	constexpr int32 LoadWaveSize = 8;
+
+	float FindSpawnRate(const UNiagaraScript* Script)
+	{
+		if (Script == nullptr) { return 0.f; }
+
+		// Module inputs live in the rapid iteration parameters as e.g. "Constants.Emitter.SpawnRate.SpawnRate"
+		float HighestSpawnRate = 0.f;
+
+		for (const FNiagaraVariableWithOffset& Parameter : Script->RapidIterationParameters.ReadParameterVariables())
+		{
+			if (Parameter.GetType() != FNiagaraTypeDefinition::GetFloatDef()) { continue; }
+			if (Parameter.GetName().ToString().Contains(TEXT("SpawnRate")) == false) { continue; }
+
+			HighestSpawnRate = FMath::Max(HighestSpawnRate, Script->RapidIterationParameters.GetParameterValue<float>(FNiagaraVariable(Parameter)));
+		}
+
+		return HighestSpawnRate;
+	}
+}
+
+FString FEffectAuditEntry::DescribeIssues() const
+{
+	TArray<FString> Issues;
+
+	if (bLegacyCascade) { Issues.Add(FString::Printf(TEXT("legacy Cascade referenced by %d packages"), NumReferencers)); }
+	if (bMissingFixedBounds) { Issues.Add(TEXT("no fixed bounds")); }
+	if (bMissingScalability) { Issues.Add(TEXT("no effect type for scalability/culling")); }
+	if (HighestCPUSpawnRate > 0.f) { Issues.Add(FString::Printf(TEXT("%d CPU emitters spawning up to %.0f/s"), NumCPUEmitters, HighestCPUSpawnRate)); }
+
+	return FString::Join(Issues, TEXT("; "));
+}
+
+void UEffectsAuditAction::AuditEffects(float SpawnRateThreshold, int32 MemoryBudgetMB)
+{
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	TArray<FAssetData> SelectedAssetsData = UEditorUtilityLibrary::GetSelectedAssetData();
+	TArray<FAssetData> NiagaraSystemsData;
+	TArray<FEffectAuditEntry> FlaggedEffects;
+
+	for (const FAssetData& SelectedAssetData : SelectedAssetsData)
+	{
+		if (SelectedAssetData.IsInstanceOf(UNiagaraSystem::StaticClass()))
+		{
+			NiagaraSystemsData.Add(SelectedAssetData);
+			continue;
+		}
+
+		// Cascade needs no loading, the registry knows who still points at it
+		if (SelectedAssetData.IsInstanceOf(UParticleSystem::StaticClass()))
+		{
+			TArray<FName> Referencers;
+			AssetRegistry.GetReferencers(SelectedAssetData.PackageName, Referencers);
+
+			if (Referencers.Num() == 0) { continue; }
+
+			FEffectAuditEntry Entry;
+			Entry.AssetData = SelectedAssetData;
+			Entry.bLegacyCascade = true;
+			Entry.NumReferencers = Referencers.Num();
+			Entry.CostScore = 10.f * Referencers.Num();
+
+			FlaggedEffects.Add(MoveTemp(Entry));
+		}
+	}
+
+	FSuperManagerBulkSettings Settings;
+	Settings.WaveSize = LoadWaveSize;
+	Settings.MemoryCeilingMB = FMath::Max(MemoryBudgetMB, 1);
+	Settings.bSaveModifiedAssets = false;
+
+	// Only the entries survive a wave, so the systems this pass loaded are unloaded once memory is over budget
+	SuperManagerBulk::ProcessAssets(NiagaraSystemsData, [this, SpawnRateThreshold, &FlaggedEffects](UObject* LoadedAsset)
+		{
+			const UNiagaraSystem* NiagaraSystem = Cast<UNiagaraSystem>(LoadedAsset);
+			if (NiagaraSystem == nullptr) { return false; }
+
+			FEffectAuditEntry Entry;
+			Entry.AssetData = FAssetData(NiagaraSystem);
+			AuditNiagaraSystem(NiagaraSystem, SpawnRateThreshold, Entry);
+
+			if (Entry.CostScore > 0.f)
+			{
+				FlaggedEffects.Add(MoveTemp(Entry));
+			}
+
+			return false;
+		},
+		Settings);
+
+	if (FlaggedEffects.Num() == 0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("No effect issues found amoung selected assets"));
+		return;
+	}
+
+	FlaggedEffects.Sort([](const FEffectAuditEntry& A, const FEffectAuditEntry& B) { return A.CostScore > B.CostScore; });
+
+	FString ReportPath;
+	ExportReport(FlaggedEffects, ReportPath);
+
+	TSharedRef<FSuperManagerResultsReport> Report = MakeShared<FSuperManagerResultsReport>();
+	Report->Title = TEXT("Effects Audit");
+	Report->Summary = FString::FromInt(FlaggedEffects.Num()) + TEXT(" effects flagged, most expensive first\nRanked report written to ") + ReportPath;
+
+	for (const FEffectAuditEntry& Entry : FlaggedEffects)
+	{
+		Report->AddItem(Entry.bLegacyCascade ? TEXT("Cascade") : TEXT("Niagara"),
+			FString::Printf(TEXT("%s (%.1f): %s"), *Entry.AssetData.AssetName.ToString(), Entry.CostScore, *Entry.DescribeIssues()), Entry.AssetData.GetSoftObjectPath().ToString());
+	}
+
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	SuperManagerModule.ShowResultsReport(Report);
+}
+
+void UEffectsAuditAction::AuditNiagaraSystem(const UNiagaraSystem* NiagaraSystem, float SpawnRateThreshold, FEffectAuditEntry& OutEntry) const
+{
+	OutEntry.bMissingFixedBounds = NiagaraSystem->bFixedBounds == false;
+	OutEntry.bMissingScalability = NiagaraSystem->GetEffectType() == nullptr;
+
+	for (const FNiagaraEmitterHandle& EmitterHandle : NiagaraSystem->GetEmitterHandles())
+	{
+		if (EmitterHandle.GetIsEnabled() == false) { continue; }
+
+		const FVersionedNiagaraEmitterData* EmitterData = EmitterHandle.GetEmitterData();
+		if (EmitterData == nullptr || EmitterData->SimTarget != ENiagaraSimTarget::CPUSim) { continue; }
+
+		const float SpawnRate = FindSpawnRate(EmitterData->EmitterUpdateScriptProps.Script);
+		if (SpawnRate < SpawnRateThreshold) { continue; }
+
+		OutEntry.NumCPUEmitters++;
+		OutEntry.HighestCPUSpawnRate = FMath::Max(OutEntry.HighestCPUSpawnRate, SpawnRate);
+	}
+
+	// CPU particle throughput dominates, missing culling multiplies whatever the effect costs
+	OutEntry.CostScore = OutEntry.HighestCPUSpawnRate / FMath::Max(SpawnRateThreshold, 1.f) * 10.f * OutEntry.NumCPUEmitters;
+	OutEntry.CostScore += OutEntry.bMissingScalability ? 5.f : 0.f;
+	OutEntry.CostScore += OutEntry.bMissingFixedBounds ? 2.f : 0.f;
+}
+
+void UEffectsAuditAction::ExportReport(const TArray<FEffectAuditEntry>& RankedEntries, FString& OutReportPath) const
+{
+	FString Report = TEXT("Rank,Asset,Class,Score,Issues\n");
+
+	for (int32 Rank = 0; Rank < RankedEntries.Num(); Rank++)
+	{
+		const FEffectAuditEntry& Entry = RankedEntries[Rank];
+
+		Report += FString::Printf(TEXT("%d,%s,%s,%.1f,\"%s\"\n"), Rank + 1, *Entry.AssetData.GetObjectPathString(),
+			*Entry.AssetData.AssetClassPath.GetAssetName().ToString(), Entry.CostScore, *Entry.DescribeIssues());
+	}
+
+	OutReportPath = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("SuperManager") / TEXT("EffectsAudit.csv"));
+	FFileHelper::SaveStringToFile(Report, *OutReportPath);
+}
@@ -1,14 +1,17 @@
 
 #include "AssetActions\QuickAssetAction.h"
 #include "DebugHeader.h"
+#include "SuperManager.h"
+#include "SlateWidgets/ResultsPanelWidget.h"
+#include "AssetAnalysis/MaterialAnalysis.h"
 
 #include "EditorUtilityLibrary.h"
 #include "EditorAssetLibrary.h"
-#include "ObjectTools.h"
 
 #include "AssetToolsModule.h"
-#include "AssetViewUtils.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetAnalysis/BulkAssetProcessing.h"
+#include "AssetAnalysis/SourceControlBatch.h"
 
 void UQuickAssetAction::DuplicateAssets(int32 NumOfDuplicates)
 {
@@ -19,6 +22,8 @@ void UQuickAssetAction::DuplicateAssets(int32 NumOfDuplicates)
 	}
 
 	TArray<FAssetData> SelectedAssetsData = UEditorUtilityLibrary::GetSelectedAssetData();
+	TArray<UObject*> DuplicatedAssets;
+	TArray<FName> DuplicatedPackageNames;
 	uint32 Counter = 0;
 
 	for (const FAssetData& SelectedAssetData : SelectedAssetsData)
@@ -29,14 +34,25 @@ void UQuickAssetAction::DuplicateAssets(int32 NumOfDuplicates)
 			const FString NewDuplicatedAssetName = SelectedAssetData.AssetName.ToString() + TEXT("_") + FString::FromInt(i + 1);
 			const FString NewPathName = FPaths::Combine(SelectedAssetData.PackagePath.ToString(), NewDuplicatedAssetName);
 
-			if (UEditorAssetLibrary::DuplicateAsset(SourceAssetPath, NewPathName))
+			if (UObject* DuplicatedAsset = UEditorAssetLibrary::DuplicateAsset(SourceAssetPath, NewPathName))
 			{
-				UEditorAssetLibrary::SaveAsset(NewPathName, false);
+				DuplicatedAssets.Add(DuplicatedAsset);
+				DuplicatedPackageNames.Add(DuplicatedAsset->GetPackage()->GetFName());
 				++Counter;
 			}
 		}
 	}
 
+	// One save and one mark for add for every copy instead of a source control round trip per copy
+	if (DuplicatedAssets.Num() > 0)
+	{
+		UEditorAssetLibrary::SaveLoadedAssets(DuplicatedAssets, false);
+
+		TArray<FString> DuplicatedFilenames;
+		SuperManagerSourceControl::GetPackageFilenames(DuplicatedPackageNames, DuplicatedFilenames);
+		SuperManagerSourceControl::MarkForAdd(DuplicatedFilenames);
+	}
+
 	if (Counter > 0)
 	{
 		DebugHeader::ShowNotifyInfo(TEXT("Successfully duplicated " + FString::FromInt(Counter) + " assets"));
@@ -45,48 +61,47 @@ void UQuickAssetAction::DuplicateAssets(int32 NumOfDuplicates)
 
 void UQuickAssetAction::AddPrefixes()
 {
-	TArray<UObject*> SelectedAssets = UEditorUtilityLibrary::GetSelectedAssets();
+	TArray<FAssetData> SelectedAssetsData = UEditorUtilityLibrary::GetSelectedAssetData();
+	TArray<FAssetData> AssetsToRename;
 	uint32 Counter = 0;
 
-	for (UObject* SelectedAsset : SelectedAssets)
-	{
-		if (SelectedAsset == nullptr) { continue; }
+	// Subclasses share the prefix of their nearest mapped parent, resolved once per class
+	FSuperManagerNamingConvention& NamingConvention =
+		FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager")).GetNamingConvention();
 
-		FString* PrefixFound = PrefixMap.Find(SelectedAsset->GetClass());
-		if (PrefixFound == nullptr || PrefixFound->IsEmpty())
+	// Class and name come from the registry, so only assets that really get renamed are loaded
+	for (const FAssetData& SelectedAssetData : SelectedAssetsData)
+	{
+		const FString& PrefixFound = NamingConvention.GetExpectedPrefix(SelectedAssetData.AssetClassPath);
+		if (PrefixFound.IsEmpty())
 		{
-			DebugHeader::Print(TEXT("Failed to find prefix for calss ") + SelectedAsset->GetClass()->GetName(), FColor::Red);
+			DebugHeader::Print(TEXT("Failed to find prefix for calss ") + SelectedAssetData.AssetClassPath.GetAssetName().ToString(), FColor::Red);
 			continue;
 		}
 
-		FString OldName = SelectedAsset->GetName();
-		if (OldName.StartsWith(*PrefixFound))
+		if (SelectedAssetData.AssetName.ToString().StartsWith(PrefixFound))
 		{
-			DebugHeader::Print(OldName + TEXT(" already has prefix added "), FColor::Red);
+			DebugHeader::Print(SelectedAssetData.AssetName.ToString() + TEXT(" already has prefix added "), FColor::Red);
 			continue;
 		}
 
-		if (SelectedAsset->IsA<UMaterialInstanceConstant>())
-		{
-			OldName.RemoveFromStart("M_");
-			OldName.RemoveFromEnd("_inst");
+		AssetsToRename.Add(SelectedAssetData);
+	}
 
-			if (OldName.Find("_inst"))
-			{
-				int32 StartRemovingIndex = -1;
-				if (OldName.FindLastChar('_', StartRemovingIndex))
-				{
-					OldName.RemoveAt(StartRemovingIndex + 1, 4);
-				}
-			}
-		}
+	SuperManagerSourceControl::PrepareForRename(AssetsToRename);
+
+	SuperManagerBulk::ProcessAssets(AssetsToRename, [&NamingConvention, &Counter](UObject* SelectedAsset)
+		{
+			const FString& PrefixFound = NamingConvention.GetExpectedPrefix(SelectedAsset->GetClass()->GetClassPathName());
+			if (PrefixFound.IsEmpty()) { return false; }
 
-		const FString NewNameWithPrefix = *PrefixFound + OldName;
+			const FString NewNameWithPrefix = GetPrefixedName(SelectedAsset, PrefixFound);
 
-		UEditorUtilityLibrary::RenameAsset(SelectedAsset, NewNameWithPrefix);
+			UEditorUtilityLibrary::RenameAsset(SelectedAsset, NewNameWithPrefix);
 
-		++Counter;
-	}
+			++Counter;
+			return true;
+		});
 
 	if (Counter > 0)
 	{
@@ -94,56 +109,89 @@ void UQuickAssetAction::AddPrefixes()
 	}
 }
 
-void UQuickAssetAction::AddPrefixes_Batched()
+void UQuickAssetAction::GetKnownPrefixes(TArray<FString>& OutPrefixes)
 {
-	for (TPair<UClass*, FString> MappedClass : PrefixMap)
+	OutPrefixes.Empty();
+
+	for (const TPair<UClass*, FString>& MappedClass : GetPrefixMap())
 	{
-		TArray<UObject*> AssetsOfClass = UEditorUtilityLibrary::GetSelectedAssetsOfClass(MappedClass.Key);
+		OutPrefixes.AddUnique(MappedClass.Value);
+	}
+}
 
-		if (AssetsOfClass.Num() == 0) { continue; }
+FString UQuickAssetAction::GetPrefixedName(const UObject* Asset, const FString& Prefix)
+{
+	FString OldName = Asset->GetName();
 
-		FString Prefix = MappedClass.Value;
-		TArray<FAssetRenameData> AssetsAndNames;
+	if (Asset->IsA<UMaterialInstanceConstant>())
+	{
+		OldName.RemoveFromStart("M_");
+		OldName.RemoveFromEnd("_inst");
 
-		for (UObject* AssetOfClass : AssetsOfClass)
+		if (OldName.Find("_inst"))
 		{
-			FString OldName = AssetOfClass->GetName();
-			if (OldName.StartsWith(*Prefix))
+			int32 StartRemovingIndex = -1;
+			if (OldName.FindLastChar('_', StartRemovingIndex))
 			{
-				DebugHeader::Print(OldName + TEXT(" already has prefix added "), FColor::Red);
-				continue;
+				OldName.RemoveAt(StartRemovingIndex + 1, 4);
 			}
+		}
+	}
 
-			if (AssetOfClass->IsA<UMaterialInstanceConstant>())
-			{
-				OldName.RemoveFromStart("M_");
-				OldName.RemoveFromEnd("_inst");
+	return Prefix + OldName;
+}
 
-				if (OldName.Find("_inst"))
-				{
-					int32 StartRemovingIndex = -1;
-					if (OldName.FindLastChar('_', StartRemovingIndex))
-					{
-						OldName.RemoveAt(StartRemovingIndex + 1, 4);
-					}
-				}
-			}
+void UQuickAssetAction::AddPrefixes_Batched()
+{
+	// One prefix per asset, from its nearest mapped class, so a Widget Blueprint is never also renamed as a plain Blueprint
+	FSuperManagerNamingConvention& NamingConvention =
+		FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager")).GetNamingConvention();
 
-			const FString PackagePath = FPackageName::GetLongPackagePath(AssetOfClass->GetOutermost()->GetName());
-			const FString NewNameWithPrefix = *Prefix + OldName;
+	TArray<FAssetData> AssetsDataToRename;
+	TArray<FString> NewPrefixes;
+
+	for (const FAssetData& SelectedAssetData : UEditorUtilityLibrary::GetSelectedAssetData())
+	{
+		const FString& PrefixFound = NamingConvention.GetExpectedPrefix(SelectedAssetData.AssetClassPath);
+		if (PrefixFound.IsEmpty()) { continue; }
 
-			AssetsAndNames.Add(FAssetRenameData(AssetOfClass, PackagePath, NewNameWithPrefix));
+		if (SelectedAssetData.AssetName.ToString().StartsWith(PrefixFound))
+		{
+			DebugHeader::Print(SelectedAssetData.AssetName.ToString() + TEXT(" already has prefix added "), FColor::Red);
+			continue;
 		}
 
-		if (AssetsAndNames.Num() == 0) { continue; }
+		AssetsDataToRename.Add(SelectedAssetData);
+		NewPrefixes.Add(PrefixFound);
+	}
 
-		FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>("AssetTools");
-		EAssetRenameResult RenamingAsetsResult = AssetToolsModule.Get().RenameAssetsWithDialog(AssetsAndNames);
+	if (AssetsDataToRename.Num() == 0) { return; }
 
-		if (RenamingAsetsResult == EAssetRenameResult::Success)
-		{
-			DebugHeader::ShowNotifyInfo(TEXT("Successfully renamed ") + FString::FromInt(AssetsOfClass.Num()) + TEXT(" assets of class ") + MappedClass.Key->GetClass()->GetName());
-		}
+	SuperManagerSourceControl::PrepareForRename(AssetsDataToRename);
+
+	TArray<FAssetRenameData> AssetsAndNames;
+	TMap<FString, int32> RenamedPerClass;
+
+	for (int32 AssetIndex = 0; AssetIndex < AssetsDataToRename.Num(); AssetIndex++)
+	{
+		UObject* AssetToRename = AssetsDataToRename[AssetIndex].GetAsset();
+		if (AssetToRename == nullptr) { continue; }
+
+		const FString PackagePath = FPackageName::GetLongPackagePath(AssetToRename->GetOutermost()->GetName());
+		AssetsAndNames.Add(FAssetRenameData(AssetToRename, PackagePath, GetPrefixedName(AssetToRename, NewPrefixes[AssetIndex])));
+
+		RenamedPerClass.FindOrAdd(AssetToRename->GetClass()->GetName())++;
+	}
+
+	// Every class in one rename, so references are fixed up in a single pass
+	FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>("AssetTools");
+	EAssetRenameResult RenamingAsetsResult = AssetToolsModule.Get().RenameAssetsWithDialog(AssetsAndNames);
+
+	if (RenamingAsetsResult != EAssetRenameResult::Success) { return; }
+
+	for (const TPair<FString, int32>& Renamed : RenamedPerClass)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("Successfully renamed ") + FString::FromInt(Renamed.Value) + TEXT(" assets of class ") + Renamed.Key);
 	}
 }
 
@@ -166,11 +214,11 @@ void UQuickAssetAction::RemoveUnusedAssets()
 
 	if (UnusedAssetsData.Num() == 0)
 	{
-		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No unused assets found amoung selected assets"), false);
+		DebugHeader::ShowNotifyInfo(TEXT("No unused assets found amoung selected assets"));
 		return;
 	}
 
-	int32 NumOfAssetsDeleted = ObjectTools::DeleteAssets(UnusedAssetsData);
+	int32 NumOfAssetsDeleted = SuperManagerSourceControl::DeleteAssets(UnusedAssetsData);
 
 	if (NumOfAssetsDeleted == 0) { return; }
 
@@ -178,6 +226,172 @@ void UQuickAssetAction::RemoveUnusedAssets()
 
 }
 
+void UQuickAssetAction::ListRedundantMaterialInstances()
+{
+	TArray<FAssetData> InstancesData = UEditorUtilityLibrary::GetSelectedAssetData();
+	InstancesData.RemoveAll([](const FAssetData& AssetData) { return AssetData.IsInstanceOf(UMaterialInstanceConstant::StaticClass()) == false; });
+
+	TArray<TArray<FAssetData>> RedundantGroups;
+	SuperManagerMaterials::GroupRedundantInstances(InstancesData, RedundantGroups);
+
+	if (RedundantGroups.Num() == 0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("No redundant material instances found amoung selected assets"));
+		return;
+	}
+
+	TSharedRef<FSuperManagerResultsReport> Report = MakeShared<FSuperManagerResultsReport>();
+	Report->Title = TEXT("Redundant Material Instances");
+
+	int32 NumRedundantInstances = AddRedundantGroupsToReport(*Report, RedundantGroups);
+
+	Report->Summary = FString::FromInt(RedundantGroups.Num()) + TEXT(" groups of identical instances found, ")
+		+ FString::FromInt(NumRedundantInstances) + TEXT(" instances could be consolidated");
+
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	SuperManagerModule.ShowResultsReport(Report);
+}
+
+void UQuickAssetAction::ConsolidateRedundantMaterialInstances()
+{
+	TArray<FAssetData> InstancesData = UEditorUtilityLibrary::GetSelectedAssetData();
+	InstancesData.RemoveAll([](const FAssetData& AssetData) { return AssetData.IsInstanceOf(UMaterialInstanceConstant::StaticClass()) == false; });
+
+	TArray<TArray<FAssetData>> RedundantGroups;
+	SuperManagerMaterials::GroupRedundantInstances(InstancesData, RedundantGroups);
+
+	if (RedundantGroups.Num() == 0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("No redundant material instances found amoung selected assets"));
+		return;
+	}
+
+	TSharedRef<FSuperManagerResultsReport> Report = MakeShared<FSuperManagerResultsReport>();
+	Report->Title = TEXT("Consolidate Material Instances");
+	Report->Summary = FString::FromInt(RedundantGroups.Num()) + TEXT(" groups of identical instances found");
+
+	const int32 NumRedundantInstances = AddRedundantGroupsToReport(*Report, RedundantGroups);
+
+	Report->ConfirmLabel = TEXT("Consolidate ") + FString::FromInt(NumRedundantInstances) + TEXT(" instances");
+	Report->OnConfirm = [WeakThis = TWeakObjectPtr<UQuickAssetAction>(this), RedundantGroups]()
+		{
+			if (WeakThis.IsValid() == false) { return; }
+
+			WeakThis->ConsolidateRedundantGroups(RedundantGroups);
+		};
+
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	SuperManagerModule.ShowResultsReport(Report);
+}
+
+void UQuickAssetAction::ConsolidateRedundantGroups(const TArray<TArray<FAssetData>>& RedundantGroups)
+{
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+
+	int32 NumConsolidatedInstances = 0;
+
+	for (const TArray<FAssetData>& RedundantGroup : RedundantGroups)
+	{
+		// Keep the most referenced instance so the fewest packages have to be rewritten; the previous group's merge
+		// dropped the snapshot, so it is fetched again per group
+		const FSuperManagerAssetSnapshotRef Snapshot = SuperManagerModule.GetProjectAssetSnapshot();
+		int32 SurvivorIndex = 0;
+		int32 SurvivorReferencerCount = -1;
+
+		for (int32 InstanceIndex = 0; InstanceIndex < RedundantGroup.Num(); InstanceIndex++)
+		{
+			TArray<FName> Referencers;
+			Snapshot->ListReferencers(RedundantGroup[InstanceIndex].PackageName, Referencers);
+
+			if (Referencers.Num() > SurvivorReferencerCount)
+			{
+				SurvivorIndex = InstanceIndex;
+				SurvivorReferencerCount = Referencers.Num();
+			}
+		}
+
+		TArray<FAssetData> DuplicatesData = RedundantGroup;
+		DuplicatesData.RemoveAt(SurvivorIndex);
+
+		// Checks out, rewrites referencers in bulk waves and cleans up redirectors, the same path as Consolidate Into Selected
+		NumConsolidatedInstances += SuperManagerModule.ConsolidateAssets(RedundantGroup[SurvivorIndex], DuplicatesData);
+	}
+
+	if (NumConsolidatedInstances == 0) { return; }
+
+	DebugHeader::ShowNotifyInfo(TEXT("Successfully consolidated " + FString::FromInt(NumConsolidatedInstances) + " material instances"));
+}
+
+void UQuickAssetAction::EstimateShaderPermutations()
+{
+	TArray<UObject*> SelectedMaterials = UEditorUtilityLibrary::GetSelectedAssetsOfClass(UMaterial::StaticClass());
+
+	if (SelectedMaterials.Num() == 0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("No materials found amoung selected assets"));
+		return;
+	}
+
+	TArray<FMaterialPermutationInputs> PermutationInputs;
+	PermutationInputs.SetNum(SelectedMaterials.Num());
+
+	for (int32 MaterialIndex = 0; MaterialIndex < SelectedMaterials.Num(); MaterialIndex++)
+	{
+		SuperManagerMaterials::GatherPermutationInputs(CastChecked<UMaterial>(SelectedMaterials[MaterialIndex]), PermutationInputs[MaterialIndex]);
+	}
+
+	TArray<FMaterialPermutationEstimate> Estimates;
+	SuperManagerMaterials::EstimatePermutations(PermutationInputs, Estimates);
+
+	TSharedRef<FSuperManagerResultsReport> Report = MakeShared<FSuperManagerResultsReport>();
+	Report->Title = TEXT("Shader Permutation Estimate");
+
+	int64 TotalShaderCount = 0;
+	int64 TotalDDCBytes = 0;
+
+	for (const FMaterialPermutationEstimate& Estimate : Estimates)
+	{
+		TotalShaderCount += Estimate.PredictedShaderCount;
+		TotalDDCBytes += Estimate.PredictedDDCBytes;
+
+		FString Line = FString::Printf(TEXT("%s: ~%lld shaders (%d static x %d vertex factories x %d quality levels), ~%.1f MB DDC"),
+			*Estimate.MaterialPath, Estimate.PredictedShaderCount, Estimate.NumStaticPermutations, Estimate.NumVertexFactories, Estimate.NumQualityLevels,
+			Estimate.PredictedDDCBytes / (1024.0 * 1024.0));
+
+		if (Estimate.ClearableUsageFlags.Num() > 0)
+		{
+			Line += TEXT(", consider clearing ") + FString::Join(Estimate.ClearableUsageFlags, TEXT(", "));
+		}
+
+		Report->AddItem(FString(), Line, Estimate.MaterialPath);
+	}
+
+	Report->Summary = FString::Printf(TEXT("~%lld shaders and ~%.1f MB of DDC predicted for %d materials, most expensive first"),
+		TotalShaderCount, TotalDDCBytes / (1024.0 * 1024.0), Estimates.Num());
+
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	SuperManagerModule.ShowResultsReport(Report);
+}
+
+int32 UQuickAssetAction::AddRedundantGroupsToReport(FSuperManagerResultsReport& Report, const TArray<TArray<FAssetData>>& RedundantGroups)
+{
+	int32 NumRedundantInstances = 0;
+
+	for (int32 GroupIndex = 0; GroupIndex < RedundantGroups.Num(); GroupIndex++)
+	{
+		const FString GroupName = TEXT("Identical instances ") + FString::FromInt(GroupIndex + 1);
+
+		for (const FAssetData& InstanceData : RedundantGroups[GroupIndex])
+		{
+			Report.AddItem(GroupName, InstanceData.AssetName.ToString(), InstanceData.GetObjectPathString());
+		}
+
+		NumRedundantInstances += RedundantGroups[GroupIndex].Num() - 1;
+	}
+
+	return NumRedundantInstances;
+}
+
 void UQuickAssetAction::FixupRedirectors()
 {
 	// Array for fillin object redirectors
@@ -201,27 +415,28 @@ void UQuickAssetAction::FixupRedirectors()
 
 	if (AssetList.Num() == 0) return;
 
-	TArray<FString> ObjectPaths;
-	for (const FAssetData& Asset : AssetList)
-	{
-		ObjectPaths.Add(Asset.GetObjectPathString());
-	}
+	// Load the asset tools module
+	FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
 
-	TArray<UObject*> Objects;
-	const bool bAllowedToPromptToLoadAssets = true;
-	const bool bLoadRedirects = true;
+	// FixupReferencers resaves the referencers and deletes the redirectors itself
+	FSuperManagerBulkSettings Settings;
+	Settings.bSaveModifiedAssets = false;
 
-	if (AssetViewUtils::LoadAssetsIfNeeded(ObjectPaths, Objects, bAllowedToPromptToLoadAssets, bLoadRedirects))
-	{
-		// Transform Objects array to ObjectRedirectors array
-		TArray<UObjectRedirector*> Redirectors;
-		for (UObject* Object : Objects)
+	// Redirectors are loaded and fixed one wave at a time instead of all at once
+	SuperManagerBulk::ProcessWaves(AssetList, [&AssetToolsModule](const TArray<UObject*>& LoadedAssets, TArray<UObject*>& OutModifiedAssets)
 		{
-			Redirectors.Add(CastChecked<UObjectRedirector>(Object));
-		}
+			TArray<UObjectRedirector*> Redirectors;
+			for (UObject* LoadedAsset : LoadedAssets)
+			{
+				if (UObjectRedirector* Redirector = Cast<UObjectRedirector>(LoadedAsset))
+				{
+					Redirectors.Add(Redirector);
+				}
+			}
 
-		// Load the asset tools module
-		FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
-		AssetToolsModule.Get().FixupReferencers(Redirectors);
-	}
+			if (Redirectors.Num() == 0) { return; }
+
+			AssetToolsModule.Get().FixupReferencers(Redirectors);
+		},
+		Settings);
 }
@@ -0,0 +1,246 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetActions/TextureAuditAction.h"
+#include "DebugHeader.h"
+#include "SuperManager.h"
+#include "AssetAnalysis/BulkAssetProcessing.h"
+#include "SlateWidgets/ResultsPanelWidget.h"
+
+#include "EditorUtilityLibrary.h"
+#include "Engine/Texture2D.h"
+
+namespace
+{
+	// Bits per pixel of the formats StarterContent style textures end up in, keyed like the Format tag: GPixelFormats names, no PF_
+	float GetBitsPerPixel(const FString& Format, const FString& CompressionSettings)
+	{
+		static const TMap<FString, float> FormatBits =
+		{
+			{TEXT("DXT1"), 4.f},
+			{TEXT("BC4"), 4.f},
+			{TEXT("DXT5"), 8.f},
+			{TEXT("BC5"), 8.f},
+			{TEXT("BC6H"), 8.f},
+			{TEXT("BC7"), 8.f},
+			{TEXT("G8"), 8.f},
+			{TEXT("G16"), 16.f},
+			{TEXT("B8G8R8A8"), 32.f},
+			{TEXT("FloatRGBA"), 64.f},
+			{TEXT("R32_FLOAT"), 32.f},
+			{TEXT("A32B32G32R32F"), 128.f}
+		};
+
+		if (const float* FoundBits = FormatBits.Find(Format))
+		{
+			return *FoundBits;
+		}
+
+		if (CompressionSettings == TEXT("TC_HDR") || CompressionSettings == TEXT("TC_HalfFloat")) { return 64.f; }
+		if (CompressionSettings == TEXT("TC_Grayscale") || CompressionSettings == TEXT("TC_Alpha")) { return 8.f; }
+		if (CompressionSettings == TEXT("TC_EditorIcon") || CompressionSettings == TEXT("TC_VectorDisplacementmap")) { return 32.f; }
+		if (CompressionSettings == TEXT("TC_Normalmap") || CompressionSettings == TEXT("TC_BC7")) { return 8.f; }
+
+		// TC_Default and friends end up DXT1/DXT5
+		return 8.f;
+	}
+
+	bool IsUncompressed(const FString& Format, const FString& CompressionSettings)
+	{
+		static const TSet<FString> UncompressedFormats =
+		{
+			TEXT("B8G8R8A8"), TEXT("G8"), TEXT("G16"), TEXT("FloatRGBA"), TEXT("R32_FLOAT"), TEXT("A32B32G32R32F")
+		};
+
+		static const TSet<FString> UncompressedSettings =
+		{
+			TEXT("TC_VectorDisplacementmap"), TEXT("TC_Grayscale"), TEXT("TC_HDR"), TEXT("TC_EditorIcon"), TEXT("TC_HalfFloat"), TEXT("TC_SingleFloat")
+		};
+
+		return Format.IsEmpty() ? UncompressedSettings.Contains(CompressionSettings) : UncompressedFormats.Contains(Format);
+	}
+
+	// Only settings whose compressed counterpart reads the same channels at a close enough precision are swapped
+	bool GetCompressedEquivalent(const UTexture2D* Texture, TextureCompressionSettings& OutCompressionSettings)
+	{
+		switch (Texture->CompressionSettings)
+		{
+		case TC_Grayscale:
+			// BC4 has no sRGB variant, so a gamma encoded mask would come out darker
+			if (Texture->SRGB) { return false; }
+
+			OutCompressionSettings = TC_Alpha;
+			return true;
+
+		case TC_HDR:
+		case TC_HalfFloat:
+			OutCompressionSettings = TC_HDR_Compressed;
+			return true;
+
+		default:
+			return false;
+		}
+	}
+
+	FString GetTagString(const FAssetData& AssetData, const TCHAR* TagName)
+	{
+		FString TagValue;
+		AssetData.GetTagValue(FName(TagName), TagValue);
+
+		return TagValue;
+	}
+}
+
+FString FTextureAuditEntry::DescribeIssues() const
+{
+	TArray<FString> Issues;
+
+	if (bOversized) { Issues.Add(TEXT("oversized")); }
+	if (bNonPowerOfTwo) { Issues.Add(TEXT("non power of two")); }
+	if (bUncompressed) { Issues.Add(TEXT("uncompressed")); }
+	if (bNeverStream) { Issues.Add(TEXT("never streamed")); }
+
+	return FString::Printf(TEXT("%s %dx%d %s ~%.2f MB: %s"), *AssetData.AssetName.ToString(), Width, Height, *CompressionSettings,
+		EstimatedGPUMemory / (1024.0 * 1024.0), *FString::Join(Issues, TEXT(", ")));
+}
+
+void UTextureAuditAction::AuditTextures(int32 MaxAllowedSize)
+{
+	TArray<FAssetData> SelectedAssetsData = UEditorUtilityLibrary::GetSelectedAssetData();
+	TArray<FTextureAuditEntry> FlaggedTextures;
+	int64 TotalGPUMemory = 0;
+	int64 FlaggedGPUMemory = 0;
+
+	for (const FAssetData& SelectedAssetData : SelectedAssetsData)
+	{
+		FTextureAuditEntry Entry;
+		if (AuditTexture(SelectedAssetData, MaxAllowedSize, Entry) == false) { continue; }
+
+		TotalGPUMemory += Entry.EstimatedGPUMemory;
+
+		if (Entry.HasIssues() == false) { continue; }
+
+		FlaggedGPUMemory += Entry.EstimatedGPUMemory;
+		FlaggedTextures.Add(MoveTemp(Entry));
+	}
+
+	if (FlaggedTextures.Num() == 0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("No texture issues found amoung selected assets"));
+		return;
+	}
+
+	// Biggest offenders first
+	FlaggedTextures.Sort([](const FTextureAuditEntry& A, const FTextureAuditEntry& B) { return A.EstimatedGPUMemory > B.EstimatedGPUMemory; });
+
+	TSharedRef<FSuperManagerResultsReport> Report = MakeShared<FSuperManagerResultsReport>();
+	Report->Title = TEXT("Texture Audit");
+	Report->Summary = FString::Printf(TEXT("%d textures flagged, ~%.2f MB of ~%.2f MB estimated GPU memory"),
+		FlaggedTextures.Num(), FlaggedGPUMemory / (1024.0 * 1024.0), TotalGPUMemory / (1024.0 * 1024.0));
+
+	for (const FTextureAuditEntry& Entry : FlaggedTextures)
+	{
+		Report->AddItem(FString(), Entry.DescribeIssues(), Entry.AssetData.GetSoftObjectPath().ToString());
+	}
+
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	SuperManagerModule.ShowResultsReport(Report);
+}
+
+void UTextureAuditAction::FixTextures(int32 MaxTextureSize, bool bCompressUncompressed, bool bChangeLODGroup, TEnumAsByte<TextureGroup> LODGroup)
+{
+	if (MaxTextureSize <= 0 || FMath::IsPowerOfTwo(MaxTextureSize) == false)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Please enter a VALID power of two size"));
+		return;
+	}
+
+	TArray<FAssetData> SelectedAssetsData = UEditorUtilityLibrary::GetSelectedAssetData();
+
+	// The registry rules out most textures without loading them: small enough, in the wanted group, nothing to recompress
+	SelectedAssetsData.RemoveAll([MaxTextureSize, bCompressUncompressed, bChangeLODGroup, LODGroup](const FAssetData& AssetData)
+		{
+			FTextureAuditEntry Entry;
+			if (AuditTexture(AssetData, MaxTextureSize, Entry) == false) { return true; }
+
+			const bool bMayNeedClamp = Entry.Width == 0 || Entry.bOversized;
+			const bool bMayNeedGroup = bChangeLODGroup && Entry.LODGroup != UEnum::GetValueAsString(LODGroup.GetValue());
+			const bool bMayNeedCompress = bCompressUncompressed && (Entry.CompressionSettings.IsEmpty() || Entry.CompressionSettings == TEXT("TC_Grayscale")
+				|| Entry.CompressionSettings == TEXT("TC_HDR") || Entry.CompressionSettings == TEXT("TC_HalfFloat"));
+
+			return bMayNeedClamp == false && bMayNeedGroup == false && bMayNeedCompress == false;
+		});
+
+	const FSuperManagerBulkStats Stats = SuperManagerBulk::ProcessAssets(SelectedAssetsData, [MaxTextureSize, bCompressUncompressed, bChangeLODGroup, LODGroup](UObject* LoadedAsset)
+		{
+			UTexture2D* Texture = Cast<UTexture2D>(LoadedAsset);
+			if (Texture == nullptr) { return false; }
+
+			// 0 means no limit, which only matters when the source really is larger than the target
+			const int32 SourceSize = FMath::Max(Texture->Source.GetSizeX(), Texture->Source.GetSizeY());
+			const bool bIsLimited = Texture->MaxTextureSize > 0 && Texture->MaxTextureSize <= MaxTextureSize;
+
+			const bool bShouldClampSize = SourceSize > MaxTextureSize && bIsLimited == false;
+			const bool bShouldChangeGroup = bChangeLODGroup && Texture->LODGroup != LODGroup;
+
+			TextureCompressionSettings CompressedSettings = TC_Default;
+			const bool bShouldCompress = bCompressUncompressed && GetCompressedEquivalent(Texture, CompressedSettings);
+
+			if (bShouldClampSize == false && bShouldChangeGroup == false && bShouldCompress == false) { return false; }
+
+			Texture->Modify();
+
+			if (bShouldClampSize) { Texture->MaxTextureSize = MaxTextureSize; }
+			if (bShouldChangeGroup) { Texture->LODGroup = LODGroup; }
+			if (bShouldCompress) { Texture->CompressionSettings = CompressedSettings; }
+
+			Texture->PostEditChange();
+			return true;
+		});
+
+	DebugHeader::PrintLog(Stats.Describe());
+
+	if (Stats.NumModified == 0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("Selected textures already match these settings"));
+		return;
+	}
+
+	DebugHeader::ShowNotifyInfo(TEXT("Successfully fixed " + FString::FromInt(Stats.NumModified) + " textures"));
+}
+
+bool UTextureAuditAction::AuditTexture(const FAssetData& TextureAssetData, int32 MaxAllowedSize, FTextureAuditEntry& OutEntry)
+{
+	if (TextureAssetData.IsInstanceOf(UTexture2D::StaticClass()) == false) { return false; }
+
+	OutEntry.AssetData = TextureAssetData;
+
+	// "1024x1024"
+	FString WidthString, HeightString;
+	if (GetTagString(TextureAssetData, TEXT("Dimensions")).Split(TEXT("x"), &WidthString, &HeightString))
+	{
+		OutEntry.Width = FCString::Atoi(*WidthString);
+		OutEntry.Height = FCString::Atoi(*HeightString);
+	}
+
+	OutEntry.Format = GetTagString(TextureAssetData, TEXT("Format"));
+	OutEntry.CompressionSettings = GetTagString(TextureAssetData, TEXT("CompressionSettings"));
+	OutEntry.LODGroup = GetTagString(TextureAssetData, TEXT("LODGroup"));
+	OutEntry.bHasMips = GetTagString(TextureAssetData, TEXT("MipGenSettings")) != TEXT("TMGS_NoMipmaps");
+
+	// UI textures are never streamed; the NeverStream flag itself is no registry tag, so it is only read off textures already in memory
+	OutEntry.bNeverStream = OutEntry.LODGroup == TEXT("TEXTUREGROUP_UI");
+	if (const UTexture2D* LoadedTexture = Cast<UTexture2D>(TextureAssetData.FastGetAsset(false)))
+	{
+		OutEntry.bNeverStream |= LoadedTexture->NeverStream;
+	}
+
+	const double BaseMemory = double(OutEntry.Width) * OutEntry.Height * GetBitsPerPixel(OutEntry.Format, OutEntry.CompressionSettings) / 8.0;
+	OutEntry.EstimatedGPUMemory = int64(OutEntry.bHasMips ? BaseMemory * 4.0 / 3.0 : BaseMemory);
+
+	OutEntry.bOversized = FMath::Max(OutEntry.Width, OutEntry.Height) > MaxAllowedSize;
+	OutEntry.bNonPowerOfTwo = FMath::IsPowerOfTwo(OutEntry.Width) == false || FMath::IsPowerOfTwo(OutEntry.Height) == false;
+	OutEntry.bUncompressed = IsUncompressed(OutEntry.Format, OutEntry.CompressionSettings);
+
+	return true;
+}
@@ -0,0 +1,411 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/AssetQuery.h"
+#include "AssetAnalysis/AssetSnapshot.h"
+
+#include "Misc/ConfigCacheIni.h"
+
+namespace
+{
+	const TCHAR* QueryConfigSection = TEXT("SuperManager");
+	const TCHAR* SavedQueriesConfigKey = TEXT("SavedAssetQueries");
+
+	// Share of the assets a term is assumed to keep when the snapshot cannot tell up front
+	constexpr float UnknownSelectivity = 0.5f;
+
+	bool ParseCompare(const FString& Operator, ESuperManagerQueryCompare& OutCompare)
+	{
+		if (Operator == TEXT(":") || Operator == TEXT("=")) { OutCompare = ESuperManagerQueryCompare::Equal; }
+		else if (Operator == TEXT("<")) { OutCompare = ESuperManagerQueryCompare::Less; }
+		else if (Operator == TEXT("<=")) { OutCompare = ESuperManagerQueryCompare::LessOrEqual; }
+		else if (Operator == TEXT(">")) { OutCompare = ESuperManagerQueryCompare::Greater; }
+		else if (Operator == TEXT(">=")) { OutCompare = ESuperManagerQueryCompare::GreaterOrEqual; }
+		else { return false; }
+
+		return true;
+	}
+
+	const TCHAR* CompareToString(ESuperManagerQueryCompare Compare)
+	{
+		switch (Compare)
+		{
+		case ESuperManagerQueryCompare::Less: return TEXT("<");
+		case ESuperManagerQueryCompare::LessOrEqual: return TEXT("<=");
+		case ESuperManagerQueryCompare::Greater: return TEXT(">");
+		case ESuperManagerQueryCompare::GreaterOrEqual: return TEXT(">=");
+		default: return TEXT("=");
+		}
+	}
+
+	// "4MB", "512kb", "1.5GB" or plain bytes
+	bool ParseByteCount(const FString& Value, int64& OutBytes)
+	{
+		int32 UnitStart = 0;
+		while (UnitStart < Value.Len() && (FChar::IsDigit(Value[UnitStart]) || Value[UnitStart] == TEXT('.')))
+		{
+			UnitStart++;
+		}
+
+		if (UnitStart == 0) { return false; }
+
+		const FString Unit = Value.RightChop(UnitStart);
+		double Multiplier = 1.0;
+
+		if (Unit.IsEmpty() || Unit.Equals(TEXT("B"), ESearchCase::IgnoreCase)) { Multiplier = 1.0; }
+		else if (Unit.Equals(TEXT("KB"), ESearchCase::IgnoreCase)) { Multiplier = 1024.0; }
+		else if (Unit.Equals(TEXT("MB"), ESearchCase::IgnoreCase)) { Multiplier = 1024.0 * 1024.0; }
+		else if (Unit.Equals(TEXT("GB"), ESearchCase::IgnoreCase)) { Multiplier = 1024.0 * 1024.0 * 1024.0; }
+		else { return false; }
+
+		OutBytes = int64(FCString::Atod(*Value.Left(UnitStart)) * Multiplier);
+
+		return true;
+	}
+
+	bool CompareNumber(int64 Value, ESuperManagerQueryCompare Compare, int64 Reference)
+	{
+		switch (Compare)
+		{
+		case ESuperManagerQueryCompare::Less: return Value < Reference;
+		case ESuperManagerQueryCompare::LessOrEqual: return Value <= Reference;
+		case ESuperManagerQueryCompare::Greater: return Value > Reference;
+		case ESuperManagerQueryCompare::GreaterOrEqual: return Value >= Reference;
+		default: return Value == Reference;
+		}
+	}
+
+	// Keeps the indices Predicate accepts (rejects, for a negated term) in place, order preserved
+	template <typename PredicateType>
+	void FilterIndices(TArray<int32>& Indices, bool bNegated, PredicateType Predicate)
+	{
+		int32 NumKept = 0;
+
+		for (int32 Index : Indices)
+		{
+			if (Predicate(Index) != bNegated)
+			{
+				Indices[NumKept++] = Index;
+			}
+		}
+
+		Indices.SetNum(NumKept, false);
+	}
+}
+
+bool FSuperManagerAssetQuery::Parse(const FString& QueryText, FSuperManagerAssetQuery& OutQuery, FString& OutError)
+{
+	OutQuery.Terms.Empty();
+
+	TArray<FString> Tokens;
+	QueryText.ParseIntoArrayWS(Tokens);
+
+	if (Tokens.Num() == 0)
+	{
+		OutError = TEXT("The query is empty");
+		return false;
+	}
+
+	for (const FString& Token : Tokens)
+	{
+		FSuperManagerQueryTerm Term;
+		FString TermText = Token;
+
+		if (TermText.Len() > 1 && TermText[0] == TEXT('-'))
+		{
+			Term.bNegated = true;
+			TermText.RightChopInline(1);
+		}
+
+		if (TermText.Equals(TEXT("unused"), ESearchCase::IgnoreCase))
+		{
+			Term.Field = ESuperManagerQueryField::Unused;
+			OutQuery.Terms.Add(MoveTemp(Term));
+			continue;
+		}
+
+		// Key, then : or a comparison, then the value
+		int32 OperatorStart = 0;
+		while (OperatorStart < TermText.Len() && FChar::IsAlpha(TermText[OperatorStart]))
+		{
+			OperatorStart++;
+		}
+
+		int32 ValueStart = OperatorStart;
+		while (ValueStart < TermText.Len() && FCString::Strchr(TEXT(":<>="), TermText[ValueStart]) != nullptr)
+		{
+			ValueStart++;
+		}
+
+		const FString Key = TermText.Left(OperatorStart).ToLower();
+		const FString Operator = TermText.Mid(OperatorStart, ValueStart - OperatorStart);
+		const FString Value = TermText.RightChop(ValueStart);
+
+		if (Operator.IsEmpty() || Value.IsEmpty() || ParseCompare(Operator, Term.Compare) == false)
+		{
+			OutError = FString::Printf(TEXT("Cannot read '%s', terms look like class:Texture2D, size>4MB or unused"), *Token);
+			return false;
+		}
+
+		if (Key == TEXT("class") || Key == TEXT("path") || Key == TEXT("name"))
+		{
+			if (Operator != TEXT(":"))
+			{
+				OutError = FString::Printf(TEXT("'%s' takes a value after a colon, like %s:Something"), *Key, *Key);
+				return false;
+			}
+
+			Term.Field = Key == TEXT("class") ? ESuperManagerQueryField::Class : Key == TEXT("path") ? ESuperManagerQueryField::Path : ESuperManagerQueryField::Name;
+			Term.Text = Value;
+
+			// Folders are interned without the trailing slash; for class and name a slash is part of the value
+			if (Term.Field == ESuperManagerQueryField::Path)
+			{
+				Term.Text.RemoveFromEnd(TEXT("/"));
+			}
+		}
+		else if (Key == TEXT("size"))
+		{
+			Term.Field = ESuperManagerQueryField::Size;
+
+			if (ParseByteCount(Value, Term.Number) == false)
+			{
+				OutError = FString::Printf(TEXT("Cannot read the size in '%s', use a number with B, KB, MB or GB"), *Token);
+				return false;
+			}
+		}
+		else if (Key == TEXT("refs"))
+		{
+			Term.Field = ESuperManagerQueryField::Referencers;
+
+			if (Value.IsNumeric() == false)
+			{
+				OutError = FString::Printf(TEXT("Cannot read the count in '%s'"), *Token);
+				return false;
+			}
+
+			Term.Number = FCString::Atoi64(*Value);
+		}
+		else
+		{
+			OutError = FString::Printf(TEXT("Unknown term '%s', use class, path, name, size, refs or unused"), *Key);
+			return false;
+		}
+
+		OutQuery.Terms.Add(MoveTemp(Term));
+	}
+
+	return true;
+}
+
+FSuperManagerCompiledAssetQuery FSuperManagerAssetQuery::Compile(const FSuperManagerAssetSnapshot& Snapshot) const
+{
+	FSuperManagerCompiledAssetQuery Compiled;
+	Compiled.Snapshot = &Snapshot;
+
+	const int32 NumAssets = Snapshot.NumAssets();
+
+	// Histograms over the interned columns give class and path terms an exact selectivity for a single pass
+	TArray<int32> AssetsPerClass;
+	TArray<int32> AssetsPerFolder;
+	AssetsPerClass.Init(0, Snapshot.NumAssetClasses());
+	AssetsPerFolder.Init(0, Snapshot.NumAssetFolders());
+
+	for (int32 AssetIndex = 0; AssetIndex < NumAssets; AssetIndex++)
+	{
+		AssetsPerClass[Snapshot.GetAssetClassIndex(AssetIndex)]++;
+		AssetsPerFolder[Snapshot.GetAssetFolderIndex(AssetIndex)]++;
+	}
+
+	for (const FSuperManagerQueryTerm& Term : Terms)
+	{
+		FSuperManagerCompiledAssetQuery::FStage& Stage = Compiled.Stages.AddDefaulted_GetRef();
+		Stage.Term = Term;
+
+		int32 NumMatchingAssets = INDEX_NONE;
+
+		switch (Term.Field)
+		{
+		case ESuperManagerQueryField::Class:
+		{
+			// Native classes also match their children; blueprint classes that are not loaded match by name only
+			const UClass* BaseClass = FindFirstObject<UClass>(*Term.Text, EFindFirstObjectOptions::NativeFirst);
+
+			Stage.Matches.Init(false, Snapshot.NumAssetClasses());
+			NumMatchingAssets = 0;
+
+			for (int32 ClassIndex = 0; ClassIndex < Snapshot.NumAssetClasses(); ClassIndex++)
+			{
+				const FTopLevelAssetPath& ClassPath = Snapshot.GetAssetClassPath(ClassIndex);
+
+				bool bMatches = ClassPath.GetAssetName().ToString().Equals(Term.Text, ESearchCase::IgnoreCase)
+					|| ClassPath.ToString().Equals(Term.Text, ESearchCase::IgnoreCase);
+
+				if (bMatches == false && BaseClass)
+				{
+					const UClass* AssetClass = FindObject<UClass>(ClassPath);
+					bMatches = AssetClass && AssetClass->IsChildOf(BaseClass);
+				}
+
+				Stage.Matches[ClassIndex] = bMatches;
+				NumMatchingAssets += bMatches ? AssetsPerClass[ClassIndex] : 0;
+			}
+			break;
+		}
+		case ESuperManagerQueryField::Path:
+		{
+			const FName QueryFolder(*Term.Text);
+
+			Stage.Matches.Init(false, Snapshot.NumAssetFolders());
+			NumMatchingAssets = 0;
+
+			// Parents come first, so a folder matches when it is the queried one or its parent already matched
+			for (int32 FolderIndex = 0; FolderIndex < Snapshot.NumAssetFolders(); FolderIndex++)
+			{
+				const int32 ParentIndex = Snapshot.GetAssetFolderParent(FolderIndex);
+				const bool bMatches = Snapshot.GetAssetFolderPath(FolderIndex) == QueryFolder || (ParentIndex != INDEX_NONE && Stage.Matches[ParentIndex]);
+
+				Stage.Matches[FolderIndex] = bMatches;
+				NumMatchingAssets += bMatches ? AssetsPerFolder[FolderIndex] : 0;
+			}
+			break;
+		}
+		case ESuperManagerQueryField::Name:
+			// A substring search per asset, by far the slowest test
+			Stage.Cost = 8.f;
+			break;
+
+		case ESuperManagerQueryField::Referencers:
+			// Walks the referencer row of the package
+			Stage.Cost = 2.f;
+			break;
+
+		default:
+			break;
+		}
+
+		Stage.Selectivity = NumMatchingAssets == INDEX_NONE || NumAssets == 0 ? UnknownSelectivity : float(NumMatchingAssets) / float(NumAssets);
+
+		if (Term.bNegated)
+		{
+			Stage.Selectivity = 1.f - Stage.Selectivity;
+		}
+	}
+
+	// Cheapest per rejected asset first
+	Compiled.Stages.StableSort([](const FSuperManagerCompiledAssetQuery::FStage& A, const FSuperManagerCompiledAssetQuery::FStage& B)
+		{
+			return A.Cost / FMath::Max(1.f - A.Selectivity, 0.01f) < B.Cost / FMath::Max(1.f - B.Selectivity, 0.01f);
+		});
+
+	return Compiled;
+}
+
+void FSuperManagerAssetQuery::LoadSavedQueries(TArray<FString>& OutQueryTexts)
+{
+	OutQueryTexts.Empty();
+	GConfig->GetArray(QueryConfigSection, SavedQueriesConfigKey, OutQueryTexts, GEditorPerProjectIni);
+}
+
+void FSuperManagerAssetQuery::SaveQuery(const FString& QueryText)
+{
+	TArray<FString> QueryTexts;
+	LoadSavedQueries(QueryTexts);
+
+	if (QueryTexts.Contains(QueryText)) { return; }
+
+	QueryTexts.Add(QueryText);
+	GConfig->SetArray(QueryConfigSection, SavedQueriesConfigKey, QueryTexts, GEditorPerProjectIni);
+}
+
+void FSuperManagerCompiledAssetQuery::Evaluate(TArray<int32>& OutAssetIndices) const
+{
+	check(Snapshot);
+
+	const FSuperManagerAssetSnapshot& Assets = *Snapshot;
+
+	OutAssetIndices.SetNumUninitialized(Assets.NumAssets());
+	for (int32 AssetIndex = 0; AssetIndex < OutAssetIndices.Num(); AssetIndex++)
+	{
+		OutAssetIndices[AssetIndex] = AssetIndex;
+	}
+
+	// One tight loop per stage rather than a switch per asset
+	for (const FStage& Stage : Stages)
+	{
+		if (OutAssetIndices.Num() == 0) { return; }
+
+		const FSuperManagerQueryTerm& Term = Stage.Term;
+
+		switch (Term.Field)
+		{
+		case ESuperManagerQueryField::Class:
+			FilterIndices(OutAssetIndices, Term.bNegated, [&](int32 AssetIndex) { return Stage.Matches[Assets.GetAssetClassIndex(AssetIndex)]; });
+			break;
+
+		case ESuperManagerQueryField::Path:
+			FilterIndices(OutAssetIndices, Term.bNegated, [&](int32 AssetIndex) { return Stage.Matches[Assets.GetAssetFolderIndex(AssetIndex)]; });
+			break;
+
+		case ESuperManagerQueryField::Name:
+			FilterIndices(OutAssetIndices, Term.bNegated, [&](int32 AssetIndex)
+				{
+					return Assets.GetAsset(AssetIndex).AssetName.ToString().Contains(Term.Text);
+				});
+			break;
+
+		case ESuperManagerQueryField::Size:
+			FilterIndices(OutAssetIndices, Term.bNegated, [&](int32 AssetIndex)
+				{
+					return CompareNumber(Assets.GetPackageDiskSize(Assets.GetAssetPackageIndex(AssetIndex)), Term.Compare, Term.Number);
+				});
+			break;
+
+		case ESuperManagerQueryField::Referencers:
+			FilterIndices(OutAssetIndices, Term.bNegated, [&](int32 AssetIndex)
+				{
+					int32 NumReferencers = 0;
+					for (ESuperManagerDependencyKind Kinds : Assets.GetReferencerKinds(Assets.GetAssetPackageIndex(AssetIndex)))
+					{
+						NumReferencers += EnumHasAnyFlags(Kinds, ESuperManagerDependencyKind::Package) ? 1 : 0;
+					}
+
+					return CompareNumber(NumReferencers, Term.Compare, Term.Number);
+				});
+			break;
+
+		case ESuperManagerQueryField::Unused:
+			FilterIndices(OutAssetIndices, Term.bNegated, [&](int32 AssetIndex)
+				{
+					return EnumHasAnyFlags(Assets.GetIncomingKinds(Assets.GetAssetPackageIndex(AssetIndex)), ESuperManagerDependencyKind::Package) == false;
+				});
+			break;
+		}
+	}
+}
+
+FString FSuperManagerCompiledAssetQuery::Describe() const
+{
+	TArray<FString> StageTexts;
+
+	for (const FStage& Stage : Stages)
+	{
+		static const TCHAR* FieldNames[] = { TEXT("class"), TEXT("path"), TEXT("name"), TEXT("size"), TEXT("refs"), TEXT("unused") };
+
+		FString StageText = Stage.Term.bNegated ? TEXT("-") : TEXT("");
+		StageText += FieldNames[int32(Stage.Term.Field)];
+
+		if (Stage.Term.Field == ESuperManagerQueryField::Size || Stage.Term.Field == ESuperManagerQueryField::Referencers)
+		{
+			StageText += CompareToString(Stage.Term.Compare) + FString::Printf(TEXT("%lld"), Stage.Term.Number);
+		}
+		else if (Stage.Term.Field != ESuperManagerQueryField::Unused)
+		{
+			StageText += TEXT(":") + Stage.Term.Text;
+		}
+
+		StageTexts.Add(FString::Printf(TEXT("%s (keeps ~%.0f%%)"), *StageText, Stage.Selectivity * 100.f));
+	}
+
+	return FString::Join(StageTexts, TEXT(" -> "));
+}
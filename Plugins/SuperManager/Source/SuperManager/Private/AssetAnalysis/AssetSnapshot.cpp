@@ -0,0 +1,696 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/AssetSnapshot.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+
+namespace
+{
+	struct FPackageEdge
+	{
+		uint64 Key;
+		ESuperManagerDependencyKind Kinds;
+
+		FPackageEdge(int32 From, int32 To, ESuperManagerDependencyKind InKinds)
+			: Key((uint64(uint32(From)) << 32) | uint64(uint32(To)))
+			, Kinds(InKinds)
+		{
+		}
+
+		int32 From() const { return int32(Key >> 32); }
+		int32 To() const { return int32(Key & 0xffffffff); }
+
+		bool operator<(const FPackageEdge& Other) const { return Key < Other.Key; }
+	};
+
+	ESuperManagerDependencyKind ToDependencyKind(const FAssetDependency& Dependency)
+	{
+		using namespace UE::AssetRegistry;
+
+		switch (Dependency.Category)
+		{
+		case EDependencyCategory::Package:
+			return EnumHasAnyFlags(Dependency.Properties, EDependencyProperty::Hard) ? ESuperManagerDependencyKind::Hard : ESuperManagerDependencyKind::Soft;
+
+		case EDependencyCategory::SearchableName:
+			return ESuperManagerDependencyKind::SearchableName;
+
+		case EDependencyCategory::Manage:
+			return ESuperManagerDependencyKind::Management;
+
+		default:
+			return ESuperManagerDependencyKind::None;
+		}
+	}
+
+	// Manage edges can come from a primary asset id rather than a package, so those get a node of their own
+	FName GetNodeName(const FAssetIdentifier& AssetId)
+	{
+		return AssetId.PackageName.IsNone() ? FName(*AssetId.ToString()) : AssetId.PackageName;
+	}
+
+	// Builds compressed rows from edges sorted by (From, To), either keyed on the source or on the target
+	void BuildRows(const TArray<FPackageEdge>& SortedEdges, int32 NumNodes, bool bRowIsSource, TArray<int32>& OutOffsets, TArray<int32>& OutEdges, TArray<ESuperManagerDependencyKind>& OutKinds)
+	{
+		OutOffsets.Init(0, NumNodes + 1);
+		OutEdges.SetNumUninitialized(SortedEdges.Num());
+		OutKinds.SetNumUninitialized(SortedEdges.Num());
+
+		for (const FPackageEdge& Edge : SortedEdges)
+		{
+			OutOffsets[(bRowIsSource ? Edge.From() : Edge.To()) + 1]++;
+		}
+
+		for (int32 Row = 0; Row < NumNodes; Row++)
+		{
+			OutOffsets[Row + 1] += OutOffsets[Row];
+		}
+
+		TArray<int32> WriteCursor(OutOffsets.GetData(), NumNodes);
+		for (const FPackageEdge& Edge : SortedEdges)
+		{
+			const int32 Row = bRowIsSource ? Edge.From() : Edge.To();
+			const int32 WriteIndex = WriteCursor[Row]++;
+
+			OutEdges[WriteIndex] = bRowIsSource ? Edge.To() : Edge.From();
+			OutKinds[WriteIndex] = Edge.Kinds;
+		}
+	}
+}
+
+TSharedRef<const FSuperManagerAssetSnapshot> FSuperManagerAssetSnapshot::Capture(const TArray<FString>& FolderPaths)
+{
+	check(IsInGameThread());
+
+	TSharedRef<FSuperManagerAssetSnapshot> Snapshot = MakeShared<FSuperManagerAssetSnapshot>();
+
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	FARFilter Filter;
+	Filter.bRecursivePaths = true;
+	Filter.PackagePaths.Emplace("/Game");
+
+	TArray<FAssetData> GameAssets;
+	AssetRegistry.GetAssets(Filter, GameAssets);
+
+	TArray<int32> RootIndices;
+
+	for (const FAssetData& AssetData : GameAssets)
+	{
+		const int32 PackageIndex = Snapshot->AddPackage(AssetData.PackageName);
+
+		if (IsRootAsset(AssetData))
+		{
+			RootIndices.Add(PackageIndex);
+		}
+
+		const FString AssetPath = AssetData.GetSoftObjectPath().ToString();
+		if (AssetPath.Contains(TEXT("Collections")) || AssetPath.Contains(TEXT("Developers"))) { continue; }
+
+		if (IsUnderFolders(AssetData, FolderPaths) == false) { continue; }
+
+		Snapshot->Assets.Add(AssetData);
+		Snapshot->AssetPackageIndices.Add(PackageIndex);
+	}
+
+	Snapshot->BuildAssetColumns();
+
+	// A folder has assets when any asset lives in it or below it, so each asset marks its whole folder chain
+	TSet<FString> OccupiedFolders;
+
+	for (const FAssetData& AssetData : GameAssets)
+	{
+		FString FolderPath = AssetData.PackagePath.ToString();
+
+		while (FolderPath.Len() > 0)
+		{
+			bool bAlreadyOccupied = false;
+			OccupiedFolders.Add(FolderPath, &bAlreadyOccupied);
+
+			if (bAlreadyOccupied) { break; }
+
+			FolderPath = FPackageName::GetLongPackagePath(FolderPath);
+		}
+	}
+
+	TArray<FString> GameFolders;
+	AssetRegistry.GetSubPaths(TEXT("/Game"), GameFolders, true);
+
+	for (FString& GameFolder : GameFolders)
+	{
+		if (OccupiedFolders.Contains(GameFolder)) { continue; }
+
+		Snapshot->EmptyContentFolders.Add(MoveTemp(GameFolder));
+	}
+
+	// Only /Game packages are walked; anything discovered past this point lives outside of it
+	const int32 NumGamePackages = Snapshot->NumPackages();
+
+	// One sweep per direction collects every category at once; the kinds are split per edge instead of re-querying
+	TArray<FPackageEdge> Edges;
+	TArray<FAssetDependency> FoundDependencies;
+
+	for (int32 PackageIndex = 0; PackageIndex < NumGamePackages; PackageIndex++)
+	{
+		const FAssetIdentifier PackageId(Snapshot->PackageNames[PackageIndex]);
+
+		FoundDependencies.Reset();
+		AssetRegistry.GetDependencies(PackageId, FoundDependencies, UE::AssetRegistry::EDependencyCategory::All);
+
+		for (const FAssetDependency& Dependency : FoundDependencies)
+		{
+			Edges.Emplace(PackageIndex, Snapshot->AddPackage(GetNodeName(Dependency.AssetId)), ToDependencyKind(Dependency));
+		}
+
+		FoundDependencies.Reset();
+		AssetRegistry.GetReferencers(PackageId, FoundDependencies, UE::AssetRegistry::EDependencyCategory::All);
+
+		for (const FAssetDependency& Referencer : FoundDependencies)
+		{
+			const int32 ReferencerIndex = Snapshot->AddPackage(GetNodeName(Referencer.AssetId));
+			Edges.Emplace(ReferencerIndex, PackageIndex, ToDependencyKind(Referencer));
+
+			if (ReferencerIndex >= NumGamePackages)
+			{
+				RootIndices.Add(ReferencerIndex);
+			}
+		}
+	}
+
+	const int32 NumPackages = Snapshot->NumPackages();
+
+	Snapshot->PackageDiskSizes.SetNumZeroed(NumPackages);
+	Snapshot->PackageHashes.Init(FIoHash::Zero, NumPackages);
+	for (int32 PackageIndex = 0; PackageIndex < NumPackages; PackageIndex++)
+	{
+		TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(Snapshot->PackageNames[PackageIndex]);
+		if (PackageData.IsSet())
+		{
+			Snapshot->PackageDiskSizes[PackageIndex] = PackageData->DiskSize;
+			Snapshot->PackageHashes[PackageIndex] = PackageData->GetPackageSavedHash();
+		}
+	}
+
+	Snapshot->RootPackages.Init(false, NumPackages);
+	for (int32 RootIndex : RootIndices)
+	{
+		Snapshot->RootPackages[RootIndex] = true;
+	}
+
+	// Sorting by (From, To) lays out the dependency rows; edges seen twice (or in several categories) fold into one
+	Edges.Sort();
+
+	int32 NumUniqueEdges = 0;
+	for (int32 EdgeIndex = 0; EdgeIndex < Edges.Num(); EdgeIndex++)
+	{
+		if (NumUniqueEdges > 0 && Edges[NumUniqueEdges - 1].Key == Edges[EdgeIndex].Key)
+		{
+			Edges[NumUniqueEdges - 1].Kinds |= Edges[EdgeIndex].Kinds;
+			continue;
+		}
+
+		Edges[NumUniqueEdges++] = Edges[EdgeIndex];
+	}
+	Edges.RemoveAt(NumUniqueEdges, Edges.Num() - NumUniqueEdges);
+
+	BuildRows(Edges, NumPackages, true, Snapshot->DependencyOffsets, Snapshot->DependencyEdges, Snapshot->DependencyEdgeKinds);
+	BuildRows(Edges, NumPackages, false, Snapshot->ReferencerOffsets, Snapshot->ReferencerEdges, Snapshot->ReferencerEdgeKinds);
+
+	Snapshot->IncomingKinds.Init(ESuperManagerDependencyKind::None, NumPackages);
+	for (const FPackageEdge& Edge : Edges)
+	{
+		Snapshot->IncomingKinds[Edge.To()] |= Edge.Kinds;
+	}
+
+	return Snapshot;
+}
+
+#pragma region Accessors
+int32 FSuperManagerAssetSnapshot::FindPackageIndex(FName PackageName) const
+{
+	const int32* FoundIndex = PackageIndexMap.Find(PackageName);
+
+	return FoundIndex ? *FoundIndex : INDEX_NONE;
+}
+
+TConstArrayView<int32> FSuperManagerAssetSnapshot::GetReferencers(int32 PackageIndex) const
+{
+	return TConstArrayView<int32>(ReferencerEdges.GetData() + ReferencerOffsets[PackageIndex], ReferencerOffsets[PackageIndex + 1] - ReferencerOffsets[PackageIndex]);
+}
+
+TConstArrayView<int32> FSuperManagerAssetSnapshot::GetDependencies(int32 PackageIndex) const
+{
+	return TConstArrayView<int32>(DependencyEdges.GetData() + DependencyOffsets[PackageIndex], DependencyOffsets[PackageIndex + 1] - DependencyOffsets[PackageIndex]);
+}
+
+TConstArrayView<ESuperManagerDependencyKind> FSuperManagerAssetSnapshot::GetReferencerKinds(int32 PackageIndex) const
+{
+	return TConstArrayView<ESuperManagerDependencyKind>(ReferencerEdgeKinds.GetData() + ReferencerOffsets[PackageIndex], ReferencerOffsets[PackageIndex + 1] - ReferencerOffsets[PackageIndex]);
+}
+
+TConstArrayView<ESuperManagerDependencyKind> FSuperManagerAssetSnapshot::GetDependencyKinds(int32 PackageIndex) const
+{
+	return TConstArrayView<ESuperManagerDependencyKind>(DependencyEdgeKinds.GetData() + DependencyOffsets[PackageIndex], DependencyOffsets[PackageIndex + 1] - DependencyOffsets[PackageIndex]);
+}
+#pragma endregion
+
+#pragma region Queries
+void FSuperManagerAssetSnapshot::ListUnusedAssets(TArray<FAssetData>& OutUnusedAssetData, const TArray<FString>& FolderPaths) const
+{
+	ListAssetsByIncomingKinds([](ESuperManagerDependencyKind Kinds)
+		{
+			return EnumHasAnyFlags(Kinds, ESuperManagerDependencyKind::Package) == false;
+		},
+		OutUnusedAssetData, FolderPaths);
+}
+
+void FSuperManagerAssetSnapshot::ListAssetsByIncomingKinds(TFunctionRef<bool(ESuperManagerDependencyKind)> Predicate, TArray<FAssetData>& OutAssetData, const TArray<FString>& FolderPaths) const
+{
+	OutAssetData.Empty();
+
+	for (int32 AssetIndex = 0; AssetIndex < Assets.Num(); AssetIndex++)
+	{
+		if (IsUnderFolders(Assets[AssetIndex], FolderPaths) == false) { continue; }
+
+		if (Predicate(IncomingKinds[AssetPackageIndices[AssetIndex]]))
+		{
+			OutAssetData.Add(Assets[AssetIndex]);
+		}
+	}
+}
+
+void FSuperManagerAssetSnapshot::ListUnreachableAssets(TArray<FAssetData>& OutUnreachableAssetData, const TArray<FString>& FolderPaths) const
+{
+	OutUnreachableAssetData.Empty();
+
+	TBitArray<> Reached(false, NumPackages());
+	TArray<int32> PackagesToVisit;
+
+	for (TConstSetBitIterator<> It(RootPackages); It; ++It)
+	{
+		Reached[It.GetIndex()] = true;
+		PackagesToVisit.Add(It.GetIndex());
+	}
+
+	while (PackagesToVisit.Num() > 0)
+	{
+		const int32 PackageIndex = PackagesToVisit.Pop(false);
+		const TConstArrayView<int32> Dependencies = GetDependencies(PackageIndex);
+		const TConstArrayView<ESuperManagerDependencyKind> DependencyKinds = GetDependencyKinds(PackageIndex);
+
+		for (int32 EdgeIndex = 0; EdgeIndex < Dependencies.Num(); EdgeIndex++)
+		{
+			// Searchable names do not keep anything cooked
+			if (EnumHasAnyFlags(DependencyKinds[EdgeIndex], ESuperManagerDependencyKind::Package | ESuperManagerDependencyKind::Management) == false) { continue; }
+
+			const int32 Dependency = Dependencies[EdgeIndex];
+			if (Reached[Dependency]) { continue; }
+
+			Reached[Dependency] = true;
+			PackagesToVisit.Add(Dependency);
+		}
+	}
+
+	for (int32 AssetIndex = 0; AssetIndex < Assets.Num(); AssetIndex++)
+	{
+		if (IsUnderFolders(Assets[AssetIndex], FolderPaths) == false) { continue; }
+
+		if (Reached[AssetPackageIndices[AssetIndex]] == false)
+		{
+			OutUnreachableAssetData.Add(Assets[AssetIndex]);
+		}
+	}
+}
+
+void FSuperManagerAssetSnapshot::ListSameNameAssets(TArray<FAssetData>& OutSameNameAssetData, const TArray<FString>& FolderPaths) const
+{
+	OutSameNameAssetData.Empty();
+
+	TMap<FName, int32> NameCounts;
+	for (const FAssetData& AssetData : Assets)
+	{
+		if (IsUnderFolders(AssetData, FolderPaths) == false) { continue; }
+
+		NameCounts.FindOrAdd(AssetData.AssetName)++;
+	}
+
+	for (const FAssetData& AssetData : Assets)
+	{
+		if (IsUnderFolders(AssetData, FolderPaths) == false) { continue; }
+
+		if (NameCounts[AssetData.AssetName] <= 1) { continue; }
+
+		OutSameNameAssetData.Add(AssetData);
+	}
+}
+
+void FSuperManagerAssetSnapshot::ListEmptyFolders(const FString& FolderPath, TArray<FString>& OutEmptyFolders) const
+{
+	OutEmptyFolders.Empty();
+
+	const FString FolderPrefix = FolderPath.EndsWith(TEXT("/")) ? FolderPath : FolderPath + TEXT("/");
+
+	for (const FString& EmptyFolder : EmptyContentFolders)
+	{
+		if (EmptyFolder.StartsWith(FolderPrefix) == false) { continue; }
+
+		if (EmptyFolder.Contains(TEXT("Collections")) || EmptyFolder.Contains(TEXT("Developers"))) { continue; }
+
+		OutEmptyFolders.Add(EmptyFolder);
+	}
+}
+
+void FSuperManagerAssetSnapshot::ListReferencers(FName PackageName, TArray<FName>& OutReferencers, ESuperManagerDependencyKind KindMask) const
+{
+	OutReferencers.Empty();
+
+	const int32 PackageIndex = FindPackageIndex(PackageName);
+	if (PackageIndex == INDEX_NONE) { return; }
+
+	const TConstArrayView<int32> Referencers = GetReferencers(PackageIndex);
+	const TConstArrayView<ESuperManagerDependencyKind> ReferencerKinds = GetReferencerKinds(PackageIndex);
+
+	for (int32 EdgeIndex = 0; EdgeIndex < Referencers.Num(); EdgeIndex++)
+	{
+		if (EnumHasAnyFlags(ReferencerKinds[EdgeIndex], KindMask) == false) { continue; }
+
+		OutReferencers.Add(PackageNames[Referencers[EdgeIndex]]);
+	}
+}
+
+int64 FSuperManagerAssetSnapshot::GetTotalDiskSize(const TArray<FAssetData>& AssetsToMeasure) const
+{
+	TBitArray<> Counted(false, NumPackages());
+	int64 TotalSize = 0;
+
+	for (const FAssetData& AssetData : AssetsToMeasure)
+	{
+		const int32 PackageIndex = FindPackageIndex(AssetData.PackageName);
+		if (PackageIndex == INDEX_NONE || Counted[PackageIndex]) { continue; }
+
+		Counted[PackageIndex] = true;
+		TotalSize += PackageDiskSizes[PackageIndex];
+	}
+
+	return TotalSize;
+}
+
+bool FSuperManagerAssetSnapshot::FindReferenceChains(int32 TargetPackageIndex, int32 MaxChains, TArray<TArray<int32>>& OutChains) const
+{
+	OutChains.Empty();
+
+	if (RootPackages[TargetPackageIndex])
+	{
+		OutChains.Add({ TargetPackageIndex });
+		return true;
+	}
+
+	constexpr ESuperManagerDependencyKind FollowedKinds = ESuperManagerDependencyKind::Package | ESuperManagerDependencyKind::Management;
+
+	// Parent links of both searches: forward from every root along dependencies, backward from the target along referencers
+	TArray<int32> ForwardParents;
+	TArray<int32> BackwardParents;
+	ForwardParents.Init(INDEX_NONE - 1, NumPackages());
+	BackwardParents.Init(INDEX_NONE - 1, NumPackages());
+
+	TArray<int32> ForwardFrontier;
+	TArray<int32> BackwardFrontier;
+
+	for (TConstSetBitIterator<> It(RootPackages); It; ++It)
+	{
+		ForwardParents[It.GetIndex()] = INDEX_NONE;
+		ForwardFrontier.Add(It.GetIndex());
+	}
+
+	BackwardParents[TargetPackageIndex] = INDEX_NONE;
+	BackwardFrontier.Add(TargetPackageIndex);
+
+	auto IsVisited = [](const TArray<int32>& Parents, int32 PackageIndex) { return Parents[PackageIndex] != INDEX_NONE - 1; };
+
+	TArray<int32> MeetingPackages;
+	TArray<int32> NextFrontier;
+
+	while (ForwardFrontier.Num() > 0 && BackwardFrontier.Num() > 0 && MeetingPackages.Num() == 0)
+	{
+		// Always grow the cheaper side; the root side is usually the big one
+		const bool bExpandForward = ForwardFrontier.Num() <= BackwardFrontier.Num();
+
+		TArray<int32>& Frontier = bExpandForward ? ForwardFrontier : BackwardFrontier;
+		TArray<int32>& Parents = bExpandForward ? ForwardParents : BackwardParents;
+		const TArray<int32>& OtherParents = bExpandForward ? BackwardParents : ForwardParents;
+
+		NextFrontier.Reset();
+
+		// Finish the whole level so every meeting point at this depth is found
+		for (int32 PackageIndex : Frontier)
+		{
+			const TConstArrayView<int32> Neighbours = bExpandForward ? GetDependencies(PackageIndex) : GetReferencers(PackageIndex);
+			const TConstArrayView<ESuperManagerDependencyKind> NeighbourKinds = bExpandForward ? GetDependencyKinds(PackageIndex) : GetReferencerKinds(PackageIndex);
+
+			for (int32 EdgeIndex = 0; EdgeIndex < Neighbours.Num(); EdgeIndex++)
+			{
+				if (EnumHasAnyFlags(NeighbourKinds[EdgeIndex], FollowedKinds) == false) { continue; }
+
+				const int32 Neighbour = Neighbours[EdgeIndex];
+				if (IsVisited(Parents, Neighbour)) { continue; }
+
+				Parents[Neighbour] = PackageIndex;
+				NextFrontier.Add(Neighbour);
+
+				if (IsVisited(OtherParents, Neighbour))
+				{
+					MeetingPackages.Add(Neighbour);
+				}
+			}
+		}
+
+		Swap(Frontier, NextFrontier);
+	}
+
+	for (int32 MeetingPackage : MeetingPackages)
+	{
+		if (OutChains.Num() >= MaxChains) { break; }
+
+		TArray<int32>& Chain = OutChains.AddDefaulted_GetRef();
+
+		for (int32 PackageIndex = MeetingPackage; PackageIndex != INDEX_NONE; PackageIndex = ForwardParents[PackageIndex])
+		{
+			Chain.Insert(PackageIndex, 0);
+		}
+
+		for (int32 PackageIndex = BackwardParents[MeetingPackage]; PackageIndex != INDEX_NONE; PackageIndex = BackwardParents[PackageIndex])
+		{
+			Chain.Add(PackageIndex);
+		}
+	}
+
+	return OutChains.Num() > 0;
+}
+
+void FSuperManagerAssetSnapshot::FindComponents(TFunctionRef<bool(ESuperManagerDependencyKind Kinds, int32 DependencyIndex)> IsFollowed, FSuperManagerPackageComponents& OutComponents) const
+{
+	struct FFrame
+	{
+		int32 Package;
+		int32 NextEdge;
+	};
+
+	const int32 NumPackages = this->NumPackages();
+
+	TArray<int32> VisitOrder;
+	TArray<int32> LowLink;
+	VisitOrder.Init(INDEX_NONE, NumPackages);
+	LowLink.Init(INDEX_NONE, NumPackages);
+	TArray<int32>& ComponentOf = OutComponents.ComponentOf;
+	ComponentOf.Init(INDEX_NONE, NumPackages);
+
+	TBitArray<> OnStack(false, NumPackages);
+	TArray<int32> ComponentStack;
+	TArray<FFrame> CallStack;
+
+	int32 NextVisit = 0;
+	int32 NumComponents = 0;
+
+	auto Visit = [&](int32 Package)
+	{
+		VisitOrder[Package] = LowLink[Package] = NextVisit++;
+		ComponentStack.Push(Package);
+		OnStack[Package] = true;
+		CallStack.Add(FFrame{ Package, 0 });
+	};
+
+	for (int32 StartPackage = 0; StartPackage < NumPackages; StartPackage++)
+	{
+		if (VisitOrder[StartPackage] != INDEX_NONE) { continue; }
+
+		Visit(StartPackage);
+
+		while (CallStack.Num() > 0)
+		{
+			const int32 Package = CallStack.Last().Package;
+			const TConstArrayView<int32> Dependencies = GetDependencies(Package);
+			const TConstArrayView<ESuperManagerDependencyKind> DependencyKinds = GetDependencyKinds(Package);
+
+			bool bDescended = false;
+
+			while (CallStack.Last().NextEdge < Dependencies.Num())
+			{
+				const int32 EdgeIndex = CallStack.Last().NextEdge++;
+				const int32 Dependency = Dependencies[EdgeIndex];
+
+				if (IsFollowed(DependencyKinds[EdgeIndex], Dependency) == false) { continue; }
+
+				if (VisitOrder[Dependency] == INDEX_NONE)
+				{
+					Visit(Dependency);
+					bDescended = true;
+					break;
+				}
+
+				if (OnStack[Dependency])
+				{
+					LowLink[Package] = FMath::Min(LowLink[Package], VisitOrder[Dependency]);
+				}
+			}
+
+			if (bDescended) { continue; }
+
+			CallStack.Pop(false);
+
+			if (CallStack.Num() > 0)
+			{
+				const int32 Parent = CallStack.Last().Package;
+				LowLink[Parent] = FMath::Min(LowLink[Parent], LowLink[Package]);
+			}
+
+			if (LowLink[Package] != VisitOrder[Package]) { continue; }
+
+			int32 Member = INDEX_NONE;
+			do
+			{
+				Member = ComponentStack.Pop(false);
+				OnStack[Member] = false;
+				ComponentOf[Member] = NumComponents;
+			}
+			while (Member != Package);
+
+			NumComponents++;
+		}
+	}
+
+	// Members grouped per component, counting sort style
+	OutComponents.Offsets.Init(0, NumComponents + 1);
+	for (int32 PackageIndex = 0; PackageIndex < NumPackages; PackageIndex++)
+	{
+		OutComponents.Offsets[ComponentOf[PackageIndex] + 1]++;
+	}
+	for (int32 Component = 0; Component < NumComponents; Component++)
+	{
+		OutComponents.Offsets[Component + 1] += OutComponents.Offsets[Component];
+	}
+
+	OutComponents.Members.SetNumUninitialized(NumPackages);
+	TArray<int32> WriteCursor(OutComponents.Offsets.GetData(), NumComponents);
+	for (int32 PackageIndex = 0; PackageIndex < NumPackages; PackageIndex++)
+	{
+		OutComponents.Members[WriteCursor[ComponentOf[PackageIndex]]++] = PackageIndex;
+	}
+}
+#pragma endregion
+
+bool FSuperManagerAssetSnapshot::IsRootAsset(const FAssetData& AssetData)
+{
+	return AssetData.IsInstanceOf(UWorld::StaticClass()) || AssetData.GetPrimaryAssetId().IsValid();
+}
+
+bool FSuperManagerAssetSnapshot::IsUnderFolders(const FAssetData& AssetData, const TArray<FString>& FolderPaths)
+{
+	if (FolderPaths.Num() == 0) { return true; }
+
+	const FString PackagePath = AssetData.PackagePath.ToString();
+
+	for (const FString& FolderPath : FolderPaths)
+	{
+		if (PackagePath == FolderPath || PackagePath.StartsWith(FolderPath + TEXT("/")))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void FSuperManagerAssetSnapshot::BuildAssetColumns()
+{
+	TMap<FTopLevelAssetPath, int32> ClassIndexMap;
+	TMap<FName, int32> FolderIndexMap;
+
+	AssetClassIndices.SetNumUninitialized(Assets.Num());
+	AssetFolderIndices.SetNumUninitialized(Assets.Num());
+
+	for (int32 AssetIndex = 0; AssetIndex < Assets.Num(); AssetIndex++)
+	{
+		const FAssetData& AssetData = Assets[AssetIndex];
+
+		if (const int32* ClassIndex = ClassIndexMap.Find(AssetData.AssetClassPath))
+		{
+			AssetClassIndices[AssetIndex] = *ClassIndex;
+		}
+		else
+		{
+			AssetClassIndices[AssetIndex] = ClassIndexMap.Add(AssetData.AssetClassPath, AssetClassPaths.Add(AssetData.AssetClassPath));
+		}
+
+		if (const int32* FolderIndex = FolderIndexMap.Find(AssetData.PackagePath))
+		{
+			AssetFolderIndices[AssetIndex] = *FolderIndex;
+			continue;
+		}
+
+		// Interns the missing part of the folder chain, top down so parents get the lower indices
+		TArray<FName, TInlineAllocator<16>> MissingFolders;
+		int32 ParentIndex = INDEX_NONE;
+
+		for (FString FolderPath = AssetData.PackagePath.ToString(); FolderPath.Len() > 1; FolderPath = FPackageName::GetLongPackagePath(FolderPath))
+		{
+			const FName FolderName(*FolderPath);
+
+			if (const int32* FolderIndex = FolderIndexMap.Find(FolderName))
+			{
+				ParentIndex = *FolderIndex;
+				break;
+			}
+
+			MissingFolders.Add(FolderName);
+
+			if (FolderPath.Find(TEXT("/"), ESearchCase::CaseSensitive, ESearchDir::FromEnd) <= 0) { break; }
+		}
+
+		for (int32 MissingIndex = MissingFolders.Num() - 1; MissingIndex >= 0; MissingIndex--)
+		{
+			const int32 NewIndex = AssetFolderPaths.Add(MissingFolders[MissingIndex]);
+			AssetFolderParents.Add(ParentIndex);
+			FolderIndexMap.Add(MissingFolders[MissingIndex], NewIndex);
+
+			ParentIndex = NewIndex;
+		}
+
+		AssetFolderIndices[AssetIndex] = ParentIndex;
+	}
+}
+
+int32 FSuperManagerAssetSnapshot::AddPackage(FName PackageName)
+{
+	if (const int32* FoundIndex = PackageIndexMap.Find(PackageName))
+	{
+		return *FoundIndex;
+	}
+
+	const int32 NewIndex = PackageNames.Add(PackageName);
+	PackageIndexMap.Add(PackageName, NewIndex);
+
+	return NewIndex;
+}
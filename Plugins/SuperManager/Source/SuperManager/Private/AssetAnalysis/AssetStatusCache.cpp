@@ -0,0 +1,284 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/AssetStatusCache.h"
+#include "AssetAnalysis/AssetSnapshot.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+
+namespace
+{
+	// Edits tend to come in bursts (a save all, a bulk rename), one refresh covers the whole burst
+	constexpr float ReachabilityRefreshDelay = 0.5f;
+
+	bool IsGamePackage(FName PackageName)
+	{
+		return PackageName.ToString().StartsWith(TEXT("/Game/"));
+	}
+}
+
+FSuperManagerAssetStatusCache::~FSuperManagerAssetStatusCache()
+{
+	Reset();
+}
+
+void FSuperManagerAssetStatusCache::Build(const FSuperManagerAssetSnapshot& Snapshot)
+{
+	Reset();
+
+	Nodes.Reserve(Snapshot.NumPackages());
+
+	for (int32 PackageIndex = 0; PackageIndex < Snapshot.NumPackages(); PackageIndex++)
+	{
+		FPackageNode& Node = Nodes.Add(Snapshot.GetPackageName(PackageIndex));
+		Node.bRoot = Snapshot.IsRootPackage(PackageIndex);
+		Node.bInGame = IsGamePackage(Snapshot.GetPackageName(PackageIndex));
+
+		TConstArrayView<int32> Dependencies = Snapshot.GetDependencies(PackageIndex);
+		TConstArrayView<ESuperManagerDependencyKind> DependencyKinds = Snapshot.GetDependencyKinds(PackageIndex);
+
+		for (int32 EdgeIndex = 0; EdgeIndex < Dependencies.Num(); EdgeIndex++)
+		{
+			const FName DependencyName = Snapshot.GetPackageName(Dependencies[EdgeIndex]);
+
+			if (EnumHasAnyFlags(DependencyKinds[EdgeIndex], ESuperManagerDependencyKind::Package))
+			{
+				Node.PackageDependencies.Add(DependencyName);
+			}
+
+			if (EnumHasAnyFlags(DependencyKinds[EdgeIndex], ESuperManagerDependencyKind::Management))
+			{
+				Node.ManagementDependencies.Add(DependencyName);
+			}
+		}
+
+		TConstArrayView<ESuperManagerDependencyKind> ReferencerKinds = Snapshot.GetReferencerKinds(PackageIndex);
+
+		for (ESuperManagerDependencyKind ReferencerKind : ReferencerKinds)
+		{
+			if (EnumHasAnyFlags(ReferencerKind, ESuperManagerDependencyKind::Package))
+			{
+				Node.NumReferencers++;
+			}
+		}
+	}
+
+	bIsBuilt = true;
+
+	RefreshReachability();
+	StatusChangedDelegate.Broadcast();
+}
+
+void FSuperManagerAssetStatusCache::Reset()
+{
+	if (ReachabilityRefreshHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(ReachabilityRefreshHandle);
+		ReachabilityRefreshHandle.Reset();
+	}
+
+	Nodes.Empty();
+	bIsBuilt = false;
+}
+
+bool FSuperManagerAssetStatusCache::GetStatus(FName PackageName, FSuperManagerAssetStatus& OutStatus) const
+{
+	const FPackageNode* Node = Nodes.Find(PackageName);
+	if (Node == nullptr || Node->bInGame == false) { return false; }
+
+	OutStatus.NumReferencers = Node->NumReferencers;
+	OutStatus.bUnused = Node->NumReferencers == 0 && Node->bRoot == false;
+	OutStatus.bUnreachable = Node->bReachable == false;
+
+	return true;
+}
+
+void FSuperManagerAssetStatusCache::UpdatePackage(FName PackageName)
+{
+	// Until the initial build every asset the registry discovers comes through here, the build covers them all
+	if (bIsBuilt == false) { return; }
+
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	TArray<FAssetData> PackageAssets;
+	AssetRegistry.GetAssetsByPackageName(PackageName, PackageAssets);
+
+	if (PackageAssets.Num() == 0)
+	{
+		RemovePackage(PackageName);
+		return;
+	}
+
+	TArray<FAssetDependency> FoundDependencies;
+	AssetRegistry.GetDependencies(FAssetIdentifier(PackageName), FoundDependencies,
+		UE::AssetRegistry::EDependencyCategory::Package | UE::AssetRegistry::EDependencyCategory::Manage);
+
+	TArray<FName> NewPackageDependencies;
+	TArray<FName> NewManagementDependencies;
+
+	for (const FAssetDependency& Dependency : FoundDependencies)
+	{
+		if (Dependency.AssetId.PackageName.IsNone()) { continue; }
+
+		if (Dependency.Category == UE::AssetRegistry::EDependencyCategory::Package)
+		{
+			NewPackageDependencies.AddUnique(Dependency.AssetId.PackageName);
+			continue;
+		}
+
+		NewManagementDependencies.AddUnique(Dependency.AssetId.PackageName);
+	}
+
+	FPackageNode& Node = Nodes.FindOrAdd(PackageName);
+	Node.bInGame = IsGamePackage(PackageName);
+	Node.bRoot = Node.bInGame == false;
+	Node.ManagementDependencies = MoveTemp(NewManagementDependencies);
+
+	for (const FAssetData& AssetData : PackageAssets)
+	{
+		Node.bRoot |= FSuperManagerAssetSnapshot::IsRootAsset(AssetData);
+	}
+
+	SetPackageDependencies(PackageName, MoveTemp(NewPackageDependencies));
+
+	// A primary asset's management edges start at its id rather than at its package
+	for (const FAssetData& AssetData : PackageAssets)
+	{
+		const FPrimaryAssetId PrimaryAssetId = AssetData.GetPrimaryAssetId();
+		if (PrimaryAssetId.IsValid() == false) { continue; }
+
+		UpdatePrimaryAssetNode(AssetRegistry, PrimaryAssetId);
+	}
+
+	RequestReachabilityRefresh();
+}
+
+void FSuperManagerAssetStatusCache::UpdatePrimaryAssetNode(IAssetRegistry& AssetRegistry, const FPrimaryAssetId& PrimaryAssetId)
+{
+	const FAssetIdentifier PrimaryAssetIdentifier(PrimaryAssetId);
+
+	TArray<FAssetDependency> FoundDependencies;
+	AssetRegistry.GetDependencies(PrimaryAssetIdentifier, FoundDependencies, UE::AssetRegistry::EDependencyCategory::Manage);
+
+	TArray<FName> NewManagementDependencies;
+
+	for (const FAssetDependency& Dependency : FoundDependencies)
+	{
+		if (Dependency.AssetId.PackageName.IsNone()) { continue; }
+
+		NewManagementDependencies.AddUnique(Dependency.AssetId.PackageName);
+	}
+
+	// Named the way the snapshot names id nodes, so a build and an update land on the same node
+	FPackageNode& Node = Nodes.FindOrAdd(FName(*PrimaryAssetIdentifier.ToString()));
+	Node.bInGame = false;
+	Node.bRoot = true;
+	Node.ManagementDependencies = MoveTemp(NewManagementDependencies);
+}
+
+void FSuperManagerAssetStatusCache::SetPackageDependencies(FName PackageName, TArray<FName>&& NewPackageDependencies)
+{
+	// Only the difference is applied, so a resave that kept its references costs nothing past the lookups
+	TArray<FName> OldPackageDependencies = MoveTemp(Nodes.FindOrAdd(PackageName).PackageDependencies);
+
+	for (const FName& OldDependency : OldPackageDependencies)
+	{
+		if (NewPackageDependencies.Contains(OldDependency)) { continue; }
+
+		if (FPackageNode* DependencyNode = Nodes.Find(OldDependency))
+		{
+			DependencyNode->NumReferencers--;
+		}
+	}
+
+	for (const FName& NewDependency : NewPackageDependencies)
+	{
+		if (OldPackageDependencies.Contains(NewDependency)) { continue; }
+
+		// Adding may grow the map, so nodes are never held across this call
+		Nodes.FindOrAdd(NewDependency).NumReferencers++;
+	}
+
+	Nodes.FindChecked(PackageName).PackageDependencies = MoveTemp(NewPackageDependencies);
+}
+
+void FSuperManagerAssetStatusCache::RemovePackage(FName PackageName)
+{
+	if (Nodes.Contains(PackageName) == false) { return; }
+
+	SetPackageDependencies(PackageName, TArray<FName>());
+
+	FPackageNode& Node = Nodes.FindChecked(PackageName);
+
+	// Referencers of a deleted package still point at it, the node stays to keep their counts balanced
+	if (Node.NumReferencers > 0)
+	{
+		Node.ManagementDependencies.Empty();
+		Node.bRoot = false;
+	}
+	else
+	{
+		Nodes.Remove(PackageName);
+	}
+
+	RequestReachabilityRefresh();
+}
+
+void FSuperManagerAssetStatusCache::FlushReachabilityRefresh()
+{
+	if (ReachabilityRefreshHandle.IsValid() == false) { return; }
+
+	FTSTicker::GetCoreTicker().RemoveTicker(ReachabilityRefreshHandle);
+	OnReachabilityRefreshTick(0.f);
+}
+
+void FSuperManagerAssetStatusCache::RequestReachabilityRefresh()
+{
+	if (ReachabilityRefreshHandle.IsValid()) { return; }
+
+	ReachabilityRefreshHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateRaw(this, &FSuperManagerAssetStatusCache::OnReachabilityRefreshTick), ReachabilityRefreshDelay);
+}
+
+bool FSuperManagerAssetStatusCache::OnReachabilityRefreshTick(float DeltaTime)
+{
+	ReachabilityRefreshHandle.Reset();
+
+	RefreshReachability();
+	StatusChangedDelegate.Broadcast();
+
+	return false;
+}
+
+void FSuperManagerAssetStatusCache::RefreshReachability()
+{
+	// One walk over the cached edges, no registry access
+	TArray<FName> Frontier;
+
+	for (TPair<FName, FPackageNode>& NodePair : Nodes)
+	{
+		NodePair.Value.bReachable = NodePair.Value.bRoot;
+
+		if (NodePair.Value.bRoot)
+		{
+			Frontier.Add(NodePair.Key);
+		}
+	}
+
+	while (Frontier.Num() > 0)
+	{
+		const FPackageNode& Node = Nodes.FindChecked(Frontier.Pop(false));
+
+		for (const TArray<FName>* Dependencies : { &Node.PackageDependencies, &Node.ManagementDependencies })
+		{
+			for (const FName& Dependency : *Dependencies)
+			{
+				FPackageNode* DependencyNode = Nodes.Find(Dependency);
+				if (DependencyNode == nullptr || DependencyNode->bReachable) { continue; }
+
+				DependencyNode->bReachable = true;
+				Frontier.Add(Dependency);
+			}
+		}
+	}
+}
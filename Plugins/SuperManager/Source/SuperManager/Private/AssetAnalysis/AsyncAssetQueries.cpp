@@ -0,0 +1,181 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/AsyncAssetQueries.h"
+#include "SuperManager.h"
+#include "Async/Async.h"
+
+#pragma region SuperManagerQueries
+FSuperManagerAssetSnapshotRef SuperManagerQueries::CaptureSnapshot(const TArray<FString>& FolderPaths)
+{
+	return FSuperManagerAssetSnapshot::Capture(FolderPaths);
+}
+
+UE::Tasks::TTask<TArray<FAssetData>> SuperManagerQueries::ListUnusedAssets(const FSuperManagerAssetSnapshotRef& Snapshot)
+{
+	return UE::Tasks::Launch(UE_SOURCE_LOCATION, [Snapshot]()
+		{
+			TArray<FAssetData> UnusedAssetsData;
+			Snapshot->ListUnusedAssets(UnusedAssetsData);
+			return UnusedAssetsData;
+		});
+}
+
+UE::Tasks::TTask<TArray<FAssetData>> SuperManagerQueries::ListUnreachableAssets(const FSuperManagerAssetSnapshotRef& Snapshot)
+{
+	return UE::Tasks::Launch(UE_SOURCE_LOCATION, [Snapshot]()
+		{
+			TArray<FAssetData> UnreachableAssetsData;
+			Snapshot->ListUnreachableAssets(UnreachableAssetsData);
+			return UnreachableAssetsData;
+		});
+}
+
+UE::Tasks::TTask<TArray<FAssetData>> SuperManagerQueries::ListSameNameAssets(const FSuperManagerAssetSnapshotRef& Snapshot)
+{
+	return UE::Tasks::Launch(UE_SOURCE_LOCATION, [Snapshot]()
+		{
+			TArray<FAssetData> SameNameAssetsData;
+			Snapshot->ListSameNameAssets(SameNameAssetsData);
+			return SameNameAssetsData;
+		});
+}
+
+UE::Tasks::TTask<TArray<FName>> SuperManagerQueries::ListReferencers(const FSuperManagerAssetSnapshotRef& Snapshot, FName PackageName)
+{
+	return UE::Tasks::Launch(UE_SOURCE_LOCATION, [Snapshot, PackageName]()
+		{
+			TArray<FName> Referencers;
+			Snapshot->ListReferencers(PackageName, Referencers);
+			return Referencers;
+		});
+}
+
+UE::Tasks::TTask<int64> SuperManagerQueries::GetTotalDiskSize(const FSuperManagerAssetSnapshotRef& Snapshot, TArray<FAssetData> AssetsToMeasure)
+{
+	return UE::Tasks::Launch(UE_SOURCE_LOCATION, [Snapshot, AssetsToMeasure = MoveTemp(AssetsToMeasure)]()
+		{
+			return Snapshot->GetTotalDiskSize(AssetsToMeasure);
+		});
+}
+#pragma endregion
+
+#pragma region USuperManagerAsyncQuery
+USuperManagerAsyncQuery* USuperManagerAsyncQuery::ListUnusedAssetsAsync(const TArray<FString>& FolderPaths)
+{
+	USuperManagerAsyncQuery* Query = CreateQuery(ESuperManagerQueryType::Unused);
+	Query->QueryFolderPaths = FolderPaths;
+
+	return Query;
+}
+
+USuperManagerAsyncQuery* USuperManagerAsyncQuery::ListUnreachableAssetsAsync(const TArray<FString>& FolderPaths)
+{
+	USuperManagerAsyncQuery* Query = CreateQuery(ESuperManagerQueryType::Unreachable);
+	Query->QueryFolderPaths = FolderPaths;
+
+	return Query;
+}
+
+USuperManagerAsyncQuery* USuperManagerAsyncQuery::ListSameNameAssetsAsync(const TArray<FString>& FolderPaths)
+{
+	USuperManagerAsyncQuery* Query = CreateQuery(ESuperManagerQueryType::SameName);
+	Query->QueryFolderPaths = FolderPaths;
+
+	return Query;
+}
+
+USuperManagerAsyncQuery* USuperManagerAsyncQuery::ListReferencersAsync(const FString& PackageName)
+{
+	USuperManagerAsyncQuery* Query = CreateQuery(ESuperManagerQueryType::ReferencersOf);
+	Query->QueryPackageName = FName(*PackageName);
+
+	return Query;
+}
+
+USuperManagerAsyncQuery* USuperManagerAsyncQuery::GetTotalDiskSizeAsync(const TArray<FAssetData>& AssetsToMeasure)
+{
+	USuperManagerAsyncQuery* Query = CreateQuery(ESuperManagerQueryType::SizeOf);
+	Query->QueryAssets = AssetsToMeasure;
+
+	return Query;
+}
+
+void USuperManagerAsyncQuery::Activate()
+{
+	// Keep ourselves alive until the worker hands the result back
+	AddToRoot();
+
+	// The module keeps one snapshot of all of /Game until the registry changes, so only the first query pays for the sweep
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	const FSuperManagerAssetSnapshotRef Snapshot = SuperManagerModule.GetProjectAssetSnapshot();
+	TWeakObjectPtr<USuperManagerAsyncQuery> WeakThis(this);
+
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, Snapshot, QueryType = QueryType, FolderPaths = QueryFolderPaths, PackageName = QueryPackageName, AssetsToMeasure = QueryAssets]()
+		{
+			TArray<FAssetData> ResultAssets;
+			TArray<FString> ResultPackageNames;
+			int64 TotalDiskSize = 0;
+
+			switch (QueryType)
+			{
+			case ESuperManagerQueryType::Unused:
+				Snapshot->ListUnusedAssets(ResultAssets, FolderPaths);
+				break;
+
+			case ESuperManagerQueryType::Unreachable:
+				Snapshot->ListUnreachableAssets(ResultAssets, FolderPaths);
+				break;
+
+			case ESuperManagerQueryType::SameName:
+				Snapshot->ListSameNameAssets(ResultAssets, FolderPaths);
+				break;
+
+			case ESuperManagerQueryType::ReferencersOf:
+			{
+				TArray<FName> Referencers;
+				Snapshot->ListReferencers(PackageName, Referencers);
+
+				for (const FName& Referencer : Referencers)
+				{
+					ResultPackageNames.Add(Referencer.ToString());
+				}
+				break;
+			}
+
+			case ESuperManagerQueryType::SizeOf:
+				ResultAssets = AssetsToMeasure;
+				break;
+
+			default:
+				break;
+			}
+
+			TotalDiskSize = Snapshot->GetTotalDiskSize(ResultAssets);
+
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, ResultAssets = MoveTemp(ResultAssets), ResultPackageNames = MoveTemp(ResultPackageNames), TotalDiskSize]() mutable
+				{
+					if (USuperManagerAsyncQuery* Query = WeakThis.Get())
+					{
+						Query->FinishQuery(MoveTemp(ResultAssets), MoveTemp(ResultPackageNames), TotalDiskSize);
+					}
+				});
+		});
+}
+
+USuperManagerAsyncQuery* USuperManagerAsyncQuery::CreateQuery(ESuperManagerQueryType InQueryType)
+{
+	USuperManagerAsyncQuery* Query = NewObject<USuperManagerAsyncQuery>();
+	Query->QueryType = InQueryType;
+
+	return Query;
+}
+
+void USuperManagerAsyncQuery::FinishQuery(TArray<FAssetData>&& Assets, TArray<FString>&& PackageNames, int64 TotalDiskSize)
+{
+	Completed.Broadcast(Assets, PackageNames, TotalDiskSize);
+
+	RemoveFromRoot();
+	SetReadyToDestroy();
+}
+#pragma endregion
@@ -0,0 +1,155 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/BulkAssetProcessing.h"
+#include "DebugHeader.h"
+
+#include "EditorAssetLibrary.h"
+#include "PackageTools.h"
+#include "HAL/PlatformMemory.h"
+#include "UObject/Package.h"
+
+namespace
+{
+	void SamplePeakMemory(FSuperManagerBulkStats& Stats)
+	{
+		Stats.PeakUsedPhysical = FMath::Max<uint64>(Stats.PeakUsedPhysical, FPlatformMemory::GetStats().UsedPhysical);
+	}
+
+	void UnloadPassPackages(TArray<TWeakObjectPtr<UPackage>>& PassPackages, FSuperManagerBulkStats& Stats)
+	{
+		TArray<UPackage*> PackagesToUnload;
+
+		for (const TWeakObjectPtr<UPackage>& PassPackage : PassPackages)
+		{
+			// Callbacks may delete assets, and unsaved edits have to stay in memory
+			UPackage* Package = PassPackage.Get();
+			if (Package == nullptr || Package->IsDirty()) { continue; }
+
+			PackagesToUnload.AddUnique(Package);
+		}
+
+		PassPackages.Empty();
+
+		if (PackagesToUnload.Num() == 0) { return; }
+
+		// Clears the standalone flags a plain editor GC would keep and collects garbage once for all of them
+		FText ErrorMessage;
+		if (UPackageTools::UnloadPackages(PackagesToUnload, ErrorMessage) == false)
+		{
+			DebugHeader::PrintLog(ErrorMessage.ToString());
+		}
+
+		Stats.NumUnloads++;
+	}
+}
+
+FString FSuperManagerBulkStats::Describe() const
+{
+	return FString::Printf(TEXT("Loaded %d of %d assets (%d failed) in %d waves, %.1fs, %.1f assets/s, %d modified, %d unloads, peak %.0f MB used physical"),
+		NumLoaded, NumRequested, NumFailed, NumWaves, Seconds, GetAssetsPerSecond(), NumModified, NumUnloads, PeakUsedPhysical / (1024.0 * 1024.0));
+}
+
+FSuperManagerBulkStats SuperManagerBulk::ProcessWaves(const TArray<FAssetData>& AssetsData, FWaveCallback Callback, const FSuperManagerBulkSettings& Settings)
+{
+	FSuperManagerBulkStats Stats;
+	Stats.NumRequested = AssetsData.Num();
+
+	const double StartTime = FPlatformTime::Seconds();
+	const int32 WaveSize = FMath::Max(Settings.WaveSize, 1);
+	const uint64 MemoryCeilingBytes = uint64(FMath::Max(Settings.MemoryCeilingMB, 1)) * 1024 * 1024;
+
+	// Only what this pass brought in gets unloaded, assets the user already had open stay
+	TArray<TWeakObjectPtr<UPackage>> PassPackages;
+
+	for (int32 WaveStart = 0; WaveStart < AssetsData.Num(); WaveStart += WaveSize)
+	{
+		const int32 WaveEnd = FMath::Min(WaveStart + WaveSize, AssetsData.Num());
+
+		TArray<bool> WasLoaded;
+		TArray<int32> LoadRequests;
+
+		for (int32 AssetIndex = WaveStart; AssetIndex < WaveEnd; AssetIndex++)
+		{
+			WasLoaded.Add(AssetsData[AssetIndex].IsAssetLoaded());
+
+			if (WasLoaded.Last()) { continue; }
+
+			LoadRequests.Add(LoadPackageAsync(AssetsData[AssetIndex].PackageName.ToString()));
+		}
+
+		// Requesting the whole wave before waiting lets the loader overlap its reads
+		for (int32 LoadRequest : LoadRequests)
+		{
+			FlushAsyncLoading(LoadRequest);
+		}
+
+		TArray<UObject*> LoadedAssets;
+
+		for (int32 AssetIndex = WaveStart; AssetIndex < WaveEnd; AssetIndex++)
+		{
+			UObject* LoadedAsset = AssetsData[AssetIndex].FastGetAsset(false);
+
+			if (LoadedAsset == nullptr)
+			{
+				Stats.NumFailed++;
+				continue;
+			}
+
+			if (WasLoaded[AssetIndex - WaveStart] == false)
+			{
+				PassPackages.Add(LoadedAsset->GetPackage());
+			}
+
+			LoadedAssets.Add(LoadedAsset);
+		}
+
+		Stats.NumLoaded += LoadedAssets.Num();
+		Stats.NumWaves++;
+		SamplePeakMemory(Stats);
+
+		TArray<UObject*> ModifiedAssets;
+		Callback(LoadedAssets, ModifiedAssets);
+
+		Stats.NumModified += ModifiedAssets.Num();
+
+		// One save for every touched package of the wave
+		if (Settings.bSaveModifiedAssets && ModifiedAssets.Num() > 0)
+		{
+			UEditorAssetLibrary::SaveLoadedAssets(ModifiedAssets, true);
+		}
+
+		LoadedAssets.Empty();
+		ModifiedAssets.Empty();
+		SamplePeakMemory(Stats);
+
+		if (FPlatformMemory::GetStats().UsedPhysical > MemoryCeilingBytes)
+		{
+			UnloadPassPackages(PassPackages, Stats);
+		}
+	}
+
+	// Hand the memory back once the pass is over
+	UnloadPassPackages(PassPackages, Stats);
+
+	Stats.Seconds = FPlatformTime::Seconds() - StartTime;
+
+	DebugHeader::PrintLog(Stats.Describe());
+
+	return Stats;
+}
+
+FSuperManagerBulkStats SuperManagerBulk::ProcessAssets(const TArray<FAssetData>& AssetsData, FAssetCallback Callback, const FSuperManagerBulkSettings& Settings)
+{
+	return ProcessWaves(AssetsData, [Callback](const TArray<UObject*>& LoadedAssets, TArray<UObject*>& OutModifiedAssets)
+		{
+			for (UObject* LoadedAsset : LoadedAssets)
+			{
+				if (Callback(LoadedAsset))
+				{
+					OutModifiedAssets.Add(LoadedAsset);
+				}
+			}
+		},
+		Settings);
+}
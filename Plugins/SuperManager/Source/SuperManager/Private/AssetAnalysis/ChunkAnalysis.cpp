@@ -0,0 +1,258 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/ChunkAnalysis.h"
+#include "AssetAnalysis/AssetSnapshot.h"
+
+#include "Engine/AssetManager.h"
+
+namespace
+{
+	/** Chunks a package is headed for, from the managers of the highest priority that reach it */
+	struct FChunkAssignment
+	{
+		int32 Priority = MIN_int32;
+
+		/** Sorted */
+		TArray<int32> ChunkIds;
+	};
+
+	/**
+	 * Every distinct assignment is stored once and joins are memoized: most packages share one of a handful
+	 * of assignments, so the sweep moves integers around instead of merging arrays per edge.
+	 */
+	class FChunkAssignmentTable
+	{
+	public:
+		static constexpr int32 Unassigned = 0;
+
+		FChunkAssignmentTable()
+		{
+			Assignments.AddDefaulted();
+		}
+
+		const FChunkAssignment& Get(int32 AssignmentIndex) const { return Assignments[AssignmentIndex]; }
+
+		int32 Make(int32 ChunkId, int32 Priority)
+		{
+			FChunkAssignment Assignment;
+			Assignment.Priority = Priority;
+			Assignment.ChunkIds.Add(ChunkId);
+
+			return Intern(MoveTemp(Assignment));
+		}
+
+		int32 Join(int32 A, int32 B)
+		{
+			if (A == B || B == Unassigned) { return A; }
+			if (A == Unassigned) { return B; }
+
+			const uint64 JoinKey = A < B ? (uint64(A) << 32) | uint64(B) : (uint64(B) << 32) | uint64(A);
+			if (const int32* Joined = JoinCache.Find(JoinKey))
+			{
+				return *Joined;
+			}
+
+			int32 Result = INDEX_NONE;
+
+			if (Assignments[A].Priority != Assignments[B].Priority)
+			{
+				Result = Assignments[A].Priority > Assignments[B].Priority ? A : B;
+			}
+			else
+			{
+				FChunkAssignment Merged = Assignments[A];
+				for (int32 ChunkId : Assignments[B].ChunkIds)
+				{
+					Merged.ChunkIds.AddUnique(ChunkId);
+				}
+				Merged.ChunkIds.Sort();
+
+				Result = Intern(MoveTemp(Merged));
+			}
+
+			JoinCache.Add(JoinKey, Result);
+
+			return Result;
+		}
+
+	private:
+		static uint32 HashAssignment(const FChunkAssignment& Assignment)
+		{
+			uint32 Hash = GetTypeHash(Assignment.Priority);
+			for (int32 ChunkId : Assignment.ChunkIds)
+			{
+				Hash = HashCombine(Hash, GetTypeHash(ChunkId));
+			}
+
+			return Hash;
+		}
+
+		int32 Intern(FChunkAssignment&& Assignment)
+		{
+			const uint32 Hash = HashAssignment(Assignment);
+
+			TArray<int32, TInlineAllocator<4>> Candidates;
+			IndicesByHash.MultiFind(Hash, Candidates);
+
+			for (int32 Candidate : Candidates)
+			{
+				if (Assignments[Candidate].Priority == Assignment.Priority && Assignments[Candidate].ChunkIds == Assignment.ChunkIds)
+				{
+					return Candidate;
+				}
+			}
+
+			const int32 AssignmentIndex = Assignments.Add(MoveTemp(Assignment));
+			IndicesByHash.Add(Hash, AssignmentIndex);
+
+			return AssignmentIndex;
+		}
+
+	private:
+		TArray<FChunkAssignment> Assignments;
+		TMultiMap<uint32, int32> IndicesByHash;
+		TMap<uint64, int32> JoinCache;
+	};
+
+	// Cooking follows both hard and soft references, but never into another primary asset: that one has rules of its own
+	bool IsChunkEdge(ESuperManagerDependencyKind Kinds, int32 Dependency, const TBitArray<>& PrimaryAssetPackages)
+	{
+		return EnumHasAnyFlags(Kinds, ESuperManagerDependencyKind::Package) && PrimaryAssetPackages[Dependency] == false;
+	}
+}
+
+bool SuperManagerChunkAnalysis::GatherChunkSeeds(const FSuperManagerAssetSnapshot& Snapshot, TArray<FSuperManagerChunkSeed>& OutSeeds, TBitArray<>& OutPrimaryAssetPackages)
+{
+	check(IsInGameThread());
+
+	OutSeeds.Empty();
+	OutPrimaryAssetPackages.Init(false, Snapshot.NumPackages());
+
+	UAssetManager* AssetManager = UAssetManager::GetIfInitialized();
+	if (AssetManager == nullptr) { return false; }
+
+	TArray<FPrimaryAssetTypeInfo> TypeInfos;
+	AssetManager->GetPrimaryAssetTypeInfoList(TypeInfos);
+
+	TArray<FPrimaryAssetId> PrimaryAssetIds;
+
+	for (const FPrimaryAssetTypeInfo& TypeInfo : TypeInfos)
+	{
+		PrimaryAssetIds.Reset();
+		AssetManager->GetPrimaryAssetIdList(TypeInfo.PrimaryAssetType, PrimaryAssetIds);
+
+		for (const FPrimaryAssetId& PrimaryAssetId : PrimaryAssetIds)
+		{
+			const FPrimaryAssetRules Rules = AssetManager->GetPrimaryAssetRules(PrimaryAssetId);
+			if (Rules.CookRule == EPrimaryAssetCookRule::NeverCook) { continue; }
+
+			// Without a chunk of its own a primary asset ships in the base chunk
+			const int32 ChunkId = FMath::Max(Rules.ChunkId, 0);
+
+			const int32 PackageIndex = Snapshot.FindPackageIndex(AssetManager->GetPrimaryAssetPath(PrimaryAssetId).GetLongPackageFName());
+			if (PackageIndex != INDEX_NONE)
+			{
+				OutPrimaryAssetPackages[PackageIndex] = true;
+				OutSeeds.Add(FSuperManagerChunkSeed{ PackageIndex, ChunkId, Rules.Priority });
+			}
+
+			// Labels reach their explicit and directory assets through management edges from the id, the snapshot keeps those as nodes
+			const int32 ManagerIndex = Snapshot.FindPackageIndex(FName(*FAssetIdentifier(PrimaryAssetId).ToString()));
+			if (ManagerIndex == INDEX_NONE) { continue; }
+
+			const TConstArrayView<int32> Dependencies = Snapshot.GetDependencies(ManagerIndex);
+			const TConstArrayView<ESuperManagerDependencyKind> DependencyKinds = Snapshot.GetDependencyKinds(ManagerIndex);
+
+			for (int32 EdgeIndex = 0; EdgeIndex < Dependencies.Num(); EdgeIndex++)
+			{
+				if (EnumHasAnyFlags(DependencyKinds[EdgeIndex], ESuperManagerDependencyKind::Management) == false) { continue; }
+
+				OutSeeds.Add(FSuperManagerChunkSeed{ Dependencies[EdgeIndex], ChunkId, Rules.Priority });
+			}
+		}
+	}
+
+	return true;
+}
+
+void SuperManagerChunkAnalysis::ResolveChunks(const FSuperManagerAssetSnapshot& Snapshot, const TArray<FSuperManagerChunkSeed>& Seeds, const TBitArray<>& PrimaryAssetPackages, TArray<TArray<int32>>& OutPackageChunks)
+{
+	const int32 NumPackages = Snapshot.NumPackages();
+
+	FSuperManagerPackageComponents Components;
+	Snapshot.FindComponents([&PrimaryAssetPackages](ESuperManagerDependencyKind Kinds, int32 Dependency)
+		{
+			return IsChunkEdge(Kinds, Dependency, PrimaryAssetPackages);
+		},
+		Components);
+
+	const TArray<int32>& ComponentOf = Components.ComponentOf;
+	const int32 NumComponents = Components.Num();
+
+	// Packages of a cycle always share their chunks, so a whole component carries one assignment
+	FChunkAssignmentTable AssignmentTable;
+	TArray<int32> ComponentAssignments;
+	ComponentAssignments.Init(FChunkAssignmentTable::Unassigned, NumComponents);
+
+	for (const FSuperManagerChunkSeed& Seed : Seeds)
+	{
+		int32& ComponentAssignment = ComponentAssignments[ComponentOf[Seed.PackageIndex]];
+		ComponentAssignment = AssignmentTable.Join(ComponentAssignment, AssignmentTable.Make(Seed.ChunkId, Seed.Priority));
+	}
+
+	// Referencers before dependencies: by the time a component is reached, everything flowing into it has arrived
+	for (int32 Component = NumComponents - 1; Component >= 0; Component--)
+	{
+		const int32 Assignment = ComponentAssignments[Component];
+		if (Assignment == FChunkAssignmentTable::Unassigned) { continue; }
+
+		for (int32 Package : Components.GetMembers(Component))
+		{
+			const TConstArrayView<int32> Dependencies = Snapshot.GetDependencies(Package);
+			const TConstArrayView<ESuperManagerDependencyKind> DependencyKinds = Snapshot.GetDependencyKinds(Package);
+
+			for (int32 EdgeIndex = 0; EdgeIndex < Dependencies.Num(); EdgeIndex++)
+			{
+				const int32 Dependency = Dependencies[EdgeIndex];
+				if (IsChunkEdge(DependencyKinds[EdgeIndex], Dependency, PrimaryAssetPackages) == false) { continue; }
+
+				const int32 DependencyComponent = ComponentOf[Dependency];
+				if (DependencyComponent == Component) { continue; }
+
+				ComponentAssignments[DependencyComponent] = AssignmentTable.Join(ComponentAssignments[DependencyComponent], Assignment);
+			}
+		}
+	}
+
+	OutPackageChunks.Empty(NumPackages);
+	for (int32 PackageIndex = 0; PackageIndex < NumPackages; PackageIndex++)
+	{
+		OutPackageChunks.Add(AssignmentTable.Get(ComponentAssignments[ComponentOf[PackageIndex]]).ChunkIds);
+	}
+}
+
+void SuperManagerChunkAnalysis::ListDuplicatedPackages(const FSuperManagerAssetSnapshot& Snapshot, const TArray<TArray<int32>>& PackageChunks, TArray<FSuperManagerChunkDuplicate>& OutDuplicates)
+{
+	OutDuplicates.Empty();
+
+	for (int32 PackageIndex = 0; PackageIndex < PackageChunks.Num(); PackageIndex++)
+	{
+		if (PackageChunks[PackageIndex].Num() < 2) { continue; }
+
+		FSuperManagerChunkDuplicate& Duplicate = OutDuplicates.AddDefaulted_GetRef();
+		Duplicate.PackageIndex = PackageIndex;
+		Duplicate.ChunkIds = PackageChunks[PackageIndex];
+		Duplicate.DiskSize = Snapshot.GetPackageDiskSize(PackageIndex);
+	}
+
+	OutDuplicates.Sort([](const FSuperManagerChunkDuplicate& A, const FSuperManagerChunkDuplicate& B)
+		{
+			if (A.GetDuplicatedBytes() != B.GetDuplicatedBytes())
+			{
+				return A.GetDuplicatedBytes() > B.GetDuplicatedBytes();
+			}
+
+			return A.ChunkIds.Num() > B.ChunkIds.Num();
+		});
+}
@@ -0,0 +1,287 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/MapLoadClosure.h"
+#include "AssetAnalysis/AssetSnapshot.h"
+
+#include "Engine/SkeletalMesh.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/Texture2D.h"
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+
+namespace
+{
+	const FName OtherContentClass(TEXT("Other content"));
+
+	// Only hard references are loaded with the map; soft ones wait for whoever resolves them
+	bool IsLoadEdge(ESuperManagerDependencyKind Kinds, int32 Dependency, const TBitArray<>& Reachable)
+	{
+		return EnumHasAnyFlags(Kinds, ESuperManagerDependencyKind::Hard) && Reachable[Dependency];
+	}
+
+	int64 GetIntegerTag(const FAssetData& AssetData, FName TagName)
+	{
+		int64 Value = 0;
+		AssetData.GetTagValue(TagName, Value);
+
+		return Value;
+	}
+}
+
+int64 SuperManagerMapLoadClosure::EstimateResidentBytes(const FAssetData& AssetData, int64 DiskBytes)
+{
+	if (AssetData.AssetClassPath == UTexture2D::StaticClass()->GetClassPathName())
+	{
+		FString Dimensions;
+		FString Width;
+		FString Height;
+
+		if (AssetData.GetTagValue(TEXT("Dimensions"), Dimensions) && Dimensions.Split(TEXT("x"), &Width, &Height))
+		{
+			const int64 NumPixels = int64(FCString::Atoi(*Width)) * int64(FCString::Atoi(*Height));
+
+			FString HasAlphaChannel;
+			const bool bHasAlpha = AssetData.GetTagValue(TEXT("HasAlphaChannel"), HasAlphaChannel) == false || HasAlphaChannel.ToBool();
+
+			// BC3 takes a byte a pixel and BC1 half of that; the mips below the top one add a third
+			const int64 TopMipBytes = bHasAlpha ? NumPixels : NumPixels / 2;
+			return TopMipBytes * 4 / 3;
+		}
+	}
+	else if (AssetData.AssetClassPath == UStaticMesh::StaticClass()->GetClassPathName())
+	{
+		const int64 NumVertices = GetIntegerTag(AssetData, TEXT("Vertices"));
+		const int64 NumTriangles = GetIntegerTag(AssetData, TEXT("Triangles"));
+
+		// Position, packed tangent basis and two UV channels per vertex, 32 bit indices
+		if (NumVertices > 0) { return NumVertices * 32 + NumTriangles * 12; }
+	}
+	else if (AssetData.AssetClassPath == USkeletalMesh::StaticClass()->GetClassPathName())
+	{
+		const int64 NumVertices = GetIntegerTag(AssetData, TEXT("Vertices"));
+		const int64 NumTriangles = GetIntegerTag(AssetData, TEXT("Triangles"));
+
+		// Skin weights on top of what a static mesh vertex holds
+		if (NumVertices > 0) { return NumVertices * 48 + NumTriangles * 12; }
+	}
+
+	return DiskBytes;
+}
+
+void SuperManagerMapLoadClosure::AnalyseMaps(const FSuperManagerAssetSnapshot& Snapshot, int32 NumLargestPackages, TArray<FSuperManagerMapLoadClosure>& OutClosures)
+{
+	OutClosures.Empty();
+
+	const int32 NumPackages = Snapshot.NumPackages();
+
+	// One asset stands for its package, the one named after it when there are several
+	TArray<int32> PackageAssets;
+	PackageAssets.Init(INDEX_NONE, NumPackages);
+
+	TArray<int32> MapPackages;
+	const FTopLevelAssetPath WorldClassPath = UWorld::StaticClass()->GetClassPathName();
+
+	for (int32 AssetIndex = 0; AssetIndex < Snapshot.NumAssets(); AssetIndex++)
+	{
+		const FAssetData& AssetData = Snapshot.GetAsset(AssetIndex);
+		const int32 PackageIndex = Snapshot.GetAssetPackageIndex(AssetIndex);
+
+		if (PackageAssets[PackageIndex] == INDEX_NONE || AssetData.AssetName == FPackageName::GetShortFName(AssetData.PackageName))
+		{
+			PackageAssets[PackageIndex] = AssetIndex;
+		}
+
+		if (AssetData.AssetClassPath == WorldClassPath)
+		{
+			MapPackages.AddUnique(PackageIndex);
+		}
+	}
+
+	if (MapPackages.Num() == 0) { return; }
+
+	// Packages some map loads; closures are bit arrays over these alone, numbered in discovery order
+	TBitArray<> Reachable(false, NumPackages);
+	TArray<int32> DenseIndices;
+	DenseIndices.Init(INDEX_NONE, NumPackages);
+	TArray<int32> ReachablePackages;
+
+	TArray<int32> PackageStack = MapPackages;
+	for (int32 MapPackage : MapPackages)
+	{
+		Reachable[MapPackage] = true;
+	}
+
+	while (PackageStack.Num() > 0)
+	{
+		const int32 Package = PackageStack.Pop(false);
+		DenseIndices[Package] = ReachablePackages.Add(Package);
+
+		const TConstArrayView<int32> Dependencies = Snapshot.GetDependencies(Package);
+		const TConstArrayView<ESuperManagerDependencyKind> DependencyKinds = Snapshot.GetDependencyKinds(Package);
+
+		for (int32 EdgeIndex = 0; EdgeIndex < Dependencies.Num(); EdgeIndex++)
+		{
+			const int32 Dependency = Dependencies[EdgeIndex];
+			if (Reachable[Dependency] || EnumHasAnyFlags(DependencyKinds[EdgeIndex], ESuperManagerDependencyKind::Hard) == false) { continue; }
+
+			// Native classes are in memory before any map is
+			if (FPackageName::IsScriptPackage(Snapshot.GetPackageName(Dependency).ToString())) { continue; }
+
+			Reachable[Dependency] = true;
+			PackageStack.Push(Dependency);
+		}
+	}
+
+	const int32 NumReachable = ReachablePackages.Num();
+
+	// What each reachable package weighs, looked up once instead of once per map that loads it
+	TArray<FName> PackageClasses;
+	TArray<int64> PackageDiskBytes;
+	TArray<int64> PackageResidentBytes;
+	PackageClasses.Reserve(NumReachable);
+	PackageDiskBytes.Reserve(NumReachable);
+	PackageResidentBytes.Reserve(NumReachable);
+
+	for (int32 Package : ReachablePackages)
+	{
+		const int64 DiskBytes = Snapshot.GetPackageDiskSize(Package);
+		const int32 AssetIndex = PackageAssets[Package];
+
+		if (AssetIndex == INDEX_NONE)
+		{
+			PackageClasses.Add(OtherContentClass);
+			PackageDiskBytes.Add(DiskBytes);
+			PackageResidentBytes.Add(DiskBytes);
+			continue;
+		}
+
+		const FAssetData& AssetData = Snapshot.GetAsset(AssetIndex);
+		PackageClasses.Add(AssetData.AssetClassPath.GetAssetName());
+		PackageDiskBytes.Add(DiskBytes);
+		PackageResidentBytes.Add(EstimateResidentBytes(AssetData, DiskBytes));
+	}
+
+	FSuperManagerPackageComponents Components;
+	Snapshot.FindComponents([&Reachable](ESuperManagerDependencyKind Kinds, int32 Dependency)
+		{
+			return IsLoadEdge(Kinds, Dependency, Reachable);
+		},
+		Components);
+
+	const TArray<int32>& ComponentOf = Components.ComponentOf;
+	const int32 NumComponents = Components.Num();
+
+	TBitArray<> MapComponents(false, NumComponents);
+	for (int32 MapPackage : MapPackages)
+	{
+		MapComponents[ComponentOf[MapPackage]] = true;
+	}
+
+	// Calls Visit once per distinct component the members of Component load directly
+	TArray<int32> LastVisitedFrom;
+	LastVisitedFrom.Init(INDEX_NONE, NumComponents);
+
+	auto ForEachDependencyComponent = [&](int32 Component, TFunctionRef<void(int32)> Visit)
+	{
+		for (int32 Package : Components.GetMembers(Component))
+		{
+			const TConstArrayView<int32> Dependencies = Snapshot.GetDependencies(Package);
+			const TConstArrayView<ESuperManagerDependencyKind> DependencyKinds = Snapshot.GetDependencyKinds(Package);
+
+			for (int32 EdgeIndex = 0; EdgeIndex < Dependencies.Num(); EdgeIndex++)
+			{
+				if (IsLoadEdge(DependencyKinds[EdgeIndex], Dependencies[EdgeIndex], Reachable) == false) { continue; }
+
+				const int32 DependencyComponent = ComponentOf[Dependencies[EdgeIndex]];
+				if (DependencyComponent == Component || LastVisitedFrom[DependencyComponent] == Component) { continue; }
+
+				LastVisitedFrom[DependencyComponent] = Component;
+				Visit(DependencyComponent);
+			}
+		}
+	};
+
+	auto IsReachableComponent = [&](int32 Component)
+	{
+		return Reachable[Components.GetMembers(Component)[0]];
+	};
+
+	// Referencing components still to consume each closure; a cycle is wholly reachable or not at all
+	TArray<int32> PendingReferencers;
+	PendingReferencers.Init(0, NumComponents);
+
+	for (int32 Component = 0; Component < NumComponents; Component++)
+	{
+		if (IsReachableComponent(Component) == false) { continue; }
+
+		ForEachDependencyComponent(Component, [&PendingReferencers](int32 DependencyComponent)
+			{
+				PendingReferencers[DependencyComponent]++;
+			});
+	}
+
+	LastVisitedFrom.Init(INDEX_NONE, NumComponents);
+
+	// Dependencies first, so every closure below a component is complete by the time it is merged
+	TArray<TBitArray<>> Closures;
+	Closures.SetNum(NumComponents);
+
+	for (int32 Component = 0; Component < NumComponents; Component++)
+	{
+		if (IsReachableComponent(Component) == false) { continue; }
+
+		TBitArray<>& Closure = Closures[Component];
+		Closure.Init(false, NumReachable);
+
+		for (int32 Package : Components.GetMembers(Component))
+		{
+			Closure[DenseIndices[Package]] = true;
+		}
+
+		ForEachDependencyComponent(Component, [&](int32 DependencyComponent)
+			{
+				Closure.CombineWithBitwiseOR(Closures[DependencyComponent], EBitwiseOperatorFlags::MaintainSize);
+
+				if (--PendingReferencers[DependencyComponent] == 0 && MapComponents[DependencyComponent] == false)
+				{
+					Closures[DependencyComponent].Empty();
+				}
+			});
+	}
+
+	for (int32 MapPackage : MapPackages)
+	{
+		FSuperManagerMapLoadClosure& Result = OutClosures.AddDefaulted_GetRef();
+		Result.MapPackageIndex = MapPackage;
+
+		for (TConstSetBitIterator<> It(Closures[ComponentOf[MapPackage]]); It; ++It)
+		{
+			const int32 DenseIndex = It.GetIndex();
+
+			Result.Total.Add(PackageDiskBytes[DenseIndex], PackageResidentBytes[DenseIndex]);
+			Result.PerClass.FindOrAdd(PackageClasses[DenseIndex]).Add(PackageDiskBytes[DenseIndex], PackageResidentBytes[DenseIndex]);
+			Result.LargestPackages.Emplace(ReachablePackages[DenseIndex], PackageResidentBytes[DenseIndex]);
+		}
+
+		Result.PerClass.ValueSort([](const FSuperManagerMemoryEstimate& A, const FSuperManagerMemoryEstimate& B)
+			{
+				return A.ResidentBytes > B.ResidentBytes;
+			});
+
+		Result.LargestPackages.Sort([](const TPair<int32, int64>& A, const TPair<int32, int64>& B)
+			{
+				return A.Value > B.Value;
+			});
+
+		if (Result.LargestPackages.Num() > NumLargestPackages)
+		{
+			Result.LargestPackages.SetNum(NumLargestPackages);
+		}
+	}
+
+	OutClosures.Sort([](const FSuperManagerMapLoadClosure& A, const FSuperManagerMapLoadClosure& B)
+		{
+			return A.Total.ResidentBytes > B.Total.ResidentBytes;
+		});
+}
@@ -0,0 +1,433 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/MaterialAnalysis.h"
+#include "Materials/MaterialInstanceConstant.h"
+#include "Engine/Font.h"
+#include "VT/RuntimeVirtualTexture.h"
+#include "Hash/xxhash.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialExpressionQualitySwitch.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/SkeletalMesh.h"
+#include "Particles/ParticleSystem.h"
+#include "NiagaraSystem.h"
+#include "Engine/Blueprint.h"
+#include "Engine/World.h"
+#include "AssetAnalysis/BulkAssetProcessing.h"
+
+namespace
+{
+	FString DescribeParameterInfo(const FMaterialParameterInfo& ParameterInfo)
+	{
+		return FString::Printf(TEXT("%s@%d@%d"), *ParameterInfo.Name.ToString(), int32(ParameterInfo.Association), ParameterInfo.Index);
+	}
+
+	FString DescribeObject(const UObject* Object)
+	{
+		return Object ? Object->GetPathName() : TEXT("None");
+	}
+
+	FString ExportPropertyValue(const FProperty* Property, const void* Container)
+	{
+		TArray<FString> Elements;
+
+		for (int32 ArrayIndex = 0; ArrayIndex < Property->ArrayDim; ArrayIndex++)
+		{
+			FString Value;
+			Property->ExportText_InContainer(ArrayIndex, Value, Container, nullptr, nullptr, PPF_None);
+			Elements.Add(MoveTemp(Value));
+		}
+
+		return FString::Join(Elements, TEXT(","));
+	}
+
+	// Described field by field elsewhere in the fingerprint, or bookkeeping that differs between otherwise identical assets
+	bool IsExcludedFromFingerprint(const FProperty* Property)
+	{
+		static const TSet<FName> ExcludedProperties =
+		{
+			TEXT("Parent"), TEXT("ScalarParameterValues"), TEXT("VectorParameterValues"), TEXT("DoubleVectorParameterValues"),
+			TEXT("TextureParameterValues"), TEXT("RuntimeVirtualTextureParameterValues"),
+			TEXT("FontParameterValues"), TEXT("StaticParameters"), TEXT("StaticParametersRuntime"), TEXT("BasePropertyOverrides"),
+			TEXT("LightingGuid"), TEXT("AssetImportData"), TEXT("ThumbnailInfo"), TEXT("PreviewMesh"), TEXT("AssetUserData"),
+			TEXT("LayerParameterExpansion"), TEXT("ParameterOverviewExpansion"), TEXT("TextureStreamingData"),
+			TEXT("TextureStreamingDataVersion"), TEXT("bTextureStreamingDataSorted"), TEXT("CachedReferencedTextures"),
+			TEXT("ReferencedTextureGuids"), TEXT("bIncludedInBaseGame")
+		};
+
+		return Property->HasAnyPropertyFlags(CPF_Transient | CPF_DuplicateTransient) || ExcludedProperties.Contains(Property->GetFName());
+	}
+
+	// Rough desktop averages: shaders compiled per vertex factory for a lit surface, and their size in the DDC
+	constexpr int32 ShadersPerVertexFactory = 24;
+	constexpr int64 AverageShaderBytes = 12 * 1024;
+
+	struct FUsageFlagInfo
+	{
+		EMaterialUsage Usage;
+		const TCHAR* Name;
+		/** Asset class whose presence among the referencers justifies the flag, null when we cannot tell */
+		UClass* RequiredReferencerClass;
+		/** Whether the flag compiles the material for a vertex factory of its own; static lighting only switches lightmap policies */
+		bool bAddsVertexFactory;
+	};
+
+	const TArray<FUsageFlagInfo>& GetUsageFlagInfos()
+	{
+		static const TArray<FUsageFlagInfo> UsageFlagInfos =
+		{
+			{MATUSAGE_SkeletalMesh, TEXT("bUsedWithSkeletalMesh"), USkeletalMesh::StaticClass(), true},
+			{MATUSAGE_MorphTargets, TEXT("bUsedWithMorphTargets"), USkeletalMesh::StaticClass(), true},
+			{MATUSAGE_Clothing, TEXT("bUsedWithClothing"), USkeletalMesh::StaticClass(), true},
+			{MATUSAGE_ParticleSprites, TEXT("bUsedWithParticleSprites"), UParticleSystem::StaticClass(), true},
+			{MATUSAGE_BeamTrails, TEXT("bUsedWithBeamTrails"), UParticleSystem::StaticClass(), true},
+			{MATUSAGE_MeshParticles, TEXT("bUsedWithMeshParticles"), UParticleSystem::StaticClass(), true},
+			{MATUSAGE_NiagaraSprites, TEXT("bUsedWithNiagaraSprites"), UNiagaraSystem::StaticClass(), true},
+			{MATUSAGE_NiagaraRibbons, TEXT("bUsedWithNiagaraRibbons"), UNiagaraSystem::StaticClass(), true},
+			{MATUSAGE_NiagaraMeshParticles, TEXT("bUsedWithNiagaraMeshParticles"), UNiagaraSystem::StaticClass(), true},
+			{MATUSAGE_StaticLighting, TEXT("bUsedWithStaticLighting"), nullptr, false},
+			{MATUSAGE_SplineMesh, TEXT("bUsedWithSplineMeshes"), nullptr, true},
+			{MATUSAGE_InstancedStaticMeshes, TEXT("bUsedWithInstancedStaticMeshes"), nullptr, true},
+			{MATUSAGE_GeometryCollections, TEXT("bUsedWithGeometryCollections"), nullptr, true},
+			{MATUSAGE_GeometryCache, TEXT("bUsedWithGeometryCache"), nullptr, true},
+			{MATUSAGE_Water, TEXT("bUsedWithWater"), nullptr, true},
+			{MATUSAGE_HairStrands, TEXT("bUsedWithHairStrands"), nullptr, true},
+			{MATUSAGE_LidarPointCloud, TEXT("bUsedWithLidarPointCloud"), nullptr, true},
+			{MATUSAGE_VirtualHeightfieldMesh, TEXT("bUsedWithVirtualHeightfieldMesh"), nullptr, true},
+			{MATUSAGE_Nanite, TEXT("bUsedWithNanite"), nullptr, true}
+		};
+
+		return UsageFlagInfos;
+	}
+
+	// Blueprints and maps set materials on components; what those components render is not in the registry
+	bool IsOpaqueConsumer(const FAssetData& ReferencerAsset)
+	{
+		return ReferencerAsset.IsInstanceOf(UBlueprint::StaticClass()) || ReferencerAsset.IsInstanceOf(UWorld::StaticClass())
+			|| ReferencerAsset.PackageName.ToString().Contains(FPackagePath::GetExternalActorsFolderName());
+	}
+
+	// Game thread only, keyed on FMaterialPermutationInputs::CacheKey
+	TMap<uint64, FMaterialPermutationEstimate> EstimateCache;
+}
+
+FString SuperManagerMaterials::BuildInstanceFingerprint(const UMaterialInstanceConstant* MaterialInstance)
+{
+	check(MaterialInstance);
+
+	// Each line is one setting; sorting them makes the fingerprint independent of override order
+	TArray<FString> Lines;
+
+	for (const FScalarParameterValue& Scalar : MaterialInstance->ScalarParameterValues)
+	{
+		Lines.Add(FString::Printf(TEXT("Scalar %s=%.9g"), *DescribeParameterInfo(Scalar.ParameterInfo), Scalar.ParameterValue));
+	}
+
+	for (const FVectorParameterValue& Vector : MaterialInstance->VectorParameterValues)
+	{
+		Lines.Add(TEXT("Vector ") + DescribeParameterInfo(Vector.ParameterInfo) + TEXT("=") + Vector.ParameterValue.ToString());
+	}
+
+	for (const FDoubleVectorParameterValue& DoubleVector : MaterialInstance->DoubleVectorParameterValues)
+	{
+		Lines.Add(TEXT("DoubleVector ") + DescribeParameterInfo(DoubleVector.ParameterInfo) + TEXT("=") + DoubleVector.ParameterValue.ToString());
+	}
+
+	for (const FTextureParameterValue& Texture : MaterialInstance->TextureParameterValues)
+	{
+		Lines.Add(TEXT("Texture ") + DescribeParameterInfo(Texture.ParameterInfo) + TEXT("=") + DescribeObject(Texture.ParameterValue));
+	}
+
+	for (const FRuntimeVirtualTextureParameterValue& VirtualTexture : MaterialInstance->RuntimeVirtualTextureParameterValues)
+	{
+		Lines.Add(TEXT("VirtualTexture ") + DescribeParameterInfo(VirtualTexture.ParameterInfo) + TEXT("=") + DescribeObject(VirtualTexture.ParameterValue));
+	}
+
+	for (const FFontParameterValue& Font : MaterialInstance->FontParameterValues)
+	{
+		Lines.Add(FString::Printf(TEXT("Font %s=%s:%d"), *DescribeParameterInfo(Font.ParameterInfo), *DescribeObject(Font.FontValue), Font.FontPage));
+	}
+
+	// Physical materials, subsurface profile, lightmass settings and whatever else the instance classes declare
+	for (TFieldIterator<FProperty> It(MaterialInstance->GetClass()); It; ++It)
+	{
+		if (IsExcludedFromFingerprint(*It)) { continue; }
+
+		Lines.Add(TEXT("Property ") + It->GetName() + TEXT("=") + ExportPropertyValue(*It, MaterialInstance));
+	}
+
+	Lines.Sort();
+
+	return TEXT("Parent ") + DescribeObject(MaterialInstance->Parent) + TEXT("\n") + BuildStaticPermutationKey(MaterialInstance) + TEXT("\n") + FString::Join(Lines, TEXT("\n"));
+}
+
+FString SuperManagerMaterials::BuildStaticPermutationKey(const UMaterialInstanceConstant* MaterialInstance)
+{
+	check(MaterialInstance);
+
+	TArray<FString> Lines;
+
+	const FStaticParameterSet StaticParameters = MaterialInstance->GetStaticParameters();
+	for (const FStaticSwitchParameter& Switch : StaticParameters.StaticSwitchParameters)
+	{
+		if (Switch.bOverride == false) { continue; }
+		Lines.Add(TEXT("Switch ") + DescribeParameterInfo(Switch.ParameterInfo) + (Switch.Value ? TEXT("=1") : TEXT("=0")));
+	}
+
+	for (const FStaticComponentMaskParameter& Mask : StaticParameters.EditorOnly.StaticComponentMaskParameters)
+	{
+		if (Mask.bOverride == false) { continue; }
+		Lines.Add(FString::Printf(TEXT("Mask %s=%d%d%d%d"), *DescribeParameterInfo(Mask.ParameterInfo), Mask.R, Mask.G, Mask.B, Mask.A));
+	}
+
+	// Every bOverride_X that is set, with the value it guards; new overrides are picked up without touching this
+	const UScriptStruct* OverridesStruct = FMaterialInstanceBasePropertyOverrides::StaticStruct();
+	const void* Overrides = &MaterialInstance->BasePropertyOverrides;
+
+	for (TFieldIterator<FBoolProperty> It(OverridesStruct); It; ++It)
+	{
+		const FString FlagName = It->GetName();
+		if (FlagName.StartsWith(TEXT("bOverride_")) == false || It->GetPropertyValue_InContainer(Overrides) == false) { continue; }
+
+		const FString OverriddenName = FlagName.RightChop(10);
+		const FProperty* OverriddenProperty = OverridesStruct->FindPropertyByName(*OverriddenName);
+		if (OverriddenProperty == nullptr) { OverriddenProperty = OverridesStruct->FindPropertyByName(*(TEXT("b") + OverriddenName)); }
+
+		// A flag whose value cannot be paired falls back to the whole struct, so nothing overridden goes unhashed
+		FString Value;
+		if (OverriddenProperty) { Value = ExportPropertyValue(OverriddenProperty, Overrides); }
+		else { OverridesStruct->ExportText(Value, Overrides, nullptr, nullptr, PPF_None, nullptr); }
+
+		Lines.Add(TEXT("Override ") + OverriddenName + TEXT("=") + Value);
+	}
+
+	Lines.Sort();
+
+	return FString::Join(Lines, TEXT("\n"));
+}
+
+void SuperManagerMaterials::GroupRedundantInstances(const TArray<FAssetData>& InstancesData, TArray<TArray<FAssetData>>& OutRedundantGroups)
+{
+	OutRedundantGroups.Empty();
+
+	// Bucket on the 64 bit hash, then split buckets on the full fingerprint so a collision never merges different instances
+	TMap<uint64, TArray<TPair<FString, FAssetData>>> Buckets;
+
+	FSuperManagerBulkSettings Settings;
+	Settings.bSaveModifiedAssets = false;
+
+	// Only the fingerprints outlive a wave, so the instances are loaded and released in bulk
+	SuperManagerBulk::ProcessAssets(InstancesData, [&Buckets](UObject* LoadedAsset)
+		{
+			const UMaterialInstanceConstant* MaterialInstance = Cast<UMaterialInstanceConstant>(LoadedAsset);
+			if (MaterialInstance == nullptr) { return false; }
+
+			FString Fingerprint = BuildInstanceFingerprint(MaterialInstance);
+			const uint64 Hash = FXxHash64::HashBuffer(*Fingerprint, Fingerprint.Len() * sizeof(TCHAR)).Hash;
+
+			Buckets.FindOrAdd(Hash).Emplace(MoveTemp(Fingerprint), FAssetData(MaterialInstance));
+			return false;
+		},
+		Settings);
+
+	for (TPair<uint64, TArray<TPair<FString, FAssetData>>>& Bucket : Buckets)
+	{
+		if (Bucket.Value.Num() <= 1) { continue; }
+
+		TMap<FString, TArray<FAssetData>> Groups;
+		for (TPair<FString, FAssetData>& Instance : Bucket.Value)
+		{
+			Groups.FindOrAdd(Instance.Key).Add(Instance.Value);
+		}
+
+		for (TPair<FString, TArray<FAssetData>>& Group : Groups)
+		{
+			if (Group.Value.Num() <= 1) { continue; }
+
+			OutRedundantGroups.Add(MoveTemp(Group.Value));
+		}
+	}
+}
+
+void SuperManagerMaterials::GatherPermutationInputs(UMaterial* Material, FMaterialPermutationInputs& OutInputs)
+{
+	check(IsInGameThread());
+	check(Material);
+
+	OutInputs = FMaterialPermutationInputs();
+	OutInputs.MaterialPath = Material->GetPathName();
+	OutInputs.StateId = Material->StateId;
+
+	for (const TObjectPtr<UMaterialExpression>& Expression : Material->GetExpressions())
+	{
+		if (Expression && Expression->IsA<UMaterialExpressionQualitySwitch>())
+		{
+			OutInputs.bHasQualitySwitch = true;
+			break;
+		}
+	}
+
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	// Walk instances of instances; every non instance referencer along the way is a consumer of the material
+	TSet<FName> VisitedPackages;
+	TArray<FName> PackagesToVisit;
+	TSet<FTopLevelAssetPath> ConsumerClasses;
+	bool bHasOpaqueConsumers = false;
+
+	PackagesToVisit.Add(Material->GetOutermost()->GetFName());
+	VisitedPackages.Add(PackagesToVisit[0]);
+
+	while (PackagesToVisit.Num() > 0)
+	{
+		TArray<FName> Referencers;
+		AssetRegistry.GetReferencers(PackagesToVisit.Pop(false), Referencers);
+
+		for (const FName& Referencer : Referencers)
+		{
+			if (VisitedPackages.Contains(Referencer)) { continue; }
+			VisitedPackages.Add(Referencer);
+
+			TArray<FAssetData> ReferencerAssets;
+			AssetRegistry.GetAssetsByPackageName(Referencer, ReferencerAssets);
+
+			for (const FAssetData& ReferencerAsset : ReferencerAssets)
+			{
+				if (ReferencerAsset.IsInstanceOf(UMaterialInstanceConstant::StaticClass()) == false)
+				{
+					ConsumerClasses.Add(ReferencerAsset.AssetClassPath);
+					bHasOpaqueConsumers |= IsOpaqueConsumer(ReferencerAsset);
+					continue;
+				}
+
+				OutInputs.Instances.Add(ReferencerAsset);
+				PackagesToVisit.Add(Referencer);
+			}
+		}
+	}
+
+	for (const FUsageFlagInfo& UsageFlagInfo : GetUsageFlagInfos())
+	{
+		if (Material->GetUsageByFlag(UsageFlagInfo.Usage) == false) { continue; }
+
+		OutInputs.EnabledUsageFlags.Add(UsageFlagInfo.Name);
+		OutInputs.NumVertexFactoryUsages += UsageFlagInfo.bAddsVertexFactory ? 1 : 0;
+
+		// A Blueprint or map may put the material on any kind of component, so with one of those around nothing is clearable
+		if (bHasOpaqueConsumers || UsageFlagInfo.RequiredReferencerClass == nullptr) { continue; }
+
+		if (ConsumerClasses.Contains(UsageFlagInfo.RequiredReferencerClass->GetClassPathName()) == false)
+		{
+			OutInputs.ClearableUsageFlags.Add(UsageFlagInfo.Name);
+		}
+	}
+
+	// Saved package hashes stand in for the instances' static parameters; unsaved edits leave the key at zero
+	TArray<FString> InstanceStates;
+
+	for (const FAssetData& Instance : OutInputs.Instances)
+	{
+		const UPackage* LoadedPackage = FindPackage(nullptr, *Instance.PackageName.ToString());
+		const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(Instance.PackageName);
+
+		if ((LoadedPackage && LoadedPackage->IsDirty()) || PackageData.IsSet() == false) { return; }
+
+		InstanceStates.Add(Instance.PackageName.ToString() + TEXT("=") + LexToString(PackageData->GetPackageSavedHash()));
+	}
+
+	InstanceStates.Sort();
+
+	const FString Description = OutInputs.MaterialPath + OutInputs.StateId.ToString() + (OutInputs.bHasQualitySwitch ? TEXT("Q") : TEXT("-"))
+		+ FString::Join(OutInputs.EnabledUsageFlags, TEXT(",")) + TEXT("|") + FString::Join(OutInputs.ClearableUsageFlags, TEXT(",")) + TEXT("|") + FString::Join(InstanceStates, TEXT("|"));
+
+	OutInputs.CacheKey = FXxHash64::HashBuffer(*Description, Description.Len() * sizeof(TCHAR)).Hash;
+}
+
+void SuperManagerMaterials::EstimatePermutations(const TArray<FMaterialPermutationInputs>& Inputs, TArray<FMaterialPermutationEstimate>& OutEstimates)
+{
+	check(IsInGameThread());
+
+	OutEstimates.SetNum(Inputs.Num());
+
+	// Cached estimates need no instance loaded at all
+	TArray<int32> MissedInputs;
+	TArray<FAssetData> InstancesToLoad;
+	TSet<FSoftObjectPath> QueuedInstances;
+
+	for (int32 InputIndex = 0; InputIndex < Inputs.Num(); InputIndex++)
+	{
+		const FMaterialPermutationInputs& Input = Inputs[InputIndex];
+
+		if (const FMaterialPermutationEstimate* CachedEstimate = Input.CacheKey != 0 ? EstimateCache.Find(Input.CacheKey) : nullptr)
+		{
+			OutEstimates[InputIndex] = *CachedEstimate;
+			continue;
+		}
+
+		MissedInputs.Add(InputIndex);
+
+		for (const FAssetData& Instance : Input.Instances)
+		{
+			bool bAlreadyQueued = false;
+			QueuedInstances.Add(Instance.GetSoftObjectPath(), &bAlreadyQueued);
+
+			if (bAlreadyQueued == false)
+			{
+				InstancesToLoad.Add(Instance);
+			}
+		}
+	}
+
+	// An instance reaching several selected materials is loaded once, in waves the bulk pass unloads again
+	TMap<FSoftObjectPath, FString> StaticPermutationKeys;
+
+	FSuperManagerBulkSettings Settings;
+	Settings.bSaveModifiedAssets = false;
+
+	SuperManagerBulk::ProcessAssets(InstancesToLoad, [&StaticPermutationKeys](UObject* LoadedAsset)
+		{
+			if (const UMaterialInstanceConstant* MaterialInstance = Cast<UMaterialInstanceConstant>(LoadedAsset))
+			{
+				StaticPermutationKeys.Add(FSoftObjectPath(MaterialInstance), BuildStaticPermutationKey(MaterialInstance));
+			}
+
+			return false;
+		},
+		Settings);
+
+	// Past the loads only a few multiplications per material are left, not worth handing to workers
+	for (int32 InputIndex : MissedInputs)
+	{
+		const FMaterialPermutationInputs& Input = Inputs[InputIndex];
+
+		FMaterialPermutationEstimate& Estimate = OutEstimates[InputIndex];
+		Estimate.MaterialPath = Input.MaterialPath;
+		Estimate.ClearableUsageFlags = Input.ClearableUsageFlags;
+
+		// Instances without static overrides share the material's own shader map
+		TSet<FString> StaticPermutations;
+		StaticPermutations.Add(FString());
+		for (const FAssetData& Instance : Input.Instances)
+		{
+			if (const FString* Key = StaticPermutationKeys.Find(Instance.GetSoftObjectPath()))
+			{
+				StaticPermutations.Add(*Key);
+			}
+		}
+
+		Estimate.NumStaticPermutations = StaticPermutations.Num();
+		Estimate.NumVertexFactories = 1 + Input.NumVertexFactoryUsages;
+		Estimate.NumQualityLevels = Input.bHasQualitySwitch ? int32(EMaterialQualityLevel::Num) : 1;
+
+		Estimate.PredictedShaderCount = int64(Estimate.NumStaticPermutations) * Estimate.NumVertexFactories * Estimate.NumQualityLevels * ShadersPerVertexFactory;
+		Estimate.PredictedDDCBytes = Estimate.PredictedShaderCount * AverageShaderBytes;
+
+		if (Input.CacheKey == 0) { continue; }
+
+		EstimateCache.Add(Input.CacheKey, Estimate);
+	}
+
+	OutEstimates.Sort([](const FMaterialPermutationEstimate& A, const FMaterialPermutationEstimate& B) { return A.PredictedShaderCount > B.PredictedShaderCount; });
+}
@@ -0,0 +1,224 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/MeshSimilarity.h"
+#include "AssetAnalysis/BulkAssetProcessing.h"
+#include "AssetAnalysis/SimilarityGrouping.h"
+#include "DebugHeader.h"
+
+#include "Async/ParallelFor.h"
+#include "Engine/StaticMesh.h"
+#include "MeshDescription.h"
+#include "StaticMeshAttributes.h"
+
+namespace
+{
+	// Grid steps across the largest bounds axis: fine enough for exact matches, coarse enough to forgive re-import noise
+	constexpr float GeometryGridSteps = 4096.0f;
+	constexpr float ShapeGridSteps = 64.0f;
+
+	// How far counts and bounds of near identical meshes may drift apart
+	constexpr float MaxCountDifference = 0.05f;
+	constexpr float MaxBoundsDifference = 0.02f;
+
+	uint64 MixBits(uint64 Value)
+	{
+		// SplitMix64 finalizer, spreads nearby grid cells over the whole hash
+		Value ^= Value >> 30;
+		Value *= 0xbf58476d1ce4e5b9ull;
+		Value ^= Value >> 27;
+		Value *= 0x94d049bb133111ebull;
+		Value ^= Value >> 31;
+
+		return Value;
+	}
+
+	FIntVector Quantize(const FVector3f& Position, const FVector3f& BoundsMin, float CellSize)
+	{
+		const FVector3f Local = (Position - BoundsMin) / CellSize;
+
+		return FIntVector(FMath::RoundToInt(Local.X), FMath::RoundToInt(Local.Y), FMath::RoundToInt(Local.Z));
+	}
+
+	uint64 HashCell(const FIntVector& Cell)
+	{
+		return MixBits((uint64(uint32(Cell.X)) << 42) ^ (uint64(uint32(Cell.Y)) << 21) ^ uint64(uint32(Cell.Z)));
+	}
+
+	bool IsWithin(float A, float B, float Tolerance)
+	{
+		return FMath::Abs(A - B) <= Tolerance * FMath::Max3(FMath::Abs(A), FMath::Abs(B), 1.0f);
+	}
+}
+
+bool FSuperManagerMeshFingerprint::IsIdentical(const FSuperManagerMeshFingerprint& Other) const
+{
+	return GeometryHash == Other.GeometryHash && NumTriangles == Other.NumTriangles && NumMaterialSlots == Other.NumMaterialSlots;
+}
+
+bool FSuperManagerMeshFingerprint::IsNearIdentical(const FSuperManagerMeshFingerprint& Other) const
+{
+	if (IsIdentical(Other)) { return true; }
+
+	return NumMaterialSlots == Other.NumMaterialSlots
+		&& IsWithin(NumVertices, Other.NumVertices, MaxCountDifference)
+		&& IsWithin(NumTriangles, Other.NumTriangles, MaxCountDifference)
+		&& IsWithin(BoundsSize.X, Other.BoundsSize.X, MaxBoundsDifference)
+		&& IsWithin(BoundsSize.Y, Other.BoundsSize.Y, MaxBoundsDifference)
+		&& IsWithin(BoundsSize.Z, Other.BoundsSize.Z, MaxBoundsDifference)
+		&& SuperManagerSimilarity::HammingDistance(ShapeHash, Other.ShapeHash) <= SuperManagerMeshSimilarity::MaxShapeHashDistance;
+}
+
+bool SuperManagerMeshSimilarity::ComputeFingerprint(const FMeshDescription& MeshDescription, int32 NumMaterialSlots, FSuperManagerMeshFingerprint& OutFingerprint)
+{
+	FStaticMeshConstAttributes Attributes(MeshDescription);
+	TVertexAttributesConstRef<FVector3f> Positions = Attributes.GetVertexPositions();
+
+	if (MeshDescription.Vertices().Num() == 0 || MeshDescription.Triangles().Num() == 0) { return false; }
+
+	FBox3f Bounds(ForceInit);
+	for (const FVertexID VertexID : MeshDescription.Vertices().GetElementIDs())
+	{
+		Bounds += Positions[VertexID];
+	}
+
+	OutFingerprint.NumVertices = MeshDescription.Vertices().Num();
+	OutFingerprint.NumTriangles = MeshDescription.Triangles().Num();
+	OutFingerprint.NumMaterialSlots = NumMaterialSlots;
+	OutFingerprint.BoundsSize = Bounds.GetSize();
+
+	// Cells scale with the mesh, so a copy placed elsewhere in its own space still lands on the same grid
+	const float LargestAxis = FMath::Max(OutFingerprint.BoundsSize.GetMax(), UE_KINDA_SMALL_NUMBER);
+	const float GeometryCellSize = LargestAxis / GeometryGridSteps;
+	const float ShapeCellSize = LargestAxis / ShapeGridSteps;
+
+	// Summing per triangle hashes makes the result blind to triangle order; rotating each triangle to its
+	// smallest corner makes it blind to which corner was written first while keeping the winding
+	uint64 GeometryHash = 0;
+
+	for (const FTriangleID TriangleID : MeshDescription.Triangles().GetElementIDs())
+	{
+		TArrayView<const FVertexID> TriangleVertices = MeshDescription.GetTriangleVertices(TriangleID);
+
+		uint64 CornerHashes[3];
+		for (int32 Corner = 0; Corner < 3; Corner++)
+		{
+			CornerHashes[Corner] = HashCell(Quantize(Positions[TriangleVertices[Corner]], Bounds.Min, GeometryCellSize));
+		}
+
+		const int32 FirstCorner = CornerHashes[0] <= CornerHashes[1] ? (CornerHashes[0] <= CornerHashes[2] ? 0 : 2) : (CornerHashes[1] <= CornerHashes[2] ? 1 : 2);
+
+		uint64 TriangleHash = 0;
+		for (int32 Corner = 0; Corner < 3; Corner++)
+		{
+			TriangleHash = MixBits(TriangleHash ^ CornerHashes[(FirstCorner + Corner) % 3]);
+		}
+
+		GeometryHash += TriangleHash;
+	}
+
+	OutFingerprint.GeometryHash = MixBits(GeometryHash ^ uint64(NumMaterialSlots));
+
+	// SimHash: every coarse cell votes on every bit, shared cells keep the majority where it was
+	int32 BitVotes[64] = {};
+
+	for (const FVertexID VertexID : MeshDescription.Vertices().GetElementIDs())
+	{
+		const uint64 CellHash = HashCell(Quantize(Positions[VertexID], Bounds.Min, ShapeCellSize));
+
+		for (int32 Bit = 0; Bit < 64; Bit++)
+		{
+			BitVotes[Bit] += (CellHash >> Bit) & 1 ? 1 : -1;
+		}
+	}
+
+	OutFingerprint.ShapeHash = 0;
+	for (int32 Bit = 0; Bit < 64; Bit++)
+	{
+		if (BitVotes[Bit] > 0)
+		{
+			OutFingerprint.ShapeHash |= uint64(1) << Bit;
+		}
+	}
+
+	return true;
+}
+
+void SuperManagerMeshSimilarity::FingerprintStaticMeshes(const TArray<FAssetData>& MeshesData, TArray<TOptional<FSuperManagerMeshFingerprint>>& OutFingerprints)
+{
+	check(IsInGameThread());
+
+	OutFingerprints.Empty();
+	OutFingerprints.SetNum(MeshesData.Num());
+
+	TMap<FSoftObjectPath, int32> MeshIndices;
+	for (int32 MeshIndex = 0; MeshIndex < MeshesData.Num(); MeshIndex++)
+	{
+		MeshIndices.Add(MeshesData[MeshIndex].GetSoftObjectPath(), MeshIndex);
+	}
+
+	FSuperManagerBulkSettings Settings;
+	Settings.bSaveModifiedAssets = false;
+
+	SuperManagerBulk::ProcessWaves(MeshesData, [&OutFingerprints, &MeshIndices](const TArray<UObject*>& LoadedAssets, TArray<UObject*>& OutModifiedAssets)
+		{
+			TArray<const FMeshDescription*> MeshDescriptions;
+			TArray<int32> NumMaterialSlots;
+			TArray<int32> WaveMeshIndices;
+
+			// Mesh descriptions are pulled from bulk data on the game thread, only reading them is spread out
+			for (UObject* LoadedAsset : LoadedAssets)
+			{
+				UStaticMesh* StaticMesh = Cast<UStaticMesh>(LoadedAsset);
+				const int32* MeshIndex = MeshIndices.Find(FSoftObjectPath(LoadedAsset));
+				if (StaticMesh == nullptr || MeshIndex == nullptr) { continue; }
+
+				const FMeshDescription* MeshDescription = StaticMesh->GetMeshDescription(0);
+				if (MeshDescription == nullptr) { continue; }
+
+				MeshDescriptions.Add(MeshDescription);
+				NumMaterialSlots.Add(StaticMesh->GetStaticMaterials().Num());
+				WaveMeshIndices.Add(*MeshIndex);
+			}
+
+			ParallelFor(MeshDescriptions.Num(), [&](int32 WaveIndex)
+				{
+					FSuperManagerMeshFingerprint Fingerprint;
+					if (ComputeFingerprint(*MeshDescriptions[WaveIndex], NumMaterialSlots[WaveIndex], Fingerprint))
+					{
+						OutFingerprints[WaveMeshIndices[WaveIndex]] = Fingerprint;
+					}
+				});
+		},
+		Settings);
+}
+
+void SuperManagerMeshSimilarity::GroupSimilarMeshes(const TArray<TOptional<FSuperManagerMeshFingerprint>>& Fingerprints, TArray<TArray<int32>>& OutGroups)
+{
+	TArray<uint64> ShapeHashes;
+	TArray<int32> FingerprintIndices;
+
+	for (int32 FingerprintIndex = 0; FingerprintIndex < Fingerprints.Num(); FingerprintIndex++)
+	{
+		if (Fingerprints[FingerprintIndex].IsSet() == false) { continue; }
+
+		ShapeHashes.Add(Fingerprints[FingerprintIndex]->ShapeHash);
+		FingerprintIndices.Add(FingerprintIndex);
+	}
+
+	// The shape hash narrows the candidates down, the counts and bounds decide
+	SuperManagerSimilarity::GroupByHammingDistance(ShapeHashes, MaxShapeHashDistance,
+		[&Fingerprints, &FingerprintIndices](int32 A, int32 B)
+		{
+			return Fingerprints[FingerprintIndices[A]]->IsNearIdentical(Fingerprints[FingerprintIndices[B]].GetValue());
+		},
+		OutGroups);
+
+	for (TArray<int32>& Group : OutGroups)
+	{
+		for (int32& Member : Group)
+		{
+			Member = FingerprintIndices[Member];
+		}
+	}
+}
@@ -0,0 +1,241 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/NameSimilarity.h"
+
+namespace
+{
+	constexpr int32 GramSize = 3;
+
+	// Padding marks the ends of a name so its first and last characters get trigrams of their own
+	constexpr TCHAR StartPadding = TCHAR(1);
+	constexpr TCHAR EndPadding = TCHAR(2);
+
+	uint64 MakeGram(TCHAR A, TCHAR B, TCHAR C)
+	{
+		return (uint64(A) << 42) | (uint64(B) << 21) | uint64(C);
+	}
+
+	void GetDistinctGrams(const FString& Name, TArray<uint64>& OutGrams)
+	{
+		OutGrams.Reset();
+
+		const FString Padded = FString::ChrN(GramSize - 1, StartPadding) + Name + FString::ChrN(GramSize - 1, EndPadding);
+
+		for (int32 Index = 0; Index + GramSize <= Padded.Len(); Index++)
+		{
+			OutGrams.AddUnique(MakeGram(Padded[Index], Padded[Index + 1], Padded[Index + 2]));
+		}
+	}
+
+	bool RemoveNumericSuffix(FString& Name)
+	{
+		int32 DigitsStart = Name.Len();
+		while (DigitsStart > 0 && FChar::IsDigit(Name[DigitsStart - 1]))
+		{
+			DigitsStart--;
+		}
+
+		// A name made only of digits keeps them, there would be nothing left to compare
+		if (DigitsStart == Name.Len() || DigitsStart == 0) { return false; }
+
+		Name.LeftInline(Name[DigitsStart - 1] == TEXT('_') ? DigitsStart - 1 : DigitsStart);
+		return true;
+	}
+
+	int32 FindGroupRoot(TArray<int32>& Parents, int32 Item)
+	{
+		while (Parents[Item] != Item)
+		{
+			Parents[Item] = Parents[Parents[Item]];
+			Item = Parents[Item];
+		}
+
+		return Item;
+	}
+}
+
+FString SuperManagerNameSimilarity::NormalizeName(const FString& AssetName, const TArray<FString>& KnownPrefixes)
+{
+	FString Name = AssetName.ToLower();
+
+	// Longest prefix first, so MI_ wins over M_
+	int32 LongestPrefix = 0;
+	for (const FString& Prefix : KnownPrefixes)
+	{
+		if (Prefix.Len() > LongestPrefix && Name.StartsWith(Prefix, ESearchCase::IgnoreCase))
+		{
+			LongestPrefix = Prefix.Len();
+		}
+	}
+	Name.RightChopInline(LongestPrefix);
+
+	// Suffixes stack up: BP_Door_inst_2_1
+	bool bRemovedSuffix = true;
+	while (bRemovedSuffix)
+	{
+		bRemovedSuffix = Name.RemoveFromEnd(TEXT("_inst")) || RemoveNumericSuffix(Name);
+	}
+
+	Name.ReplaceInline(TEXT("_"), TEXT(""));
+	Name.ReplaceInline(TEXT("-"), TEXT(""));
+	Name.ReplaceInline(TEXT(" "), TEXT(""));
+
+	return Name;
+}
+
+int32 SuperManagerNameSimilarity::GetMaxEdits(int32 NameLength)
+{
+	if (NameLength >= 8) { return 2; }
+	if (NameLength >= 4) { return 1; }
+
+	return 0;
+}
+
+int32 SuperManagerNameSimilarity::EditDistance(const FString& A, const FString& B, int32 MaxDistance)
+{
+	if (FMath::Abs(A.Len() - B.Len()) > MaxDistance) { return MaxDistance + 1; }
+
+	TArray<int32, TInlineAllocator<64>> PreviousRow;
+	TArray<int32, TInlineAllocator<64>> CurrentRow;
+	PreviousRow.SetNumUninitialized(B.Len() + 1);
+	CurrentRow.SetNumUninitialized(B.Len() + 1);
+
+	for (int32 Column = 0; Column <= B.Len(); Column++)
+	{
+		PreviousRow[Column] = Column;
+	}
+
+	for (int32 Row = 1; Row <= A.Len(); Row++)
+	{
+		// Only cells within MaxDistance of the diagonal can stay under the limit
+		const int32 FirstColumn = FMath::Max(1, Row - MaxDistance);
+		const int32 LastColumn = FMath::Min(B.Len(), Row + MaxDistance);
+
+		CurrentRow[0] = Row;
+		if (FirstColumn > 1)
+		{
+			CurrentRow[FirstColumn - 1] = MaxDistance + 1;
+		}
+
+		int32 RowMinimum = FirstColumn > 1 ? MaxDistance + 1 : Row;
+
+		for (int32 Column = FirstColumn; Column <= LastColumn; Column++)
+		{
+			const int32 Substitution = PreviousRow[Column - 1] + (A[Row - 1] == B[Column - 1] ? 0 : 1);
+			const int32 Deletion = (Column < Row + MaxDistance ? PreviousRow[Column] : MaxDistance + 1) + 1;
+			const int32 Insertion = CurrentRow[Column - 1] + 1;
+
+			CurrentRow[Column] = FMath::Min3(Substitution, Deletion, Insertion);
+			RowMinimum = FMath::Min(RowMinimum, CurrentRow[Column]);
+		}
+
+		if (LastColumn < B.Len())
+		{
+			CurrentRow[LastColumn + 1] = MaxDistance + 1;
+		}
+
+		if (RowMinimum > MaxDistance) { return MaxDistance + 1; }
+
+		Swap(PreviousRow, CurrentRow);
+	}
+
+	return FMath::Min(PreviousRow[B.Len()], MaxDistance + 1);
+}
+
+void SuperManagerNameSimilarity::GroupSimilarNames(const TArray<FString>& NormalizedNames, TArray<TArray<int32>>& OutGroups)
+{
+	OutGroups.Empty();
+
+	// Exact matches after normalization are the common case; only distinct names go through the index
+	TArray<FString> DistinctNames;
+	TArray<int32> DistinctIndexOfName;
+	TMap<FString, int32> DistinctIndexByName;
+
+	for (const FString& Name : NormalizedNames)
+	{
+		int32& DistinctIndex = DistinctIndexByName.FindOrAdd(Name, INDEX_NONE);
+		if (DistinctIndex == INDEX_NONE)
+		{
+			DistinctIndex = DistinctNames.Add(Name);
+		}
+
+		DistinctIndexOfName.Add(DistinctIndex);
+	}
+
+	TArray<TArray<uint64>> NameGrams;
+	NameGrams.SetNum(DistinctNames.Num());
+	TMap<uint64, TArray<int32>> Postings;
+
+	for (int32 NameIndex = 0; NameIndex < DistinctNames.Num(); NameIndex++)
+	{
+		GetDistinctGrams(DistinctNames[NameIndex], NameGrams[NameIndex]);
+
+		for (uint64 Gram : NameGrams[NameIndex])
+		{
+			Postings.FindOrAdd(Gram).Add(NameIndex);
+		}
+	}
+
+	TArray<int32> Parents;
+	Parents.SetNumUninitialized(DistinctNames.Num());
+	for (int32 NameIndex = 0; NameIndex < DistinctNames.Num(); NameIndex++)
+	{
+		Parents[NameIndex] = NameIndex;
+	}
+
+	TArray<int32> LastProbedBy;
+	LastProbedBy.Init(INDEX_NONE, DistinctNames.Num());
+
+	for (int32 NameIndex = 0; NameIndex < DistinctNames.Num(); NameIndex++)
+	{
+		const FString& Name = DistinctNames[NameIndex];
+		const int32 MaxEdits = GetMaxEdits(Name.Len());
+
+		if (MaxEdits == 0) { continue; }
+
+		// Each edit destroys at most GramSize trigrams, so any match within MaxEdits shares one of the
+		// GramSize * MaxEdits + 1 rarest trigrams of this name; the common ones are never scanned
+		TArray<uint64>& Grams = NameGrams[NameIndex];
+		Grams.Sort([&Postings](uint64 A, uint64 B) { return Postings[A].Num() < Postings[B].Num(); });
+
+		const int32 NumProbedGrams = FMath::Min(Grams.Num(), GramSize * MaxEdits + 1);
+
+		for (int32 GramIndex = 0; GramIndex < NumProbedGrams; GramIndex++)
+		{
+			for (int32 Candidate : Postings[Grams[GramIndex]])
+			{
+				if (Candidate <= NameIndex || LastProbedBy[Candidate] == NameIndex) { continue; }
+
+				LastProbedBy[Candidate] = NameIndex;
+
+				const int32 PairMaxEdits = GetMaxEdits(FMath::Min(Name.Len(), DistinctNames[Candidate].Len()));
+				if (PairMaxEdits == 0) { continue; }
+
+				if (FindGroupRoot(Parents, NameIndex) == FindGroupRoot(Parents, Candidate)) { continue; }
+
+				if (EditDistance(Name, DistinctNames[Candidate], PairMaxEdits) > PairMaxEdits) { continue; }
+
+				Parents[FindGroupRoot(Parents, Candidate)] = FindGroupRoot(Parents, NameIndex);
+			}
+		}
+	}
+
+	TMap<int32, int32> GroupIndexByRoot;
+
+	for (int32 OriginalIndex = 0; OriginalIndex < NormalizedNames.Num(); OriginalIndex++)
+	{
+		int32& GroupIndex = GroupIndexByRoot.FindOrAdd(FindGroupRoot(Parents, DistinctIndexOfName[OriginalIndex]), INDEX_NONE);
+
+		if (GroupIndex == INDEX_NONE)
+		{
+			GroupIndex = OutGroups.AddDefaulted();
+		}
+
+		OutGroups[GroupIndex].Add(OriginalIndex);
+	}
+
+	OutGroups.RemoveAll([](const TArray<int32>& Group) { return Group.Num() < 2; });
+
+	OutGroups.StableSort([](const TArray<int32>& A, const TArray<int32>& B) { return A.Num() > B.Num(); });
+}
@@ -0,0 +1,211 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/NamingConvention.h"
+#include "AssetActions/QuickAssetAction.h"
+#include "DebugHeader.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetToolsModule.h"
+#include "EditorAssetLibrary.h"
+#include "Editor.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/CoreDelegates.h"
+#include "Subsystems/ImportSubsystem.h"
+
+namespace
+{
+	const TCHAR* NamingConfigSection = TEXT("SuperManager");
+	const TCHAR* NamingModeConfigKey = TEXT("NamingConventionMode");
+}
+
+FSuperManagerNamingConvention::~FSuperManagerNamingConvention()
+{
+	if (PendingAssetsHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(PendingAssetsHandle);
+		PendingAssetsHandle.Reset();
+	}
+}
+
+void FSuperManagerNamingConvention::Register()
+{
+	int32 SavedMode = int32(Mode);
+	GConfig->GetInt(NamingConfigSection, NamingModeConfigKey, SavedMode, GEditorPerProjectIni);
+	Mode = ESuperManagerNamingMode(FMath::Clamp(SavedMode, int32(ESuperManagerNamingMode::Off), int32(ESuperManagerNamingMode::Rename)));
+
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	// Fires for assets made in the editor only, unlike OnAssetAdded which also fires for every file the scan discovers
+	AssetRegistry.OnInMemoryAssetCreated().AddRaw(this, &FSuperManagerNamingConvention::OnInMemoryAssetCreated);
+
+	// The import subsystem comes up with the editor, after PreDefault modules are loaded
+	if (GEditor)
+	{
+		RegisterImportCallbacks();
+	}
+	else
+	{
+		FCoreDelegates::OnPostEngineInit.AddRaw(this, &FSuperManagerNamingConvention::RegisterImportCallbacks);
+	}
+}
+
+void FSuperManagerNamingConvention::Unregister()
+{
+	FCoreDelegates::OnPostEngineInit.RemoveAll(this);
+
+	if (FModuleManager::Get().IsModuleLoaded(TEXT("AssetRegistry")))
+	{
+		IAssetRegistry& AssetRegistry =
+			FModuleManager::GetModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+		AssetRegistry.OnInMemoryAssetCreated().RemoveAll(this);
+	}
+
+	if (GEditor)
+	{
+		if (UImportSubsystem* ImportSubsystem = GEditor->GetEditorSubsystem<UImportSubsystem>())
+		{
+			ImportSubsystem->OnAssetPostImport.RemoveAll(this);
+		}
+	}
+
+	if (PendingAssetsHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(PendingAssetsHandle);
+		PendingAssetsHandle.Reset();
+	}
+
+	PendingAssets.Empty();
+}
+
+void FSuperManagerNamingConvention::SetMode(ESuperManagerNamingMode NewMode)
+{
+	Mode = NewMode;
+
+	GConfig->SetInt(NamingConfigSection, NamingModeConfigKey, int32(Mode), GEditorPerProjectIni);
+}
+
+const FString& FSuperManagerNamingConvention::GetExpectedPrefix(const FTopLevelAssetPath& ClassPath)
+{
+	if (const FString* ResolvedPrefix = ResolvedPrefixes.Find(ClassPath))
+	{
+		return *ResolvedPrefix;
+	}
+
+	UClass* AssetClass = FindObject<UClass>(ClassPath);
+
+	// Not cached: the class may still be loaded later, a plugin's for instance
+	static const FString NoPrefix;
+	if (AssetClass == nullptr) { return NoPrefix; }
+
+	const TMap<UClass*, FString>& PrefixMap = UQuickAssetAction::GetPrefixMap();
+
+	FString Prefix;
+	for (UClass* Class = AssetClass; Class != nullptr; Class = Class->GetSuperClass())
+	{
+		if (const FString* MappedPrefix = PrefixMap.Find(Class))
+		{
+			Prefix = *MappedPrefix;
+			break;
+		}
+	}
+
+	return ResolvedPrefixes.Add(ClassPath, MoveTemp(Prefix));
+}
+
+void FSuperManagerNamingConvention::RegisterImportCallbacks()
+{
+	FCoreDelegates::OnPostEngineInit.RemoveAll(this);
+
+	if (GEditor == nullptr) { return; }
+
+	if (UImportSubsystem* ImportSubsystem = GEditor->GetEditorSubsystem<UImportSubsystem>())
+	{
+		ImportSubsystem->OnAssetPostImport.AddRaw(this, &FSuperManagerNamingConvention::OnAssetPostImport);
+	}
+}
+
+void FSuperManagerNamingConvention::OnInMemoryAssetCreated(UObject* Asset)
+{
+	QueueNewAsset(Asset);
+}
+
+void FSuperManagerNamingConvention::OnAssetPostImport(UFactory* Factory, UObject* Asset)
+{
+	QueueNewAsset(Asset);
+}
+
+void FSuperManagerNamingConvention::QueueNewAsset(UObject* Asset)
+{
+	if (Mode == ESuperManagerNamingMode::Off || IsRunningCommandlet()) { return; }
+
+	if (Asset == nullptr || Asset->IsAsset() == false) { return; }
+
+	// Reimports come through the import callback too; only a package that never existed on disk is new
+	if (Asset->GetPackage()->HasAnyPackageFlags(PKG_NewlyCreated) == false) { return; }
+
+	PendingAssets.AddUnique(Asset);
+
+	if (PendingAssetsHandle.IsValid()) { return; }
+
+	PendingAssetsHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateRaw(this, &FSuperManagerNamingConvention::OnPendingAssetsTick));
+}
+
+bool FSuperManagerNamingConvention::OnPendingAssetsTick(float DeltaTime)
+{
+	PendingAssetsHandle.Reset();
+
+	TArray<TWeakObjectPtr<UObject>> NewAssets = MoveTemp(PendingAssets);
+	PendingAssets.Reset();
+
+	TArray<FAssetRenameData> AssetsAndNames;
+	TArray<FString> MisnamedAssets;
+
+	for (const TWeakObjectPtr<UObject>& WeakAsset : NewAssets)
+	{
+		UObject* Asset = WeakAsset.Get();
+		if (Asset == nullptr) { continue; }
+
+		const FString& Prefix = GetExpectedPrefix(Asset->GetClass()->GetClassPathName());
+		if (Prefix.IsEmpty() || Asset->GetName().StartsWith(Prefix)) { continue; }
+
+		const FString PackagePath = FPackageName::GetLongPackagePath(Asset->GetPackage()->GetName());
+		const FString NewName = UQuickAssetAction::GetPrefixedName(Asset, Prefix);
+
+		// A taken name is left to the user rather than renamed into a clash
+		const bool bNameTaken = UEditorAssetLibrary::DoesAssetExist(PackagePath / NewName);
+
+		if (Mode == ESuperManagerNamingMode::Rename && bNameTaken == false)
+		{
+			AssetsAndNames.Add(FAssetRenameData(Asset, PackagePath, NewName));
+			continue;
+		}
+
+		MisnamedAssets.Add(Asset->GetPathName() + TEXT(" should be named ") + NewName);
+	}
+
+	if (AssetsAndNames.Num() > 0)
+	{
+		FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
+
+		if (AssetToolsModule.Get().RenameAssets(AssetsAndNames))
+		{
+			DebugHeader::ShowNotifyInfo(TEXT("Added the naming convention prefix to ") + FString::FromInt(AssetsAndNames.Num()) + TEXT(" new assets"));
+		}
+	}
+
+	if (MisnamedAssets.Num() > 0)
+	{
+		for (const FString& MisnamedAsset : MisnamedAssets)
+		{
+			DebugHeader::PrintLog(MisnamedAsset);
+		}
+
+		DebugHeader::ShowNotifyInfo(FString::FromInt(MisnamedAssets.Num()) + TEXT(" new assets are missing their prefix, see the log"));
+	}
+
+	return false;
+}
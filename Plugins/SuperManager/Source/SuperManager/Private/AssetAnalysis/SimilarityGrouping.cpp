@@ -0,0 +1,164 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/SimilarityGrouping.h"
+
+namespace
+{
+	struct FBKTreeNode
+	{
+		int32 Item;
+
+		/** Child subtree per distance to this node, few enough that a flat array beats a map */
+		TArray<TPair<int32, int32>, TInlineAllocator<4>> Children;
+	};
+
+	class FBKTree
+	{
+	public:
+		explicit FBKTree(TConstArrayView<uint64> InHashes)
+			: Hashes(InHashes)
+		{
+			Nodes.Reserve(Hashes.Num());
+		}
+
+		void Insert(int32 Item)
+		{
+			if (Nodes.Num() == 0)
+			{
+				Nodes.Add({ Item });
+				return;
+			}
+
+			int32 NodeIndex = 0;
+
+			while (true)
+			{
+				const int32 Distance = SuperManagerSimilarity::HammingDistance(Hashes[Item], Hashes[Nodes[NodeIndex].Item]);
+
+				const TPair<int32, int32>* Child = Nodes[NodeIndex].Children.FindByPredicate([Distance](const TPair<int32, int32>& Candidate) { return Candidate.Key == Distance; });
+
+				if (Child == nullptr)
+				{
+					const int32 NewNodeIndex = Nodes.Add({ Item });
+					Nodes[NodeIndex].Children.Emplace(Distance, NewNodeIndex);
+					return;
+				}
+
+				NodeIndex = Child->Value;
+			}
+		}
+
+		void FindWithin(int32 Item, int32 MaxDistance, TArray<int32>& OutItems) const
+		{
+			OutItems.Reset();
+
+			if (Nodes.Num() == 0) { return; }
+
+			TArray<int32, TInlineAllocator<64>> NodesToVisit;
+			NodesToVisit.Add(0);
+
+			while (NodesToVisit.Num() > 0)
+			{
+				const FBKTreeNode& Node = Nodes[NodesToVisit.Pop(false)];
+				const int32 Distance = SuperManagerSimilarity::HammingDistance(Hashes[Item], Hashes[Node.Item]);
+
+				if (Distance <= MaxDistance)
+				{
+					OutItems.Add(Node.Item);
+				}
+
+				// Triangle inequality: only subtrees whose edge distance is within MaxDistance of ours can hold a match
+				for (const TPair<int32, int32>& Child : Node.Children)
+				{
+					if (FMath::Abs(Child.Key - Distance) <= MaxDistance)
+					{
+						NodesToVisit.Add(Child.Value);
+					}
+				}
+			}
+		}
+
+	private:
+		TConstArrayView<uint64> Hashes;
+		TArray<FBKTreeNode> Nodes;
+	};
+
+	int32 FindGroupRoot(TArray<int32>& Parents, int32 Item)
+	{
+		while (Parents[Item] != Item)
+		{
+			Parents[Item] = Parents[Parents[Item]];
+			Item = Parents[Item];
+		}
+
+		return Item;
+	}
+}
+
+int32 SuperManagerSimilarity::HammingDistance(uint64 A, uint64 B)
+{
+	return int32(FMath::CountBits(A ^ B));
+}
+
+void SuperManagerSimilarity::GroupByHammingDistance(TConstArrayView<uint64> Hashes, int32 MaxDistance, TFunctionRef<bool(int32, int32)> ConfirmPair, TArray<TArray<int32>>& OutGroups)
+{
+	OutGroups.Empty();
+
+	FBKTree Tree(Hashes);
+
+	for (int32 Item = 0; Item < Hashes.Num(); Item++)
+	{
+		Tree.Insert(Item);
+	}
+
+	TArray<int32> Parents;
+	Parents.SetNumUninitialized(Hashes.Num());
+	for (int32 Item = 0; Item < Hashes.Num(); Item++)
+	{
+		Parents[Item] = Item;
+	}
+
+	TArray<int32> Matches;
+
+	for (int32 Item = 0; Item < Hashes.Num(); Item++)
+	{
+		Tree.FindWithin(Item, MaxDistance, Matches);
+
+		for (int32 Match : Matches)
+		{
+			// Every pair shows up from both ends, handling one of them is enough
+			if (Match <= Item) { continue; }
+
+			const int32 ItemRoot = FindGroupRoot(Parents, Item);
+			const int32 MatchRoot = FindGroupRoot(Parents, Match);
+
+			if (ItemRoot == MatchRoot || ConfirmPair(Item, Match) == false) { continue; }
+
+			Parents[MatchRoot] = ItemRoot;
+		}
+	}
+
+	TMap<int32, int32> GroupIndexByRoot;
+
+	for (int32 Item = 0; Item < Hashes.Num(); Item++)
+	{
+		int32& GroupIndex = GroupIndexByRoot.FindOrAdd(FindGroupRoot(Parents, Item), INDEX_NONE);
+
+		if (GroupIndex == INDEX_NONE)
+		{
+			GroupIndex = OutGroups.AddDefaulted();
+		}
+
+		OutGroups[GroupIndex].Add(Item);
+	}
+
+	OutGroups.RemoveAll([](const TArray<int32>& Group) { return Group.Num() < 2; });
+
+	OutGroups.StableSort([](const TArray<int32>& A, const TArray<int32>& B) { return A.Num() > B.Num(); });
+}
+
+void SuperManagerSimilarity::GroupByHammingDistance(TConstArrayView<uint64> Hashes, int32 MaxDistance, TArray<TArray<int32>>& OutGroups)
+{
+	GroupByHammingDistance(Hashes, MaxDistance, [](int32, int32) { return true; }, OutGroups);
+}
@@ -0,0 +1,73 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/SnapshotCommandlet.h"
+#include "AssetAnalysis/SnapshotFile.h"
+#include "DebugHeader.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Misc/FileHelper.h"
+
+USuperManagerSnapshotCommandlet::USuperManagerSnapshotCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 USuperManagerSnapshotCommandlet::Main(const FString& Params)
+{
+	FString ExportFilename;
+	if (FParse::Value(*Params, TEXT("Export="), ExportFilename))
+	{
+		return ExportSnapshot(ExportFilename);
+	}
+
+	FString BaseFilename;
+	FString CompareFilename;
+	if (FParse::Value(*Params, TEXT("Base="), BaseFilename) && FParse::Value(*Params, TEXT("Compare="), CompareFilename))
+	{
+		FString ReportFilename;
+		FParse::Value(*Params, TEXT("Report="), ReportFilename);
+
+		return CompareSnapshots(BaseFilename, CompareFilename, ReportFilename);
+	}
+
+	DebugHeader::PrintLog(TEXT("Usage: -run=SuperManagerSnapshot -Export=<file> | -Base=<file> -Compare=<file> [-Report=<csv>]"));
+
+	return 1;
+}
+
+int32 USuperManagerSnapshotCommandlet::ExportSnapshot(const FString& Filename)
+{
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	// Nothing has scanned the project this early in a commandlet
+	AssetRegistry.SearchAllAssets(true);
+
+	return FSuperManagerSnapshotFile::Write(*FSuperManagerAssetSnapshot::Capture(TArray<FString>()), Filename) ? 0 : 1;
+}
+
+int32 USuperManagerSnapshotCommandlet::CompareSnapshots(const FString& BaseFilename, const FString& CompareFilename, const FString& ReportFilename)
+{
+	FString Error;
+
+	TUniquePtr<FSuperManagerSnapshotFile> BaseFile = FSuperManagerSnapshotFile::Open(BaseFilename, Error);
+	TUniquePtr<FSuperManagerSnapshotFile> CompareFile = BaseFile.IsValid() ? FSuperManagerSnapshotFile::Open(CompareFilename, Error) : nullptr;
+
+	if (CompareFile.IsValid() == false)
+	{
+		DebugHeader::PrintLog(Error);
+		return 1;
+	}
+
+	const FSuperManagerSnapshotDiff Diff = FSuperManagerSnapshotDiff::Compare(*BaseFile, *CompareFile);
+
+	DebugHeader::PrintLog(Diff.Describe());
+
+	if (ReportFilename.IsEmpty()) { return 0; }
+
+	return FFileHelper::SaveStringToFile(Diff.ToCSV(), *ReportFilename) ? 0 : 1;
+}
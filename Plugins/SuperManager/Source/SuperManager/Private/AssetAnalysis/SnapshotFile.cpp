@@ -0,0 +1,414 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/SnapshotFile.h"
+#include "DebugHeader.h"
+
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+
+namespace
+{
+	// Byte order of UTF-8 is code point order, so both files sort the same way on any machine
+	int32 CompareNames(FUtf8StringView A, FUtf8StringView B)
+	{
+		const int32 CommonResult = FMemory::Memcmp(A.GetData(), B.GetData(), FMath::Min(A.Len(), B.Len()));
+
+		return CommonResult != 0 ? CommonResult : A.Len() - B.Len();
+	}
+
+	int64 Align(int64 Offset, int64 Alignment)
+	{
+		return (Offset + Alignment - 1) & ~(Alignment - 1);
+	}
+
+	struct FSectionLayout
+	{
+		int64 PackagesOffset;
+		int64 EdgeTargetsOffset;
+		int64 EdgeKindsOffset;
+		int64 NamesOffset;
+		int64 TotalSize;
+
+		FSectionLayout(uint32 NumPackages, uint32 NumEdges, uint64 NameBytes)
+		{
+			PackagesOffset = sizeof(FSuperManagerSnapshotFileHeader);
+			EdgeTargetsOffset = PackagesOffset + int64(NumPackages) * sizeof(FSuperManagerSnapshotFilePackage);
+			EdgeKindsOffset = EdgeTargetsOffset + int64(NumEdges) * sizeof(uint32);
+			NamesOffset = EdgeKindsOffset + int64(NumEdges);
+			TotalSize = Align(NamesOffset + int64(NameBytes), 8);
+		}
+	};
+
+	FSuperManagerSnapshotDiffEntry MakeEntry(FUtf8StringView Name, const FSuperManagerSnapshotFilePackage* OldPackage, const FSuperManagerSnapshotFilePackage* NewPackage)
+	{
+		FSuperManagerSnapshotDiffEntry Entry;
+		const FUTF8ToTCHAR TCHARName(reinterpret_cast<const ANSICHAR*>(Name.GetData()), Name.Len());
+		Entry.PackageName = FString(TCHARName.Length(), TCHARName.Get());
+
+		if (OldPackage)
+		{
+			Entry.OldDiskSize = OldPackage->DiskSize;
+			Entry.OldHardReferencers = OldPackage->NumHardReferencers;
+		}
+
+		if (NewPackage)
+		{
+			Entry.NewDiskSize = NewPackage->DiskSize;
+			Entry.NewHardReferencers = NewPackage->NumHardReferencers;
+		}
+
+		return Entry;
+	}
+}
+
+#pragma region Writing
+bool FSuperManagerSnapshotFile::Write(const FSuperManagerAssetSnapshot& Snapshot, const FString& Filename)
+{
+	const int32 NumPackages = Snapshot.NumPackages();
+
+	// Names are converted once into the blob they are written from, then sorted in place by view
+	TArray<UTF8CHAR> NameBlob;
+	TArray<int32> NameOffsets;
+	NameOffsets.Reserve(NumPackages + 1);
+
+	for (int32 PackageIndex = 0; PackageIndex < NumPackages; PackageIndex++)
+	{
+		NameOffsets.Add(NameBlob.Num());
+
+		const FTCHARToUTF8 Utf8Name(*Snapshot.GetPackageName(PackageIndex).ToString());
+		NameBlob.Append(reinterpret_cast<const UTF8CHAR*>(Utf8Name.Get()), Utf8Name.Length());
+	}
+	NameOffsets.Add(NameBlob.Num());
+
+	auto GetName = [&NameBlob, &NameOffsets](int32 PackageIndex)
+		{
+			return FUtf8StringView(NameBlob.GetData() + NameOffsets[PackageIndex], NameOffsets[PackageIndex + 1] - NameOffsets[PackageIndex]);
+		};
+
+	TArray<int32> SortedPackages;
+	SortedPackages.Reserve(NumPackages);
+	for (int32 PackageIndex = 0; PackageIndex < NumPackages; PackageIndex++)
+	{
+		SortedPackages.Add(PackageIndex);
+	}
+
+	SortedPackages.Sort([&GetName](int32 A, int32 B) { return CompareNames(GetName(A), GetName(B)) < 0; });
+
+	TArray<uint32> FileIndices;
+	FileIndices.SetNumUninitialized(NumPackages);
+	for (int32 FileIndex = 0; FileIndex < NumPackages; FileIndex++)
+	{
+		FileIndices[SortedPackages[FileIndex]] = FileIndex;
+	}
+
+	uint32 NumEdges = 0;
+	for (int32 PackageIndex = 0; PackageIndex < NumPackages; PackageIndex++)
+	{
+		NumEdges += Snapshot.GetDependencies(PackageIndex).Num();
+	}
+
+	const FSectionLayout Layout(NumPackages, NumEdges, NameBlob.Num());
+
+	TArray64<uint8> Bytes;
+	Bytes.SetNumZeroed(Layout.TotalSize);
+
+	FSuperManagerSnapshotFileHeader& Header = *reinterpret_cast<FSuperManagerSnapshotFileHeader*>(Bytes.GetData());
+	Header.Magic = FileMagic;
+	Header.Version = FileVersion;
+	Header.NumPackages = NumPackages;
+	Header.NumEdges = NumEdges;
+	Header.NameBytes = NameBlob.Num();
+
+	FSuperManagerSnapshotFilePackage* FilePackages = reinterpret_cast<FSuperManagerSnapshotFilePackage*>(Bytes.GetData() + Layout.PackagesOffset);
+	uint32* FileEdgeTargets = reinterpret_cast<uint32*>(Bytes.GetData() + Layout.EdgeTargetsOffset);
+	ESuperManagerDependencyKind* FileEdgeKinds = reinterpret_cast<ESuperManagerDependencyKind*>(Bytes.GetData() + Layout.EdgeKindsOffset);
+	UTF8CHAR* FileNames = reinterpret_cast<UTF8CHAR*>(Bytes.GetData() + Layout.NamesOffset);
+
+	uint32 EdgeCursor = 0;
+	uint64 NameCursor = 0;
+
+	for (int32 FileIndex = 0; FileIndex < NumPackages; FileIndex++)
+	{
+		const int32 PackageIndex = SortedPackages[FileIndex];
+		const FUtf8StringView Name = GetName(PackageIndex);
+		FSuperManagerSnapshotFilePackage& FilePackage = FilePackages[FileIndex];
+
+		FilePackage.DiskSize = Snapshot.GetPackageDiskSize(PackageIndex);
+		FilePackage.NameOffset = NameCursor;
+		FilePackage.NameLength = Name.Len();
+		FMemory::Memcpy(FilePackage.Hash, Snapshot.GetPackageHash(PackageIndex).GetBytes(), sizeof(FilePackage.Hash));
+
+		FMemory::Memcpy(FileNames + NameCursor, Name.GetData(), Name.Len());
+		NameCursor += Name.Len();
+
+		for (ESuperManagerDependencyKind ReferencerKind : Snapshot.GetReferencerKinds(PackageIndex))
+		{
+			if (EnumHasAnyFlags(ReferencerKind, ESuperManagerDependencyKind::Package)) { FilePackage.NumReferencers++; }
+			if (EnumHasAnyFlags(ReferencerKind, ESuperManagerDependencyKind::Hard)) { FilePackage.NumHardReferencers++; }
+		}
+
+		const bool bInGame = Name.StartsWith(UTF8TEXTVIEW("/Game/"));
+		const bool bRoot = Snapshot.IsRootPackage(PackageIndex);
+
+		FilePackage.Flags =
+			(bRoot ? FSuperManagerSnapshotFilePackage::Root : 0) |
+			(bInGame ? FSuperManagerSnapshotFilePackage::InGame : 0) |
+			(FilePackage.NumReferencers == 0 && bRoot == false ? FSuperManagerSnapshotFilePackage::Unused : 0);
+
+		const TConstArrayView<int32> Dependencies = Snapshot.GetDependencies(PackageIndex);
+		const TConstArrayView<ESuperManagerDependencyKind> DependencyKinds = Snapshot.GetDependencyKinds(PackageIndex);
+
+		FilePackage.FirstEdge = EdgeCursor;
+		FilePackage.NumEdges = Dependencies.Num();
+
+		for (int32 EdgeIndex = 0; EdgeIndex < Dependencies.Num(); EdgeIndex++)
+		{
+			FileEdgeTargets[EdgeCursor] = FileIndices[Dependencies[EdgeIndex]];
+			FileEdgeKinds[EdgeCursor] = DependencyKinds[EdgeIndex];
+			EdgeCursor++;
+		}
+	}
+
+	if (FFileHelper::SaveArrayToFile(Bytes, *Filename) == false)
+	{
+		DebugHeader::PrintLog(TEXT("Failed to write snapshot to ") + Filename);
+		return false;
+	}
+
+	DebugHeader::PrintLog(FString::Printf(TEXT("Wrote snapshot of %d packages and %u edges (%lld bytes) to %s"), NumPackages, NumEdges, Bytes.Num(), *Filename));
+
+	return true;
+}
+#pragma endregion
+
+#pragma region Reading
+TUniquePtr<FSuperManagerSnapshotFile> FSuperManagerSnapshotFile::Open(const FString& Filename, FString& OutError)
+{
+	TUniquePtr<FSuperManagerSnapshotFile> File(new FSuperManagerSnapshotFile());
+
+	File->MappedHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Filename));
+
+	if (File->MappedHandle.IsValid() && File->MappedHandle->GetFileSize() > 0)
+	{
+		File->MappedRegion.Reset(File->MappedHandle->MapRegion(0, File->MappedHandle->GetFileSize()));
+	}
+
+	if (File->MappedRegion.IsValid())
+	{
+		File->Data = File->MappedRegion->GetMappedPtr();
+		File->DataSize = File->MappedRegion->GetMappedSize();
+	}
+	else
+	{
+		// Platforms or file systems without mapping still get the same in place access
+		if (FFileHelper::LoadFileToArray(File->LoadedBytes, *Filename) == false)
+		{
+			OutError = TEXT("Cannot read ") + Filename;
+			return nullptr;
+		}
+
+		File->Data = File->LoadedBytes.GetData();
+		File->DataSize = File->LoadedBytes.Num();
+	}
+
+	if (File->Validate(OutError) == false)
+	{
+		OutError = Filename + TEXT(": ") + OutError;
+		return nullptr;
+	}
+
+	return File;
+}
+
+FSuperManagerSnapshotFile::~FSuperManagerSnapshotFile()
+{
+	// The region has to go before the handle it was mapped from
+	MappedRegion.Reset();
+	MappedHandle.Reset();
+}
+
+bool FSuperManagerSnapshotFile::Validate(FString& OutError)
+{
+	if (DataSize < int64(sizeof(FSuperManagerSnapshotFileHeader)))
+	{
+		OutError = TEXT("file is too small to be a snapshot");
+		return false;
+	}
+
+	Header = reinterpret_cast<const FSuperManagerSnapshotFileHeader*>(Data);
+
+	if (Header->Magic != FileMagic)
+	{
+		OutError = TEXT("not a SuperManager snapshot");
+		return false;
+	}
+
+	if (Header->Version != FileVersion)
+	{
+		OutError = FString::Printf(TEXT("snapshot version %u, expected %u"), Header->Version, FileVersion);
+		return false;
+	}
+
+	const FSectionLayout Layout(Header->NumPackages, Header->NumEdges, Header->NameBytes);
+
+	if (Header->NumPackages > uint32(MAX_int32) || Header->NameBytes > uint64(DataSize) || DataSize < Layout.TotalSize)
+	{
+		OutError = TEXT("snapshot is truncated");
+		return false;
+	}
+
+	Packages = reinterpret_cast<const FSuperManagerSnapshotFilePackage*>(Data + Layout.PackagesOffset);
+	EdgeTargets = reinterpret_cast<const uint32*>(Data + Layout.EdgeTargetsOffset);
+	EdgeKinds = reinterpret_cast<const ESuperManagerDependencyKind*>(Data + Layout.EdgeKindsOffset);
+	Names = reinterpret_cast<const UTF8CHAR*>(Data + Layout.NamesOffset);
+
+	// Checked once here so the accessors and the diff can index without bounds checks
+	for (uint32 PackageIndex = 0; PackageIndex < Header->NumPackages; PackageIndex++)
+	{
+		const FSuperManagerSnapshotFilePackage& Package = Packages[PackageIndex];
+
+		const bool bNameInRange = Package.NameOffset + Package.NameLength <= Header->NameBytes;
+		const bool bEdgesInRange = uint64(Package.FirstEdge) + Package.NumEdges <= Header->NumEdges;
+
+		if (bNameInRange == false || bEdgesInRange == false)
+		{
+			OutError = FString::Printf(TEXT("package %u points outside of the file"), PackageIndex);
+			return false;
+		}
+
+		if (PackageIndex > 0 && CompareNames(GetPackageName(PackageIndex - 1), GetPackageName(PackageIndex)) >= 0)
+		{
+			OutError = TEXT("package table is not sorted");
+			return false;
+		}
+	}
+
+	for (uint32 EdgeIndex = 0; EdgeIndex < Header->NumEdges; EdgeIndex++)
+	{
+		if (EdgeTargets[EdgeIndex] >= Header->NumPackages)
+		{
+			OutError = FString::Printf(TEXT("edge %u points outside of the package table"), EdgeIndex);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+FUtf8StringView FSuperManagerSnapshotFile::GetPackageName(int32 PackageIndex) const
+{
+	return FUtf8StringView(Names + Packages[PackageIndex].NameOffset, Packages[PackageIndex].NameLength);
+}
+
+TConstArrayView<uint32> FSuperManagerSnapshotFile::GetDependencies(int32 PackageIndex) const
+{
+	return TConstArrayView<uint32>(EdgeTargets + Packages[PackageIndex].FirstEdge, Packages[PackageIndex].NumEdges);
+}
+
+TConstArrayView<ESuperManagerDependencyKind> FSuperManagerSnapshotFile::GetDependencyKinds(int32 PackageIndex) const
+{
+	return TConstArrayView<ESuperManagerDependencyKind>(EdgeKinds + Packages[PackageIndex].FirstEdge, Packages[PackageIndex].NumEdges);
+}
+#pragma endregion
+
+#pragma region Diff
+FSuperManagerSnapshotDiff FSuperManagerSnapshotDiff::Compare(const FSuperManagerSnapshotFile& OldFile, const FSuperManagerSnapshotFile& NewFile)
+{
+	FSuperManagerSnapshotDiff Diff;
+
+	int32 OldIndex = 0;
+	int32 NewIndex = 0;
+
+	auto IsGamePackage = [](const FSuperManagerSnapshotFilePackage& Package) { return (Package.Flags & FSuperManagerSnapshotFilePackage::InGame) != 0; };
+
+	while (OldIndex < OldFile.NumPackages() || NewIndex < NewFile.NumPackages())
+	{
+		const bool bHasOld = OldIndex < OldFile.NumPackages();
+		const bool bHasNew = NewIndex < NewFile.NumPackages();
+
+		const int32 Order = bHasOld && bHasNew ? CompareNames(OldFile.GetPackageName(OldIndex), NewFile.GetPackageName(NewIndex)) : (bHasOld ? -1 : 1);
+
+		const FSuperManagerSnapshotFilePackage* OldPackage = Order <= 0 ? &OldFile.GetPackage(OldIndex) : nullptr;
+		const FSuperManagerSnapshotFilePackage* NewPackage = Order >= 0 ? &NewFile.GetPackage(NewIndex) : nullptr;
+		const FUtf8StringView Name = OldPackage ? OldFile.GetPackageName(OldIndex) : NewFile.GetPackageName(NewIndex);
+
+		OldIndex += OldPackage ? 1 : 0;
+		NewIndex += NewPackage ? 1 : 0;
+
+		// Engine and plugin packages only come along as referencers, they are not what a content merge changes
+		if (IsGamePackage(OldPackage ? *OldPackage : *NewPackage) == false) { continue; }
+
+		Diff.OldTotalSize += OldPackage ? OldPackage->DiskSize : 0;
+		Diff.NewTotalSize += NewPackage ? NewPackage->DiskSize : 0;
+
+		if (OldPackage == nullptr)
+		{
+			Diff.Added.Add(MakeEntry(Name, OldPackage, NewPackage));
+			continue;
+		}
+
+		if (NewPackage == nullptr)
+		{
+			Diff.Removed.Add(MakeEntry(Name, OldPackage, NewPackage));
+			continue;
+		}
+
+		const bool bWasUnused = (OldPackage->Flags & FSuperManagerSnapshotFilePackage::Unused) != 0;
+		const bool bIsUnused = (NewPackage->Flags & FSuperManagerSnapshotFilePackage::Unused) != 0;
+
+		if (bIsUnused && bWasUnused == false)
+		{
+			Diff.NewlyUnused.Add(MakeEntry(Name, OldPackage, NewPackage));
+		}
+
+		if (NewPackage->NumHardReferencers > OldPackage->NumHardReferencers)
+		{
+			Diff.GainedHardReferences.Add(MakeEntry(Name, OldPackage, NewPackage));
+		}
+
+		if (NewPackage->DiskSize != OldPackage->DiskSize)
+		{
+			Diff.SizeChanged.Add(MakeEntry(Name, OldPackage, NewPackage));
+		}
+	}
+
+	// Biggest growth first, that is what a reviewer looks for
+	Diff.SizeChanged.Sort([](const FSuperManagerSnapshotDiffEntry& A, const FSuperManagerSnapshotDiffEntry& B)
+		{
+			return A.NewDiskSize - A.OldDiskSize > B.NewDiskSize - B.OldDiskSize;
+		});
+
+	return Diff;
+}
+
+FString FSuperManagerSnapshotDiff::Describe() const
+{
+	return FString::Printf(TEXT("%d added, %d removed, %d newly unused, %d gained hard references, %d changed size, /Game %+.2f MB"),
+		Added.Num(), Removed.Num(), NewlyUnused.Num(), GainedHardReferences.Num(), SizeChanged.Num(), (NewTotalSize - OldTotalSize) / (1024.0 * 1024.0));
+}
+
+FString FSuperManagerSnapshotDiff::ToCSV() const
+{
+	TArray<FString> Lines;
+	Lines.Add(TEXT("Change,Package,OldSize,NewSize,SizeDelta,OldHardReferencers,NewHardReferencers"));
+
+	auto AddLines = [&Lines](const TCHAR* Change, const TArray<FSuperManagerSnapshotDiffEntry>& Entries)
+		{
+			for (const FSuperManagerSnapshotDiffEntry& Entry : Entries)
+			{
+				Lines.Add(FString::Printf(TEXT("%s,%s,%lld,%lld,%lld,%d,%d"), Change, *Entry.PackageName,
+					Entry.OldDiskSize, Entry.NewDiskSize, Entry.NewDiskSize - Entry.OldDiskSize, Entry.OldHardReferencers, Entry.NewHardReferencers));
+			}
+		};
+
+	AddLines(TEXT("Added"), Added);
+	AddLines(TEXT("Removed"), Removed);
+	AddLines(TEXT("NewlyUnused"), NewlyUnused);
+	AddLines(TEXT("GainedHardReferences"), GainedHardReferences);
+	AddLines(TEXT("SizeChanged"), SizeChanged);
+
+	return FString::Join(Lines, TEXT("\n"));
+}
+#pragma endregion
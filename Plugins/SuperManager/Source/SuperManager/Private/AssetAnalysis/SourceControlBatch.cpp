@@ -0,0 +1,190 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/SourceControlBatch.h"
+#include "DebugHeader.h"
+
+#include "ObjectTools.h"
+#include "ISourceControlModule.h"
+#include "ISourceControlProvider.h"
+#include "SourceControlOperations.h"
+#include "SourceControlHelpers.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "HAL/FileManager.h"
+
+namespace
+{
+	int32 NumProviderCalls = 0;
+
+	ISourceControlProvider& GetProvider()
+	{
+		return ISourceControlModule::Get().GetProvider();
+	}
+
+	bool Execute(const FSourceControlOperationRef& Operation, const TArray<FString>& Filenames)
+	{
+		NumProviderCalls++;
+
+		if (GetProvider().Execute(Operation, Filenames) == ECommandResult::Succeeded) { return true; }
+
+		DebugHeader::PrintLog(TEXT("Source control ") + Operation->GetName().ToString() + TEXT(" failed for ") + FString::FromInt(Filenames.Num()) + TEXT(" files"));
+		return false;
+	}
+
+	// States come from the cache UpdateStatus just filled, so this costs no provider round trip
+	void FilterByState(const TArray<FString>& Filenames, TFunctionRef<bool(const ISourceControlState&)> Predicate, TArray<FString>& OutFilenames)
+	{
+		OutFilenames.Empty();
+
+		TArray<FSourceControlStateRef> States;
+		GetProvider().GetState(Filenames, States, EStateCacheUsage::Use);
+
+		for (const FSourceControlStateRef& State : States)
+		{
+			if (Predicate(*State))
+			{
+				OutFilenames.Add(State->GetFilename());
+			}
+		}
+	}
+
+	int32 ExecuteForState(const FSourceControlOperationRef& Operation, const TArray<FString>& Filenames, TFunctionRef<bool(const ISourceControlState&)> Predicate)
+	{
+		if (Filenames.Num() == 0 || SuperManagerSourceControl::IsAvailable() == false) { return 0; }
+
+		SuperManagerSourceControl::UpdateStatus(Filenames);
+
+		TArray<FString> FilesToProcess;
+		FilterByState(Filenames, Predicate, FilesToProcess);
+
+		if (FilesToProcess.Num() == 0) { return 0; }
+
+		return Execute(Operation, FilesToProcess) ? FilesToProcess.Num() : 0;
+	}
+
+	void GetAssetPackageNames(const TArray<FAssetData>& AssetsData, TArray<FName>& OutPackageNames)
+	{
+		OutPackageNames.Empty();
+
+		for (const FAssetData& AssetData : AssetsData)
+		{
+			OutPackageNames.AddUnique(AssetData.PackageName);
+		}
+	}
+}
+
+bool SuperManagerSourceControl::IsAvailable()
+{
+	return ISourceControlModule::Get().IsEnabled() && GetProvider().IsAvailable();
+}
+
+void SuperManagerSourceControl::GetPackageFilenames(const TArray<FName>& PackageNames, TArray<FString>& OutFilenames)
+{
+	TArray<FString> PackageNameStrings;
+
+	for (const FName& PackageName : PackageNames)
+	{
+		PackageNameStrings.Add(PackageName.ToString());
+	}
+
+	OutFilenames = SourceControlHelpers::PackageFilenames(PackageNameStrings);
+}
+
+bool SuperManagerSourceControl::UpdateStatus(const TArray<FString>& Filenames)
+{
+	if (Filenames.Num() == 0 || IsAvailable() == false) { return false; }
+
+	return Execute(ISourceControlOperation::Create<FUpdateStatus>(), Filenames);
+}
+
+int32 SuperManagerSourceControl::CheckOut(const TArray<FString>& Filenames)
+{
+	return ExecuteForState(ISourceControlOperation::Create<FCheckOut>(), Filenames, [](const ISourceControlState& State)
+		{
+			return State.CanCheckout();
+		});
+}
+
+int32 SuperManagerSourceControl::MarkForAdd(const TArray<FString>& Filenames)
+{
+	return ExecuteForState(ISourceControlOperation::Create<FMarkForAdd>(), Filenames, [](const ISourceControlState& State)
+		{
+			return State.IsSourceControlled() == false && State.CanAdd();
+		});
+}
+
+int32 SuperManagerSourceControl::MarkForDelete(const TArray<FString>& Filenames)
+{
+	return ExecuteForState(ISourceControlOperation::Create<FDelete>(), Filenames, [](const ISourceControlState& State)
+		{
+			return State.IsSourceControlled() && State.IsAdded() == false && State.IsDeleted() == false;
+		});
+}
+
+int32 SuperManagerSourceControl::DeleteAssets(const TArray<FAssetData>& AssetsDataToDelete)
+{
+	if (AssetsDataToDelete.Num() == 0) { return 0; }
+
+	TArray<FName> PackageNames;
+	GetAssetPackageNames(AssetsDataToDelete, PackageNames);
+
+	TArray<FString> Filenames;
+	GetPackageFilenames(PackageNames, Filenames);
+
+	UpdateStatus(Filenames);
+
+	const int32 NumOfAssetsDeleted = ObjectTools::DeleteAssets(AssetsDataToDelete);
+
+	if (NumOfAssetsDeleted == 0) { return 0; }
+
+	// Anything gone from disk but still tracked gets deleted in the provider together
+	TArray<FString> DeletedFilenames;
+
+	for (const FString& Filename : Filenames)
+	{
+		if (IFileManager::Get().FileExists(*Filename)) { continue; }
+
+		DeletedFilenames.Add(Filename);
+	}
+
+	MarkForDelete(DeletedFilenames);
+
+	return NumOfAssetsDeleted;
+}
+
+void SuperManagerSourceControl::PrepareForRename(const TArray<FAssetData>& AssetsDataToRename)
+{
+	if (AssetsDataToRename.Num() == 0 || IsAvailable() == false) { return; }
+
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	TArray<FName> PackageNames;
+	GetAssetPackageNames(AssetsDataToRename, PackageNames);
+
+	// Renaming resaves every referencer, so they are checked out with the assets themselves
+	const int32 NumRenamedPackages = PackageNames.Num();
+
+	for (int32 PackageIndex = 0; PackageIndex < NumRenamedPackages; PackageIndex++)
+	{
+		TArray<FName> Referencers;
+		AssetRegistry.GetReferencers(PackageNames[PackageIndex], Referencers);
+
+		for (const FName& Referencer : Referencers)
+		{
+			if (FPackageName::IsScriptPackage(Referencer.ToString())) { continue; }
+
+			PackageNames.AddUnique(Referencer);
+		}
+	}
+
+	TArray<FString> Filenames;
+	GetPackageFilenames(PackageNames, Filenames);
+
+	CheckOut(Filenames);
+}
+
+int32 SuperManagerSourceControl::GetNumProviderCalls()
+{
+	return NumProviderCalls;
+}
@@ -0,0 +1,122 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/StaticMeshAudit.h"
+#include "AssetAnalysis/BulkAssetProcessing.h"
+#include "Engine/StaticMesh.h"
+
+namespace
+{
+	FString GetTagString(const FAssetData& AssetData, const TCHAR* TagName)
+	{
+		FString TagValue;
+		AssetData.GetTagValue(FName(TagName), TagValue);
+
+		return TagValue;
+	}
+
+	// Lets Modifier touch each loaded mesh of a wave, builds the changed ones together and hands them back for saving
+	int32 ProcessMeshesInWaves(const TArray<FAssetData>& MeshesData, int32 WaveSize, TFunctionRef<bool(UStaticMesh*)> Modifier)
+	{
+		FSuperManagerBulkSettings Settings;
+		Settings.WaveSize = WaveSize;
+
+		const FSuperManagerBulkStats Stats = SuperManagerBulk::ProcessWaves(MeshesData, [Modifier](const TArray<UObject*>& LoadedAssets, TArray<UObject*>& OutModifiedAssets)
+			{
+				TArray<UStaticMesh*> ChangedMeshes;
+
+				for (UObject* LoadedAsset : LoadedAssets)
+				{
+					UStaticMesh* StaticMesh = Cast<UStaticMesh>(LoadedAsset);
+					if (StaticMesh == nullptr) { continue; }
+
+					const bool bWasDirty = StaticMesh->GetPackage()->IsDirty();
+					StaticMesh->Modify();
+
+					if (Modifier(StaticMesh))
+					{
+						ChangedMeshes.Add(StaticMesh);
+					}
+					else if (bWasDirty == false)
+					{
+						// Untouched meshes must stay clean or they could never be unloaded
+						StaticMesh->GetPackage()->SetDirtyFlag(false);
+					}
+				}
+
+				if (ChangedMeshes.Num() == 0) { return; }
+
+				// Builds every mesh of the wave on worker threads
+				UStaticMesh::BatchBuild(ChangedMeshes);
+
+				OutModifiedAssets.Append(ChangedMeshes);
+			},
+			Settings);
+
+		return Stats.NumModified;
+	}
+}
+
+bool SuperManagerMeshAudit::AuditStaticMesh(const FAssetData& MeshAssetData, FStaticMeshAuditEntry& OutEntry)
+{
+	if (MeshAssetData.IsInstanceOf(UStaticMesh::StaticClass()) == false) { return false; }
+
+	OutEntry.AssetData = MeshAssetData;
+	OutEntry.NumTriangles = FCString::Atoi(*GetTagString(MeshAssetData, TEXT("Triangles")));
+	OutEntry.NumVertices = FCString::Atoi(*GetTagString(MeshAssetData, TEXT("Vertices")));
+	OutEntry.NumLODs = FCString::Atoi(*GetTagString(MeshAssetData, TEXT("LODs")));
+	OutEntry.bNaniteEnabled = GetTagString(MeshAssetData, TEXT("NaniteEnabled")).ToBool();
+	OutEntry.CollisionComplexity = GetTagString(MeshAssetData, TEXT("CollisionComplexity"));
+
+	return true;
+}
+
+void SuperManagerMeshAudit::AuditStaticMeshes(const TArray<FAssetData>& AssetsData, TArray<TSharedPtr<FStaticMeshAuditEntry>>& OutEntries)
+{
+	OutEntries.Empty();
+
+	for (const FAssetData& AssetData : AssetsData)
+	{
+		TSharedPtr<FStaticMeshAuditEntry> Entry = MakeShared<FStaticMeshAuditEntry>();
+		if (AuditStaticMesh(AssetData, *Entry) == false) { continue; }
+
+		OutEntries.Add(Entry);
+	}
+
+	// Most expensive meshes first
+	OutEntries.Sort([](const TSharedPtr<FStaticMeshAuditEntry>& A, const TSharedPtr<FStaticMeshAuditEntry>& B) { return A->NumTriangles > B->NumTriangles; });
+}
+
+int32 SuperManagerMeshAudit::EnableNanite(const TArray<FAssetData>& MeshesData, int32 WaveSize)
+{
+	return ProcessMeshesInWaves(MeshesData, WaveSize, [](UStaticMesh* StaticMesh)
+		{
+			if (StaticMesh->NaniteSettings.bEnabled) { return false; }
+
+			StaticMesh->NaniteSettings.bEnabled = true;
+			return true;
+		});
+}
+
+int32 SuperManagerMeshAudit::GenerateLODs(const TArray<FAssetData>& MeshesData, int32 NumLODs, int32 WaveSize)
+{
+	if (NumLODs <= 1) { return 0; }
+
+	return ProcessMeshesInWaves(MeshesData, WaveSize, [NumLODs](UStaticMesh* StaticMesh)
+		{
+			// Leave hand authored LOD chains alone
+			if (StaticMesh->GetNumSourceModels() > 1) { return false; }
+
+			StaticMesh->SetNumSourceModels(NumLODs);
+			StaticMesh->bAutoComputeLODScreenSize = true;
+
+			for (int32 LODIndex = 1; LODIndex < NumLODs; LODIndex++)
+			{
+				FStaticMeshSourceModel& SourceModel = StaticMesh->GetSourceModel(LODIndex);
+				SourceModel.ReductionSettings.PercentTriangles = FMath::Pow(0.5f, float(LODIndex));
+				SourceModel.ReductionSettings.PercentVertices = SourceModel.ReductionSettings.PercentTriangles;
+			}
+
+			return true;
+		});
+}
@@ -0,0 +1,378 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/TextureSimilarity.h"
+#include "AssetAnalysis/BulkAssetProcessing.h"
+#include "DebugHeader.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "Engine/Texture.h"
+#include "ImageCore.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	constexpr int32 DctSize = 32;
+	constexpr int32 DctKept = 8;
+	constexpr int32 DifferenceWidth = 9;
+	constexpr int32 DifferenceHeight = 8;
+
+	// Rows converted to float at a time; keeps the working set small whatever the texture size
+	constexpr int32 StripRows = 64;
+
+	// Source art is big, fewer textures per wave keeps the parallel decode inside the memory budget
+	constexpr int32 TextureWaveSize = 8;
+
+	/** Cosine basis of the first DctKept frequencies over DctSize samples */
+	struct FDctBasis
+	{
+		alignas(16) float Cosines[DctKept][DctSize];
+
+		FDctBasis()
+		{
+			for (int32 Frequency = 0; Frequency < DctKept; Frequency++)
+			{
+				for (int32 Sample = 0; Sample < DctSize; Sample++)
+				{
+					Cosines[Frequency][Sample] = FMath::Cos((2 * Sample + 1) * Frequency * PI / (2 * DctSize));
+				}
+			}
+		}
+	};
+
+	float SumComponents(const VectorRegister4Float& Vector)
+	{
+		alignas(16) float Components[4];
+		VectorStoreAligned(Vector, Components);
+
+		return Components[0] + Components[1] + Components[2] + Components[3];
+	}
+
+	// Dot product of two rows of DctSize floats, four lanes at a time
+	float DotRow(const float* A, const float* B)
+	{
+		VectorRegister4Float Accumulator = VectorZeroFloat();
+
+		for (int32 Sample = 0; Sample < DctSize; Sample += 4)
+		{
+			Accumulator = VectorMultiplyAdd(VectorLoadAligned(A + Sample), VectorLoadAligned(B + Sample), Accumulator);
+		}
+
+		return SumComponents(Accumulator);
+	}
+
+	/** Box filters the image into both thumbnails in one pass, accumulating weighted RGBA per bin as vectors */
+	void ReduceToThumbnails(const FImage& SourceImage, float* OutDctThumbnail, float* OutDifferenceThumbnail)
+	{
+		const int32 Width = SourceImage.SizeX;
+		const int32 Height = SourceImage.SizeY;
+		const int64 SourceRowBytes = int64(Width) * ERawImageFormat::GetBytesPerPixel(SourceImage.Format);
+
+		// Rec. 709 luminance, alpha ignored
+		const VectorRegister4Float LuminanceWeights = MakeVectorRegisterFloat(0.2126f, 0.7152f, 0.0722f, 0.0f);
+
+		TArray<VectorRegister4Float> DctBins;
+		TArray<VectorRegister4Float> DifferenceBins;
+		DctBins.Init(VectorZeroFloat(), DctSize * DctSize);
+		DifferenceBins.Init(VectorZeroFloat(), DifferenceWidth * DifferenceHeight);
+
+		TArray<int32> DctColumns;
+		TArray<int32> DifferenceColumns;
+		DctColumns.SetNumUninitialized(Width);
+		DifferenceColumns.SetNumUninitialized(Width);
+
+		for (int32 X = 0; X < Width; X++)
+		{
+			DctColumns[X] = int32(int64(X) * DctSize / Width);
+			DifferenceColumns[X] = int32(int64(X) * DifferenceWidth / Width);
+		}
+
+		TArray64<FLinearColor> Strip;
+		Strip.SetNumUninitialized(int64(Width) * FMath::Min(StripRows, Height));
+
+		for (int32 StripStart = 0; StripStart < Height; StripStart += StripRows)
+		{
+			const int32 NumRows = FMath::Min(StripRows, Height - StripStart);
+
+			const FImageView SourceStrip(const_cast<uint8*>(SourceImage.RawData.GetData()) + StripStart * SourceRowBytes, Width, NumRows, 1, SourceImage.Format, SourceImage.GammaSpace);
+			const FImageView FloatStrip(Strip.GetData(), Width, NumRows, 1, ERawImageFormat::RGBA32F, EGammaSpace::Linear);
+
+			FImageCore::CopyImage(SourceStrip, FloatStrip);
+
+			for (int32 Row = 0; Row < NumRows; Row++)
+			{
+				const int32 Y = StripStart + Row;
+				VectorRegister4Float* DctRow = DctBins.GetData() + int32(int64(Y) * DctSize / Height) * DctSize;
+				VectorRegister4Float* DifferenceRow = DifferenceBins.GetData() + int32(int64(Y) * DifferenceHeight / Height) * DifferenceWidth;
+				const float* Pixels = reinterpret_cast<const float*>(Strip.GetData() + int64(Row) * Width);
+
+				for (int32 X = 0; X < Width; X++)
+				{
+					const VectorRegister4Float Pixel = VectorMultiply(VectorLoad(Pixels + X * 4), LuminanceWeights);
+
+					DctRow[DctColumns[X]] = VectorAdd(DctRow[DctColumns[X]], Pixel);
+					DifferenceRow[DifferenceColumns[X]] = VectorAdd(DifferenceRow[DifferenceColumns[X]], Pixel);
+				}
+			}
+		}
+
+		// Bin sums become averages so textures of different resolutions land on the same scale
+		auto Collapse = [Width, Height](const TArray<VectorRegister4Float>& Bins, int32 BinsX, int32 BinsY, float* OutThumbnail)
+			{
+				for (int32 BinY = 0; BinY < BinsY; BinY++)
+				{
+					const int32 RowsInBin = int32(FMath::DivideAndRoundUp(int64(BinY + 1) * Height, int64(BinsY)) - FMath::DivideAndRoundUp(int64(BinY) * Height, int64(BinsY)));
+
+					for (int32 BinX = 0; BinX < BinsX; BinX++)
+					{
+						const int32 ColumnsInBin = int32(FMath::DivideAndRoundUp(int64(BinX + 1) * Width, int64(BinsX)) - FMath::DivideAndRoundUp(int64(BinX) * Width, int64(BinsX)));
+
+						OutThumbnail[BinY * BinsX + BinX] = SumComponents(Bins[BinY * BinsX + BinX]) / FMath::Max(RowsInBin * ColumnsInBin, 1);
+					}
+				}
+			};
+
+		Collapse(DctBins, DctSize, DctSize, OutDctThumbnail);
+		Collapse(DifferenceBins, DifferenceWidth, DifferenceHeight, OutDifferenceThumbnail);
+	}
+
+	uint64 ComputePerceptualHash(const float* Thumbnail)
+	{
+		static const FDctBasis Basis;
+
+		// Separable DCT-II, only the DctKept lowest frequencies of each axis are ever needed
+		alignas(16) float RowCoefficients[DctKept][DctSize];
+
+		for (int32 Y = 0; Y < DctSize; Y++)
+		{
+			for (int32 Frequency = 0; Frequency < DctKept; Frequency++)
+			{
+				RowCoefficients[Frequency][Y] = DotRow(Basis.Cosines[Frequency], Thumbnail + Y * DctSize);
+			}
+		}
+
+		float Coefficients[DctKept * DctKept];
+
+		for (int32 FrequencyY = 0; FrequencyY < DctKept; FrequencyY++)
+		{
+			for (int32 FrequencyX = 0; FrequencyX < DctKept; FrequencyX++)
+			{
+				Coefficients[FrequencyY * DctKept + FrequencyX] = DotRow(Basis.Cosines[FrequencyY], RowCoefficients[FrequencyX]);
+			}
+		}
+
+		// The DC term only says how bright the texture is, the median is taken over the rest
+		TArray<float, TInlineAllocator<DctKept * DctKept>> AcCoefficients(Coefficients + 1, DctKept * DctKept - 1);
+		AcCoefficients.Sort();
+		const float Median = AcCoefficients[AcCoefficients.Num() / 2];
+
+		uint64 Hash = 0;
+
+		for (int32 Index = 1; Index < DctKept * DctKept; Index++)
+		{
+			if (Coefficients[Index] > Median)
+			{
+				Hash |= uint64(1) << Index;
+			}
+		}
+
+		return Hash;
+	}
+
+	uint64 ComputeDifferenceHash(const float* Thumbnail)
+	{
+		uint64 Hash = 0;
+		int32 Bit = 0;
+
+		for (int32 Y = 0; Y < DifferenceHeight; Y++)
+		{
+			for (int32 X = 0; X < DifferenceWidth - 1; X++, Bit++)
+			{
+				if (Thumbnail[Y * DifferenceWidth + X] < Thumbnail[Y * DifferenceWidth + X + 1])
+				{
+					Hash |= uint64(1) << Bit;
+				}
+			}
+		}
+
+		return Hash;
+	}
+}
+
+bool SuperManagerTextureSimilarity::ComputeHash(FTextureSource& Source, FSuperManagerTextureHash& OutHash)
+{
+	if (Source.IsValid() == false) { return false; }
+
+	FImage SourceImage;
+	if (Source.GetMipImage(SourceImage, 0, 0, 0) == false) { return false; }
+
+	// Below the thumbnail size some bins stay empty and the hash says nothing; icons and masks are not worth it
+	if (SourceImage.SizeX < DctSize || SourceImage.SizeY < DctSize) { return false; }
+
+	alignas(16) float DctThumbnail[DctSize * DctSize];
+	float DifferenceThumbnail[DifferenceWidth * DifferenceHeight];
+
+	ReduceToThumbnails(SourceImage, DctThumbnail, DifferenceThumbnail);
+
+	OutHash.PerceptualHash = ComputePerceptualHash(DctThumbnail);
+	OutHash.DifferenceHash = ComputeDifferenceHash(DifferenceThumbnail);
+
+	return true;
+}
+
+#pragma region Cache
+void FSuperManagerTextureHashCache::HashTextures(const TArray<FAssetData>& TexturesData, TArray<TOptional<FSuperManagerTextureHash>>& OutHashes)
+{
+	check(IsInGameThread());
+
+	LoadFromDisk();
+
+	OutHashes.Empty();
+	OutHashes.SetNum(TexturesData.Num());
+
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	TArray<FIoHash> PackageHashes;
+	PackageHashes.Init(FIoHash::Zero, TexturesData.Num());
+
+	TArray<FAssetData> TexturesToLoad;
+	TMap<FSoftObjectPath, int32> TextureIndices;
+
+	for (int32 TextureIndex = 0; TextureIndex < TexturesData.Num(); TextureIndex++)
+	{
+		TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(TexturesData[TextureIndex].PackageName);
+		if (PackageData.IsSet())
+		{
+			PackageHashes[TextureIndex] = PackageData->GetPackageSavedHash();
+		}
+
+		const FGuid* SourceId = PackageHashes[TextureIndex].IsZero() ? nullptr : SourceIdsByPackageHash.Find(PackageHashes[TextureIndex]);
+		const FSuperManagerTextureHash* CachedHash = SourceId ? HashesBySourceId.Find(*SourceId) : nullptr;
+
+		if (CachedHash)
+		{
+			OutHashes[TextureIndex] = *CachedHash;
+			continue;
+		}
+
+		TexturesToLoad.Add(TexturesData[TextureIndex]);
+		TextureIndices.Add(TexturesData[TextureIndex].GetSoftObjectPath(), TextureIndex);
+	}
+
+	const int32 NumCached = TexturesData.Num() - TexturesToLoad.Num();
+	int32 NumComputed = 0;
+
+	FSuperManagerBulkSettings Settings;
+	Settings.WaveSize = TextureWaveSize;
+	Settings.bSaveModifiedAssets = false;
+
+	SuperManagerBulk::ProcessWaves(TexturesToLoad, [this, &OutHashes, &PackageHashes, &TextureIndices, &NumComputed](const TArray<UObject*>& LoadedAssets, TArray<UObject*>& OutModifiedAssets)
+		{
+			TArray<UTexture*> TexturesToHash;
+			TArray<int32> TexturesToHashIndices;
+
+			for (UObject* LoadedAsset : LoadedAssets)
+			{
+				UTexture* Texture = Cast<UTexture>(LoadedAsset);
+				const int32* TextureIndex = TextureIndices.Find(FSoftObjectPath(LoadedAsset));
+				if (Texture == nullptr || TextureIndex == nullptr) { continue; }
+
+				const FGuid SourceId = Texture->Source.GetId();
+
+				if (PackageHashes[*TextureIndex].IsZero() == false)
+				{
+					SourceIdsByPackageHash.Add(PackageHashes[*TextureIndex], SourceId);
+				}
+
+				// Same art under another package or with other compression settings: loaded, but never decoded again
+				if (const FSuperManagerTextureHash* CachedHash = HashesBySourceId.Find(SourceId))
+				{
+					OutHashes[*TextureIndex] = *CachedHash;
+					continue;
+				}
+
+				TexturesToHash.Add(Texture);
+				TexturesToHashIndices.Add(*TextureIndex);
+			}
+
+			TArray<TOptional<FSuperManagerTextureHash>> WaveHashes;
+			WaveHashes.SetNum(TexturesToHash.Num());
+
+			// Each task only reads the source of its own texture, which the wave keeps loaded
+			ParallelFor(TexturesToHash.Num(), [&TexturesToHash, &WaveHashes](int32 WaveIndex)
+				{
+					FSuperManagerTextureHash Hash;
+					if (SuperManagerTextureSimilarity::ComputeHash(TexturesToHash[WaveIndex]->Source, Hash))
+					{
+						WaveHashes[WaveIndex] = Hash;
+					}
+				});
+
+			for (int32 WaveIndex = 0; WaveIndex < TexturesToHash.Num(); WaveIndex++)
+			{
+				if (WaveHashes[WaveIndex].IsSet() == false) { continue; }
+
+				HashesBySourceId.Add(TexturesToHash[WaveIndex]->Source.GetId(), WaveHashes[WaveIndex].GetValue());
+				OutHashes[TexturesToHashIndices[WaveIndex]] = WaveHashes[WaveIndex];
+				NumComputed++;
+			}
+		},
+		Settings);
+
+	DebugHeader::PrintLog(FString::Printf(TEXT("Texture hashes: %d from cache, %d loaded, %d decoded"), NumCached, TexturesToLoad.Num(), NumComputed));
+
+	if (TexturesToLoad.Num() > 0)
+	{
+		SaveToDisk();
+	}
+}
+
+void FSuperManagerTextureHashCache::LoadFromDisk()
+{
+	if (bLoadedFromDisk) { return; }
+
+	bLoadedFromDisk = true;
+
+	TArray<uint8> Bytes;
+	if (FFileHelper::LoadFileToArray(Bytes, *GetCacheFilename(), FILEREAD_Silent) == false) { return; }
+
+	FMemoryReader Reader(Bytes);
+
+	uint32 Version = 0;
+	Reader << Version;
+
+	// An old layout is simply rebuilt
+	if (Version != CacheVersion) { return; }
+
+	Reader << SourceIdsByPackageHash;
+	Reader << HashesBySourceId;
+
+	if (Reader.IsError())
+	{
+		SourceIdsByPackageHash.Empty();
+		HashesBySourceId.Empty();
+	}
+}
+
+void FSuperManagerTextureHashCache::SaveToDisk()
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+
+	uint32 Version = CacheVersion;
+	Writer << Version;
+	Writer << SourceIdsByPackageHash;
+	Writer << HashesBySourceId;
+
+	FFileHelper::SaveArrayToFile(Bytes, *GetCacheFilename());
+}
+
+FString FSuperManagerTextureHashCache::GetCacheFilename()
+{
+	return FPaths::ProjectSavedDir() / TEXT("SuperManager") / TEXT("TextureHashes.bin");
+}
+#pragma endregion
@@ -5,11 +5,24 @@
 #include "SlateBasics.h"
 #include "DebugHeader.h"
 #include "SuperManager.h"
+#include "SlateWidgets/ResultsPanelWidget.h"
+#include "AssetAnalysis/AssetQuery.h"
 #include "../../../../../../../Plugins/Editor/EditorScriptingUtilities/Source/EditorScriptingUtilities/Public/EditorAssetLibrary.h"
 
 #define ListALL TEXT("List All Available Assets")
 #define ListUnused TEXT("List Unused Assets")
 #define ListSameName TEXT("List Assets With Same Name")
+#define ListUnusedIgnoringSoft TEXT("List Unused Assets Ignoring Soft References")
+#define ListManagementOnly TEXT("List Assets Only Referenced By Management")
+#define ListLookalikeTextures TEXT("List Similar Textures")
+#define ListLookalikeStaticMeshes TEXT("List Similar Static Meshes")
+#define ListLookalikeNames TEXT("List Assets With Similar Names")
+
+// Saved queries show up in the options behind this prefix
+#define SavedQueryPrefix TEXT("Query: ")
+
+// Shortest chains shown when an asset is asked why it is referenced
+static constexpr int32 MaxReferenceChains = 3;
 
 void SAdvancedDeletionWidget::Construct(const FArguments& InArgs)
 {
@@ -23,8 +36,23 @@ void SAdvancedDeletionWidget::Construct(const FArguments& InArgs)
 	ComboBoxSourceItems.Add(MakeShared<FString>(ListALL));
 	ComboBoxSourceItems.Add(MakeShared<FString>(ListUnused));
 	ComboBoxSourceItems.Add(MakeShared<FString>(ListSameName));
+	ComboBoxSourceItems.Add(MakeShared<FString>(ListUnusedIgnoringSoft));
+	ComboBoxSourceItems.Add(MakeShared<FString>(ListManagementOnly));
+	ComboBoxSourceItems.Add(MakeShared<FString>(ListLookalikeTextures));
+	ComboBoxSourceItems.Add(MakeShared<FString>(ListLookalikeStaticMeshes));
+	ComboBoxSourceItems.Add(MakeShared<FString>(ListLookalikeNames));
+
+	TArray<FString> SavedQueries;
+	FSuperManagerAssetQuery::LoadSavedQueries(SavedQueries);
+
+	for (const FString& SavedQuery : SavedQueries)
+	{
+		ComboBoxSourceItems.Add(MakeShared<FString>(SavedQueryPrefix + SavedQuery));
+	}
 
 	AssetsDataUnderSelectedFolder = InArgs._AssetsDataArray;
+	CurrentSelectedFolder = InArgs._CurrentSelectedFolder;
+	InvalidateAssetSnapshot();
 	DisplayedAssetsData = AssetsDataUnderSelectedFolder;
 
 	FSlateFontInfo TitleTextFont = GetEmbossedTextFont(30.f);
@@ -70,6 +98,25 @@ void SAdvancedDeletionWidget::Construct(const FArguments& InArgs)
 						]
 				]
 
+				// query to list the assets by, run on enter
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				[
+					SNew(SHorizontalBox)
+
+						+ SHorizontalBox::Slot()
+						.FillWidth(1.f)
+						[
+							ConstructQueryTextBox()
+						]
+
+						+ SHorizontalBox::Slot()
+						.AutoWidth()
+						[
+							ConstructSaveQueryButton()
+						]
+				]
+
 				// assets list
 				+ SVerticalBox::Slot()
 				.VAlign(VAlign_Fill)
@@ -94,6 +141,11 @@ void SAdvancedDeletionWidget::Construct(const FArguments& InArgs)
 							ConstructDeleteAllButton()
 						]
 
+						+ SHorizontalBox::Slot()
+						[
+							ConstructConsolidateButton()
+						]
+
 						+ SHorizontalBox::Slot()
 						[
 							ConstructSelectAllButton()
@@ -121,7 +173,7 @@ TSharedRef<SListView <TSharedPtr<FAssetData>>> SAdvancedDeletionWidget::Construc
 
 TSharedRef<SComboBox<TSharedPtr<FString>>> SAdvancedDeletionWidget::ConstructComboBox()
 {
-	TSharedRef<SComboBox<TSharedPtr<FString>>> ConstructedComboBox = SNew(SComboBox < TSharedPtr<FString>>)
+	ConstructedComboBox = SNew(SComboBox < TSharedPtr<FString>>)
 		.OptionsSource(&ComboBoxSourceItems)
 		.OnGenerateWidget(this, &SAdvancedDeletionWidget::OnGenerateComboBoxWidget)
 		.OnSelectionChanged(this, &SAdvancedDeletionWidget::OnComboBoxSelectionChanged)
@@ -130,7 +182,7 @@ TSharedRef<SComboBox<TSharedPtr<FString>>> SAdvancedDeletionWidget::ConstructCom
 				.Text(FText::FromString(TEXT("List Assets Option")))
 		];
 
-	return ConstructedComboBox;
+	return ConstructedComboBox.ToSharedRef();
 }
 
 TSharedRef<SCheckBox> SAdvancedDeletionWidget::ConstructCheckBox(const TSharedPtr<FAssetData>& AssetDataToDisplay)
@@ -167,6 +219,37 @@ TSharedRef<SButton> SAdvancedDeletionWidget::ConstructButton(const TSharedPtr<FA
 	return ConstructedButton;
 }
 
+TSharedRef<SButton> SAdvancedDeletionWidget::ConstructWhyReferencedButton(const TSharedPtr<FAssetData>& AssetDataToDisplay)
+{
+	TSharedRef<SButton> ConstructedButton = SNew(SButton)
+		.Text(FText::FromString("Why Referenced?"))
+		.ToolTipText(FText::FromString("Show the shortest chains from a map, primary asset or code reference to this asset"))
+		.OnClicked(this, &SAdvancedDeletionWidget::OnWhyReferencedButtonClicked, AssetDataToDisplay);
+
+	return ConstructedButton;
+}
+
+TSharedRef<SEditableTextBox> SAdvancedDeletionWidget::ConstructQueryTextBox()
+{
+	QueryTextBox = SNew(SEditableTextBox)
+		.HintText(FText::FromString(TEXT("class:Texture2D size>4MB unused path:/Game/Env -path:/Game/Dev")))
+		.ToolTipText(FText::FromString(TEXT("Terms: class:, path:, name:, size (<, >, = with B/KB/MB/GB), refs (<, >, =), unused. A leading - negates a term")))
+		.OnTextCommitted(this, &SAdvancedDeletionWidget::OnQueryTextCommitted);
+
+	return QueryTextBox.ToSharedRef();
+}
+
+TSharedRef<SButton> SAdvancedDeletionWidget::ConstructSaveQueryButton()
+{
+	TSharedRef<SButton> ConstructedButton = SNew(SButton)
+		.ToolTipText(FText::FromString(TEXT("Keep this query in the listing options")))
+		.OnClicked(this, &SAdvancedDeletionWidget::OnSaveQueryButtonClicked);
+
+	ConstructedButton->SetContent(ConstructTextBlock(TEXT("Save Query"), GetEmbossedTextFont(), FColor::White, ETextJustify::Center));
+
+	return ConstructedButton;
+}
+
 TSharedRef<SButton> SAdvancedDeletionWidget::ConstructDeleteAllButton()
 {
 	TSharedRef<SButton> ConstructedButton = SNew(SButton)
@@ -177,6 +260,17 @@ TSharedRef<SButton> SAdvancedDeletionWidget::ConstructDeleteAllButton()
 	return ConstructedButton;
 }
 
+TSharedRef<SButton> SAdvancedDeletionWidget::ConstructConsolidateButton()
+{
+	TSharedRef<SButton> ConstructedButton = SNew(SButton)
+		.ToolTipText(FText::FromString(TEXT("Point every reference to the ticked assets at the selected row, then delete them")))
+		.OnClicked(this, &SAdvancedDeletionWidget::OnConsolidateButtonClicked);
+
+	ConstructedButton->SetContent(ConstructTextBlock(TEXT("Consolidate Into Selected"), GetEmbossedTextFont(), FColor::White, ETextJustify::Center));
+
+	return ConstructedButton;
+}
+
 TSharedRef<SButton> SAdvancedDeletionWidget::ConstructSelectAllButton()
 {
 	TSharedRef<SButton> ConstructedButton = SNew(SButton)
@@ -244,10 +338,19 @@ TSharedRef<ITableRow> SAdvancedDeletionWidget::OnGenerateRowForList(TSharedPtr<F
 					ConstructTextBlock(DisplayAssetName, EmbossedTextFont)
 				]
 
+				// why referenced button
+				+ SHorizontalBox::Slot()
+				.HAlign(HAlign_Right)
+				.VAlign(VAlign_Fill)
+				[
+					ConstructWhyReferencedButton(AssetDataToDisplay)
+				]
+
 				// button
 				+ SHorizontalBox::Slot()
 				.HAlign(HAlign_Right)
 				.VAlign(VAlign_Fill)
+				.AutoWidth()
 				[
 					ConstructButton(AssetDataToDisplay)
 				]
@@ -291,6 +394,45 @@ void SAdvancedDeletionWidget::OnComboBoxSelectionChanged(TSharedPtr<FString> Sel
 	{
 		SuperManagerModule.ListSameNameAssets(AssetsDataUnderSelectedFolder, DisplayedAssetsData);
 	}
+	else if (*SelectedOption.Get() == ListUnusedIgnoringSoft)
+	{
+		ListAssetsByIncomingKinds([](ESuperManagerDependencyKind Kinds)
+			{
+				return EnumHasAnyFlags(Kinds, ESuperManagerDependencyKind::Hard) == false;
+			});
+	}
+	else if (*SelectedOption.Get() == ListManagementOnly)
+	{
+		ListAssetsByIncomingKinds([](ESuperManagerDependencyKind Kinds)
+			{
+				return Kinds == ESuperManagerDependencyKind::Management;
+			});
+	}
+	else if (*SelectedOption.Get() == ListLookalikeTextures)
+	{
+		const int32 NumGroups = SuperManagerModule.ListSimilarTextures(AssetsDataUnderSelectedFolder, DisplayedAssetsData);
+
+		DebugHeader::ShowNotifyInfo(FString::FromInt(DisplayedAssetsData.Num()) + TEXT(" textures in ") + FString::FromInt(NumGroups) + TEXT(" groups of near duplicates"));
+	}
+	else if (*SelectedOption.Get() == ListLookalikeStaticMeshes)
+	{
+		const int32 NumGroups = SuperManagerModule.ListSimilarStaticMeshes(AssetsDataUnderSelectedFolder, DisplayedAssetsData);
+
+		DebugHeader::ShowNotifyInfo(FString::FromInt(DisplayedAssetsData.Num()) + TEXT(" static meshes in ") + FString::FromInt(NumGroups) + TEXT(" groups of identical or near identical geometry"));
+	}
+	else if (*SelectedOption.Get() == ListLookalikeNames)
+	{
+		const int32 NumGroups = SuperManagerModule.ListSimilarNameAssets(AssetsDataUnderSelectedFolder, DisplayedAssetsData);
+
+		DebugHeader::ShowNotifyInfo(FString::FromInt(DisplayedAssetsData.Num()) + TEXT(" assets in ") + FString::FromInt(NumGroups) + TEXT(" groups of similar names"));
+	}
+	else if (SelectedOption->StartsWith(SavedQueryPrefix))
+	{
+		const FString QueryText = SelectedOption->RightChop(FCString::Strlen(SavedQueryPrefix));
+		QueryTextBox->SetText(FText::FromString(QueryText));
+
+		ListAssetsByQuery(QueryText);
+	}
 	else
 	{
 		return;
@@ -322,6 +464,43 @@ void SAdvancedDeletionWidget::OnCheckStateChanged(ECheckBoxState NewState, TShar
 	}
 }
 
+void SAdvancedDeletionWidget::OnQueryTextCommitted(const FText& NewText, ETextCommit::Type CommitType)
+{
+	if (CommitType != ETextCommit::OnEnter) { return; }
+
+	ListAssetsByQuery(NewText.ToString());
+	RefreshAssetListView();
+}
+
+FReply SAdvancedDeletionWidget::OnSaveQueryButtonClicked()
+{
+	const FString QueryText = QueryTextBox->GetText().ToString().TrimStartAndEnd();
+
+	FSuperManagerAssetQuery Query;
+	FString Error;
+
+	if (FSuperManagerAssetQuery::Parse(QueryText, Query, Error) == false)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, Error);
+		return FReply::Handled();
+	}
+
+	const FString OptionText = SavedQueryPrefix + QueryText;
+	if (ComboBoxSourceItems.ContainsByPredicate([&OptionText](const TSharedPtr<FString>& Item) { return *Item == OptionText; }))
+	{
+		return FReply::Handled();
+	}
+
+	FSuperManagerAssetQuery::SaveQuery(QueryText);
+
+	ComboBoxSourceItems.Add(MakeShared<FString>(OptionText));
+	ConstructedComboBox->RefreshOptions();
+
+	DebugHeader::ShowNotifyInfo(TEXT("Saved the query to the listing options"));
+
+	return FReply::Handled();
+}
+
 FReply SAdvancedDeletionWidget::OnDeleteButtonClicked(TSharedPtr<FAssetData> ClickedAssetData)
 {
 	if (ClickedAssetData->IsValid() == false) { return FReply::Handled(); }
@@ -339,6 +518,9 @@ FReply SAdvancedDeletionWidget::OnDeleteButtonClicked(TSharedPtr<FAssetData> Cli
 			DisplayedAssetsData.Remove(ClickedAssetData);
 		}
 
+		// Referencer counts changed with the deletion
+		InvalidateAssetSnapshot();
+
 		// Refresh The List
 		RefreshAssetListView();
 	}
@@ -346,6 +528,60 @@ FReply SAdvancedDeletionWidget::OnDeleteButtonClicked(TSharedPtr<FAssetData> Cli
 	return FReply::Handled();
 }
 
+FReply SAdvancedDeletionWidget::OnWhyReferencedButtonClicked(TSharedPtr<FAssetData> ClickedAssetData)
+{
+	if (ClickedAssetData->IsValid() == false) { return FReply::Handled(); }
+
+	// The module keeps the project graph between clicks, so only the searches below run per click
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	const FSuperManagerAssetSnapshotRef Snapshot = SuperManagerModule.GetProjectAssetSnapshot();
+
+	const FString AssetName = ClickedAssetData->AssetName.ToString();
+	const int32 PackageIndex = Snapshot->FindPackageIndex(ClickedAssetData->PackageName);
+
+	if (PackageIndex == INDEX_NONE)
+	{
+		DebugHeader::ShowNotifyInfo(AssetName + TEXT(" is not in the asset registry"));
+		return FReply::Handled();
+	}
+
+	TArray<TArray<int32>> Chains;
+
+	if (Snapshot->FindReferenceChains(PackageIndex, MaxReferenceChains, Chains) == false)
+	{
+		const int32 NumReferencers = Snapshot->GetReferencers(PackageIndex).Num();
+
+		DebugHeader::ShowNotifyInfo(AssetName + TEXT(" is not reachable from any map, primary asset or code reference")
+			+ (NumReferencers > 0 ? TEXT("\nIt is only referenced by ") + FString::FromInt(NumReferencers) + TEXT(" packages that are unreachable themselves") : FString()));
+		return FReply::Handled();
+	}
+
+	if (Chains.Num() == 1 && Chains[0].Num() == 1)
+	{
+		DebugHeader::ShowNotifyInfo(AssetName + TEXT(" is itself a root (map, primary asset or referenced from outside /Game)"));
+		return FReply::Handled();
+	}
+
+	TSharedRef<FSuperManagerResultsReport> Report = MakeShared<FSuperManagerResultsReport>();
+	Report->Title = TEXT("Why Is ") + AssetName + TEXT(" Referenced");
+	Report->Summary = FString::FromInt(Chains.Num()) + TEXT(" shortest chains from a root down to ") + AssetName;
+
+	for (int32 ChainIndex = 0; ChainIndex < Chains.Num(); ChainIndex++)
+	{
+		const FString GroupName = TEXT("Chain ") + FString::FromInt(ChainIndex + 1);
+
+		for (int32 PackageIndexInChain : Chains[ChainIndex])
+		{
+			const FString PackageName = Snapshot->GetPackageName(PackageIndexInChain).ToString();
+			Report->AddItem(GroupName, PackageName, PackageName);
+		}
+	}
+
+	SuperManagerModule.ShowResultsReport(Report);
+
+	return FReply::Handled();
+}
+
 FReply SAdvancedDeletionWidget::OnDeleteAllButtonClicked()
 {
 	if (SelectedAssetsToDelete.Num() == 0)
@@ -364,7 +600,7 @@ FReply SAdvancedDeletionWidget::OnDeleteAllButtonClicked()
 	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
 	if (int32 DeletedAssets = SuperManagerModule.DeleteMultipleAssets(AssetsDataToDelete))
 	{
-		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, FString::FromInt(DeletedAssets) + TEXT(" Asstes Deleted Successfully"));
+		DebugHeader::ShowNotifyInfo(FString::FromInt(DeletedAssets) + TEXT(" Asstes Deleted Successfully"));
 
 		for (TSharedPtr<FAssetData>& AssetsDataPtr : SelectedAssetsToDelete)
 		{
@@ -381,6 +617,9 @@ FReply SAdvancedDeletionWidget::OnDeleteAllButtonClicked()
 			}
 		}
 
+		// Referencer counts changed with the deletion
+		InvalidateAssetSnapshot();
+
 		// Refresh The List
 		RefreshAssetListView();
 	}
@@ -388,6 +627,70 @@ FReply SAdvancedDeletionWidget::OnDeleteAllButtonClicked()
 	return FReply::Handled();
 }
 
+FReply SAdvancedDeletionWidget::OnConsolidateButtonClicked()
+{
+	const TArray<TSharedPtr<FAssetData>> SelectedRows = ConstructedAssetsListView->GetSelectedItems();
+
+	if (SelectedRows.Num() != 1)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Please select the one asset to keep, and tick the duplicates to merge into it"));
+		return FReply::Handled();
+	}
+
+	const TSharedPtr<FAssetData> SurvivorData = SelectedRows[0];
+
+	TArray<FAssetData> DuplicatesData;
+	TArray<TSharedPtr<FAssetData>> DuplicateRows;
+
+	for (const TSharedPtr<FAssetData>& AssetsDataPtr : SelectedAssetsToDelete)
+	{
+		if (AssetsDataPtr == SurvivorData || AssetsDataPtr->AssetClassPath != SurvivorData->AssetClassPath) { continue; }
+
+		DuplicatesData.Add(*AssetsDataPtr.Get());
+		DuplicateRows.Add(AssetsDataPtr);
+	}
+
+	if (DuplicatesData.Num() == 0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Please tick the duplicates to merge, they have to be of the same class as the selected asset"));
+		return FReply::Handled();
+	}
+
+	const FString Question = FString::Printf(TEXT("Replace every reference to the %d ticked assets with %s and delete them?"),
+		DuplicatesData.Num(), *SurvivorData->AssetName.ToString());
+
+	if (DebugHeader::ShowMsgDialog(EAppMsgType::YesNo, Question) != EAppReturnType::Yes)
+	{
+		return FReply::Handled();
+	}
+
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	const int32 NumConsolidated = SuperManagerModule.ConsolidateAssets(*SurvivorData.Get(), DuplicatesData);
+
+	if (NumConsolidated == 0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("Nothing was consolidated, see the log"));
+		return FReply::Handled();
+	}
+
+	DebugHeader::ShowNotifyInfo(FString::FromInt(NumConsolidated) + TEXT(" assets consolidated into ") + SurvivorData->AssetName.ToString());
+
+	for (const TSharedPtr<FAssetData>& DuplicateRow : DuplicateRows)
+	{
+		if (UEditorAssetLibrary::DoesAssetExist(DuplicateRow->GetSoftObjectPath().ToString())) { continue; }
+
+		AssetsDataUnderSelectedFolder.Remove(DuplicateRow);
+		DisplayedAssetsData.Remove(DuplicateRow);
+	}
+
+	// Referencer counts changed with the consolidation
+	InvalidateAssetSnapshot();
+
+	RefreshAssetListView();
+
+	return FReply::Handled();
+}
+
 FReply SAdvancedDeletionWidget::OnSelectAllButtonClicked()
 {
 	if (CheckBoxesArray.Num() == 0)
@@ -431,6 +734,91 @@ FSlateFontInfo SAdvancedDeletionWidget::GetEmbossedTextFont(float Size)
 	return TextFontInfo;
 }
 
+const FSuperManagerAssetSnapshot& SAdvancedDeletionWidget::GetAssetSnapshot()
+{
+	// Every dependency category comes out of the same capture, so switching between these filters costs no registry queries
+	if (AssetSnapshot.IsValid() == false)
+	{
+		AssetSnapshot = FSuperManagerAssetSnapshot::Capture({ CurrentSelectedFolder });
+
+		TMap<FSoftObjectPath, TSharedPtr<FAssetData>> RowsByPath;
+		RowsByPath.Reserve(AssetsDataUnderSelectedFolder.Num());
+
+		for (const TSharedPtr<FAssetData>& DataPtr : AssetsDataUnderSelectedFolder)
+		{
+			RowsByPath.Add(DataPtr->GetSoftObjectPath(), DataPtr);
+		}
+
+		SnapshotAssetRows.SetNum(AssetSnapshot->NumAssets());
+		for (int32 AssetIndex = 0; AssetIndex < AssetSnapshot->NumAssets(); AssetIndex++)
+		{
+			SnapshotAssetRows[AssetIndex] = RowsByPath.FindRef(AssetSnapshot->GetAsset(AssetIndex).GetSoftObjectPath());
+		}
+	}
+
+	return *AssetSnapshot;
+}
+
+void SAdvancedDeletionWidget::ListAssetsByIncomingKinds(TFunctionRef<bool(ESuperManagerDependencyKind)> Predicate)
+{
+	const FSuperManagerAssetSnapshot& Snapshot = GetAssetSnapshot();
+
+	DisplayedAssetsData.Empty();
+
+	for (const TSharedPtr<FAssetData>& DataPtr : AssetsDataUnderSelectedFolder)
+	{
+		const int32 PackageIndex = Snapshot.FindPackageIndex(DataPtr->PackageName);
+		if (PackageIndex == INDEX_NONE) { continue; }
+
+		if (Predicate(Snapshot.GetIncomingKinds(PackageIndex)))
+		{
+			DisplayedAssetsData.Add(DataPtr);
+		}
+	}
+}
+
+void SAdvancedDeletionWidget::ListAssetsByQuery(const FString& QueryText)
+{
+	FSuperManagerAssetQuery Query;
+	FString Error;
+
+	if (FSuperManagerAssetQuery::Parse(QueryText, Query, Error) == false)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, Error);
+		return;
+	}
+
+	const FSuperManagerAssetSnapshot& Snapshot = GetAssetSnapshot();
+
+	const double StartSeconds = FPlatformTime::Seconds();
+
+	const FSuperManagerCompiledAssetQuery CompiledQuery = Query.Compile(Snapshot);
+
+	TArray<int32> MatchingAssets;
+	CompiledQuery.Evaluate(MatchingAssets);
+
+	DebugHeader::PrintLog(FString::Printf(TEXT("Query over %d assets matched %d in %.2f ms: %s"), Snapshot.NumAssets(), MatchingAssets.Num(),
+		(FPlatformTime::Seconds() - StartSeconds) * 1000.0, *CompiledQuery.Describe()));
+
+	DisplayedAssetsData.Empty(MatchingAssets.Num());
+
+	for (int32 AssetIndex : MatchingAssets)
+	{
+		if (SnapshotAssetRows[AssetIndex].IsValid())
+		{
+			DisplayedAssetsData.Add(SnapshotAssetRows[AssetIndex]);
+		}
+	}
+
+	DebugHeader::ShowNotifyInfo(FString::FromInt(DisplayedAssetsData.Num()) + TEXT(" assets match the query"));
+}
+
+void SAdvancedDeletionWidget::InvalidateAssetSnapshot()
+{
+	AssetSnapshot.Reset();
+	SnapshotAssetRows.Empty();
+}
+
 void SAdvancedDeletionWidget::RefreshAssetListView()
 {
 	SelectedAssetsToDelete.Empty();
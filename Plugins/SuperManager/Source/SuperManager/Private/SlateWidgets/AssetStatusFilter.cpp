@@ -0,0 +1,72 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SlateWidgets/AssetStatusFilter.h"
+#include "SuperManager.h"
+#include "FrontendFilterBase.h"
+#include "ContentBrowserItem.h"
+
+namespace
+{
+	class FAssetStatusFilter : public FFrontendFilter
+	{
+	public:
+		FAssetStatusFilter(TSharedPtr<FFrontendFilterCategory> InCategory, bool bInUnreachable)
+			: FFrontendFilter(InCategory)
+			, bUnreachable(bInUnreachable)
+		{
+			FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+			SuperManagerModule.GetAssetStatusCache().OnStatusChanged().AddRaw(this, &FAssetStatusFilter::OnStatusChanged);
+		}
+
+		virtual ~FAssetStatusFilter()
+		{
+			if (FSuperManagerModule* SuperManagerModule = FModuleManager::GetModulePtr<FSuperManagerModule>(TEXT("SuperManager")))
+			{
+				SuperManagerModule->GetAssetStatusCache().OnStatusChanged().RemoveAll(this);
+			}
+		}
+
+		virtual FString GetName() const override { return bUnreachable ? TEXT("SuperManagerUnreachable") : TEXT("SuperManagerUnused"); }
+		virtual FText GetDisplayName() const override { return FText::FromString(bUnreachable ? TEXT("Unreachable") : TEXT("Unused")); }
+		virtual FLinearColor GetColor() const override { return bUnreachable ? FLinearColor(1.0f, 0.5f, 0.0f) : FLinearColor::Red; }
+
+		virtual FText GetToolTipText() const override
+		{
+			return FText::FromString(bUnreachable
+				? TEXT("Assets no map or primary asset leads to")
+				: TEXT("Assets no other package references"));
+		}
+
+		virtual bool PassesFilter(FAssetFilterType InItem) const override
+		{
+			FAssetData AssetData;
+			if (InItem.Legacy_TryGetAssetData(AssetData) == false) { return false; }
+
+			FSuperManagerModule& SuperManagerModule = FModuleManager::GetModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+
+			FSuperManagerAssetStatus Status;
+			if (SuperManagerModule.GetAssetStatusCache().GetStatus(AssetData.PackageName, Status) == false) { return false; }
+
+			return bUnreachable ? Status.bUnreachable : Status.bUnused;
+		}
+
+	private:
+		void OnStatusChanged()
+		{
+			BroadcastChangedEvent();
+		}
+
+	private:
+		bool bUnreachable;
+	};
+}
+
+void USuperManagerAssetStatusFilterExtension::AddFrontEndFilterExtensions(TSharedPtr<FFrontendFilterCategory> DefaultCategory, TArray<TSharedRef<FFrontendFilter>>& InOutFilterList) const
+{
+	TSharedPtr<FFrontendFilterCategory> SuperManagerCategory = MakeShared<FFrontendFilterCategory>(
+		FText::FromString(TEXT("SuperManager")), FText::FromString(TEXT("Asset status tracked by SuperManager")));
+
+	InOutFilterList.Add(MakeShared<FAssetStatusFilter>(SuperManagerCategory, false));
+	InOutFilterList.Add(MakeShared<FAssetStatusFilter>(SuperManagerCategory, true));
+}
@@ -0,0 +1,281 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SlateWidgets/MeshAuditWidget.h"
+#include "SlateBasics.h"
+#include "DebugHeader.h"
+#include "SuperManager.h"
+#include "EditorAssetLibrary.h"
+
+#define NumGeneratedLODs 4
+
+void SMeshAuditWidget::Construct(const FArguments& InArgs)
+{
+	bCanSupportFocus = true;
+
+	StaticMeshesData = InArgs._StaticMeshesData;
+	SuperManagerMeshAudit::AuditStaticMeshes(StaticMeshesData, DisplayedEntries);
+
+	FSlateFontInfo TitleTextFont = GetEmbossedTextFont(30.f);
+
+	ChildSlot
+		[
+			SNew(SVerticalBox)
+
+				// Title Slot
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				[
+					SNew(STextBlock)
+						.Text(FText::FromString("Static Mesh Audit"))
+						.Font(TitleTextFont)
+						.Justification(ETextJustify::Center)
+						.ColorAndOpacity(FColor::White)
+				]
+
+				// help text
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				[
+					SNew(SHorizontalBox)
+
+						+ SHorizontalBox::Slot()
+						.FillWidth(0.6f)
+						[
+							ConstructTextBlock(TEXT("Meshes sorted by triangle count. Columns: triangles, LODs, Nanite, collision"), GetEmbossedTextFont(8.0f), FColor::Green, ETextJustify::Center)
+						]
+
+						+ SHorizontalBox::Slot()
+						.FillWidth(0.1f)
+						[
+							ConstructTextBlock(TEXT("Current Folder \n") + InArgs._CurrentSelectedFolder, GetEmbossedTextFont(8.0f), FColor::Green, ETextJustify::Center)
+						]
+				]
+
+				// meshes list
+				+ SVerticalBox::Slot()
+				.VAlign(VAlign_Fill)
+				[
+					SNew(SScrollBox)
+
+						+ SScrollBox::Slot()
+						[
+							ConstructMeshesListView()
+						]
+				]
+
+				// buttons
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				[
+					SNew(SHorizontalBox)
+
+						+ SHorizontalBox::Slot()
+						[
+							ConstructActionButton(TEXT("Enable Nanite"), &SMeshAuditWidget::OnEnableNaniteButtonClicked)
+						]
+
+						+ SHorizontalBox::Slot()
+						[
+							ConstructActionButton(TEXT("Generate LODs"), &SMeshAuditWidget::OnGenerateLODsButtonClicked)
+						]
+				]
+		];
+}
+
+#pragma region ConstructionMethods
+TSharedRef<SListView<TSharedPtr<FStaticMeshAuditEntry>>> SMeshAuditWidget::ConstructMeshesListView()
+{
+	ConstructedMeshesListView = SNew(SListView<TSharedPtr<FStaticMeshAuditEntry>>)
+		.ItemHeight(24.0f)
+		.ListItemsSource(&DisplayedEntries)
+		.OnGenerateRow(this, &SMeshAuditWidget::OnGenerateRowForList);
+
+	return ConstructedMeshesListView.ToSharedRef();
+}
+
+TSharedRef<STextBlock> SMeshAuditWidget::ConstructTextBlock(const FString& TextContent, const FSlateFontInfo& Font, FColor Color, ETextJustify::Type Justify)
+{
+	TSharedRef<STextBlock> ConstructedTextBlock = SNew(STextBlock)
+		.Text(FText::FromString(TextContent))
+		.Font(Font)
+		.ColorAndOpacity(Color)
+		.Justification(Justify)
+		.AutoWrapText(true);
+
+	return ConstructedTextBlock;
+}
+
+TSharedRef<SButton> SMeshAuditWidget::ConstructActionButton(const FString& ButtonText, FReply(SMeshAuditWidget::* OnClickedMethod)())
+{
+	TSharedRef<SButton> ConstructedButton = SNew(SButton)
+		.OnClicked(this, OnClickedMethod);
+
+	ConstructedButton->SetContent(ConstructTextBlock(ButtonText, GetEmbossedTextFont(), FColor::White, ETextJustify::Center));
+
+	return ConstructedButton;
+}
+#pragma endregion
+
+#pragma region EventsMethods
+TSharedRef<ITableRow> SMeshAuditWidget::OnGenerateRowForList(TSharedPtr<FStaticMeshAuditEntry> EntryToDisplay, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	FSlateFontInfo EmbossedTextFont = GetEmbossedTextFont();
+
+	// Highlight the combinations that cost the most at runtime
+	const bool bNeedsLODs = EntryToDisplay->NumLODs <= 1 && EntryToDisplay->bNaniteEnabled == false;
+	const FColor LODColor = bNeedsLODs ? FColor::Red : FColor::White;
+	const FColor CollisionColor = EntryToDisplay->UsesComplexAsSimple() ? FColor::Red : FColor::White;
+
+	TSharedRef<STableRow<TSharedPtr<FStaticMeshAuditEntry>>> ListViewRowWidget =
+		SNew(STableRow<TSharedPtr<FStaticMeshAuditEntry>>, OwnerTable).Padding(FMargin(5.0f))
+		[
+			SNew(SHorizontalBox)
+
+				// check box
+				+ SHorizontalBox::Slot()
+				.HAlign(HAlign_Left)
+				.VAlign(VAlign_Center)
+				.FillWidth(0.05f)
+				[
+					SNew(SCheckBox)
+						.Type(ESlateCheckBoxType::CheckBox)
+						.IsChecked_Lambda([this, EntryToDisplay]() { return SelectedEntries.Contains(EntryToDisplay) ? ECheckBoxState::Checked : ECheckBoxState::Unchecked; })
+						.OnCheckStateChanged(this, &SMeshAuditWidget::OnCheckStateChanged, EntryToDisplay)
+				]
+
+				// mesh name
+				+ SHorizontalBox::Slot()
+				.HAlign(HAlign_Left)
+				.VAlign(VAlign_Fill)
+				.FillWidth(0.3f)
+				[
+					ConstructTextBlock(EntryToDisplay->AssetData.AssetName.ToString(), EmbossedTextFont)
+				]
+
+				+ SHorizontalBox::Slot()
+				.HAlign(HAlign_Left)
+				.VAlign(VAlign_Fill)
+				.FillWidth(0.15f)
+				[
+					ConstructTextBlock(FString::FormatAsNumber(EntryToDisplay->NumTriangles), EmbossedTextFont, FColor::Emerald)
+				]
+
+				+ SHorizontalBox::Slot()
+				.HAlign(HAlign_Left)
+				.VAlign(VAlign_Fill)
+				.FillWidth(0.1f)
+				[
+					ConstructTextBlock(TEXT("LODs ") + FString::FromInt(EntryToDisplay->NumLODs), EmbossedTextFont, LODColor)
+				]
+
+				+ SHorizontalBox::Slot()
+				.HAlign(HAlign_Left)
+				.VAlign(VAlign_Fill)
+				.FillWidth(0.1f)
+				[
+					ConstructTextBlock(EntryToDisplay->bNaniteEnabled ? TEXT("Nanite") : TEXT("No Nanite"), EmbossedTextFont)
+				]
+
+				+ SHorizontalBox::Slot()
+				.HAlign(HAlign_Left)
+				.VAlign(VAlign_Fill)
+				.FillWidth(0.3f)
+				[
+					ConstructTextBlock(EntryToDisplay->CollisionComplexity, EmbossedTextFont, CollisionColor)
+				]
+		];
+
+	return ListViewRowWidget;
+}
+
+void SMeshAuditWidget::OnCheckStateChanged(ECheckBoxState NewState, TSharedPtr<FStaticMeshAuditEntry> Entry)
+{
+	switch (NewState)
+	{
+	case ECheckBoxState::Unchecked:
+		SelectedEntries.Remove(Entry);
+		break;
+
+	case ECheckBoxState::Checked:
+		SelectedEntries.AddUnique(Entry);
+		break;
+
+	default:
+		break;
+	}
+}
+
+FReply SMeshAuditWidget::OnEnableNaniteButtonClicked()
+{
+	TArray<FAssetData> SelectedMeshesData = GetSelectedMeshesData();
+	if (SelectedMeshesData.Num() == 0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No meshes currently selected"));
+		return FReply::Handled();
+	}
+
+	const int32 NumChangedMeshes = SuperManagerMeshAudit::EnableNanite(SelectedMeshesData);
+	DebugHeader::ShowNotifyInfo(TEXT("Enabled Nanite on ") + FString::FromInt(NumChangedMeshes) + TEXT(" meshes"));
+
+	RefreshMeshListView();
+
+	return FReply::Handled();
+}
+
+FReply SMeshAuditWidget::OnGenerateLODsButtonClicked()
+{
+	TArray<FAssetData> SelectedMeshesData = GetSelectedMeshesData();
+	if (SelectedMeshesData.Num() == 0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No meshes currently selected"));
+		return FReply::Handled();
+	}
+
+	const int32 NumChangedMeshes = SuperManagerMeshAudit::GenerateLODs(SelectedMeshesData, NumGeneratedLODs);
+	DebugHeader::ShowNotifyInfo(TEXT("Generated LODs for ") + FString::FromInt(NumChangedMeshes) + TEXT(" meshes"));
+
+	RefreshMeshListView();
+
+	return FReply::Handled();
+}
+#pragma endregion
+
+#pragma region HelperMethods
+FSlateFontInfo SMeshAuditWidget::GetEmbossedTextFont(float Size)
+{
+	FSlateFontInfo TextFontInfo = FCoreStyle::Get().GetFontStyle(FName("EmbossedText"));
+	TextFontInfo.Size = Size;
+
+	return TextFontInfo;
+}
+
+TArray<FAssetData> SMeshAuditWidget::GetSelectedMeshesData() const
+{
+	TArray<FAssetData> SelectedMeshesData;
+
+	for (const TSharedPtr<FStaticMeshAuditEntry>& Entry : SelectedEntries)
+	{
+		SelectedMeshesData.Add(Entry->AssetData);
+	}
+
+	return SelectedMeshesData;
+}
+
+void SMeshAuditWidget::RefreshMeshListView()
+{
+	// Registry tags were rewritten by the save, so pick up the fresh asset data
+	for (FAssetData& MeshData : StaticMeshesData)
+	{
+		MeshData = UEditorAssetLibrary::FindAssetData(MeshData.GetSoftObjectPath().ToString());
+	}
+
+	SelectedEntries.Empty();
+	SuperManagerMeshAudit::AuditStaticMeshes(StaticMeshesData, DisplayedEntries);
+
+	if (ConstructedMeshesListView.IsValid())
+	{
+		ConstructedMeshesListView->RebuildList();
+	}
+}
+#pragma endregion
@@ -0,0 +1,317 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SlateWidgets/ResultsPanelWidget.h"
+#include "SlateBasics.h"
+#include "DebugHeader.h"
+#include "SuperManager.h"
+#include "HAL/PlatformApplicationMisc.h"
+#include "Misc/FileHelper.h"
+
+void SSuperManagerResultsPanel::Construct(const FArguments& InArgs)
+{
+	bCanSupportFocus = true;
+
+	FSlateFontInfo TitleTextFont = GetEmbossedTextFont(30.f);
+
+	ChildSlot
+		[
+			SNew(SVerticalBox)
+
+				// Title Slot
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				[
+					SNew(STextBlock)
+						.Text(this, &SSuperManagerResultsPanel::GetTitleText)
+						.Font(TitleTextFont)
+						.Justification(ETextJustify::Center)
+						.ColorAndOpacity(FColor::White)
+				]
+
+				// summary
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				[
+					SNew(STextBlock)
+						.Text(this, &SSuperManagerResultsPanel::GetSummaryText)
+						.Font(GetEmbossedTextFont(8.0f))
+						.Justification(ETextJustify::Center)
+						.ColorAndOpacity(FColor::Green)
+						.AutoWrapText(true)
+				]
+
+				// results tree, only the visible rows are ever generated
+				+ SVerticalBox::Slot()
+				.VAlign(VAlign_Fill)
+				[
+					ConstructResultsTreeView()
+				]
+
+				// inline confirmation
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				[
+					SNew(SHorizontalBox)
+						.Visibility(this, &SSuperManagerResultsPanel::GetConfirmVisibility)
+
+						+ SHorizontalBox::Slot()
+						[
+							SNew(SButton)
+								.OnClicked(this, &SSuperManagerResultsPanel::OnConfirmButtonClicked)
+								[
+									SNew(STextBlock)
+										.Text(this, &SSuperManagerResultsPanel::GetConfirmText)
+										.Font(GetEmbossedTextFont())
+										.ColorAndOpacity(FColor::Red)
+										.Justification(ETextJustify::Center)
+								]
+						]
+
+						+ SHorizontalBox::Slot()
+						[
+							ConstructActionButton(TEXT("Cancel"), &SSuperManagerResultsPanel::OnCancelButtonClicked)
+						]
+				]
+
+				// buttons
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				[
+					SNew(SHorizontalBox)
+
+						+ SHorizontalBox::Slot()
+						[
+							ConstructActionButton(TEXT("Copy"), &SSuperManagerResultsPanel::OnCopyButtonClicked)
+						]
+
+						+ SHorizontalBox::Slot()
+						[
+							ConstructActionButton(TEXT("Export CSV"), &SSuperManagerResultsPanel::OnExportButtonClicked)
+						]
+				]
+		];
+
+	SetReport(InArgs._Report);
+}
+
+void SSuperManagerResultsPanel::SetReport(const TSharedPtr<FSuperManagerResultsReport>& InReport)
+{
+	Report = InReport;
+
+	BuildNodes();
+
+	if (ConstructedResultsTreeView.IsValid() == false) { return; }
+
+	ConstructedResultsTreeView->RequestTreeRefresh();
+
+	for (const TSharedPtr<FSuperManagerResultNode>& RootNode : RootNodes)
+	{
+		if (RootNode->Children.Num() > 0)
+		{
+			ConstructedResultsTreeView->SetItemExpansion(RootNode, true);
+		}
+	}
+}
+
+#pragma region ConstructionMethods
+TSharedRef<STreeView<TSharedPtr<FSuperManagerResultNode>>> SSuperManagerResultsPanel::ConstructResultsTreeView()
+{
+	ConstructedResultsTreeView = SNew(STreeView<TSharedPtr<FSuperManagerResultNode>>)
+		.TreeItemsSource(&RootNodes)
+		.OnGenerateRow(this, &SSuperManagerResultsPanel::OnGenerateRowForTree)
+		.OnGetChildren(this, &SSuperManagerResultsPanel::OnGetChildren)
+		.OnMouseButtonDoubleClick(this, &SSuperManagerResultsPanel::OnRowDoubleClick);
+
+	return ConstructedResultsTreeView.ToSharedRef();
+}
+
+TSharedRef<STextBlock> SSuperManagerResultsPanel::ConstructTextBlock(const FString& TextContent, const FSlateFontInfo& Font, FColor Color, ETextJustify::Type Justify)
+{
+	TSharedRef<STextBlock> ConstructedTextBlock = SNew(STextBlock)
+		.Text(FText::FromString(TextContent))
+		.Font(Font)
+		.ColorAndOpacity(Color)
+		.Justification(Justify);
+
+	return ConstructedTextBlock;
+}
+
+TSharedRef<SButton> SSuperManagerResultsPanel::ConstructActionButton(const FString& ButtonText, FReply(SSuperManagerResultsPanel::* OnClickedMethod)())
+{
+	TSharedRef<SButton> ConstructedButton = SNew(SButton)
+		.OnClicked(this, OnClickedMethod);
+
+	ConstructedButton->SetContent(ConstructTextBlock(ButtonText, GetEmbossedTextFont(), FColor::White, ETextJustify::Center));
+
+	return ConstructedButton;
+}
+#pragma endregion
+
+#pragma region EventsMethods
+TSharedRef<ITableRow> SSuperManagerResultsPanel::OnGenerateRowForTree(TSharedPtr<FSuperManagerResultNode> NodeToDisplay, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	const bool bIsGroup = NodeToDisplay->Item.IsValid() == false;
+
+	return
+		SNew(STableRow<TSharedPtr<FSuperManagerResultNode>>, OwnerTable).Padding(FMargin(2.0f))
+		[
+			ConstructTextBlock(NodeToDisplay->Text, GetEmbossedTextFont(bIsGroup ? 10.0f : 9.0f), bIsGroup ? FColor::Emerald : FColor::White)
+		];
+}
+
+void SSuperManagerResultsPanel::OnGetChildren(TSharedPtr<FSuperManagerResultNode> Node, TArray<TSharedPtr<FSuperManagerResultNode>>& OutChildren)
+{
+	OutChildren = Node->Children;
+}
+
+void SSuperManagerResultsPanel::OnRowDoubleClick(TSharedPtr<FSuperManagerResultNode> ClickedNode)
+{
+	if (ClickedNode->Item.IsValid() == false || ClickedNode->Item->ObjectPath.IsEmpty()) { return; }
+
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	SuperManagerModule.SyncCBToClickedAsset(ClickedNode->Item->ObjectPath);
+}
+
+FReply SSuperManagerResultsPanel::OnCopyButtonClicked()
+{
+	if (Report.IsValid() == false) { return FReply::Handled(); }
+
+	FPlatformApplicationMisc::ClipboardCopy(*BuildReportText(false));
+
+	DebugHeader::ShowNotifyInfo(TEXT("Copied ") + FString::FromInt(Report->Items.Num()) + TEXT(" results"));
+
+	return FReply::Handled();
+}
+
+FReply SSuperManagerResultsPanel::OnExportButtonClicked()
+{
+	if (Report.IsValid() == false) { return FReply::Handled(); }
+
+	const FString ReportPath = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("SuperManager") / FPaths::MakeValidFileName(Report->Title) + TEXT(".csv"));
+
+	if (FFileHelper::SaveStringToFile(BuildReportText(true), *ReportPath))
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("Results exported to ") + ReportPath);
+	}
+
+	return FReply::Handled();
+}
+
+FReply SSuperManagerResultsPanel::OnConfirmButtonClicked()
+{
+	if (Report.IsValid() == false || !Report->OnConfirm) { return FReply::Handled(); }
+
+	// Runs once, the report stays up as the record of what was done
+	TFunction<void()> OnConfirm = MoveTemp(Report->OnConfirm);
+	Report->OnConfirm = nullptr;
+
+	OnConfirm();
+
+	return FReply::Handled();
+}
+
+FReply SSuperManagerResultsPanel::OnCancelButtonClicked()
+{
+	if (Report.IsValid() == false) { return FReply::Handled(); }
+
+	Report->OnConfirm = nullptr;
+
+	DebugHeader::ShowNotifyInfo(TEXT("Operation Canceled"));
+
+	return FReply::Handled();
+}
+#pragma endregion
+
+#pragma region HelperMethods
+FSlateFontInfo SSuperManagerResultsPanel::GetEmbossedTextFont(float Size)
+{
+	FSlateFontInfo TextFontInfo = FCoreStyle::Get().GetFontStyle(FName("EmbossedText"));
+	TextFontInfo.Size = Size;
+
+	return TextFontInfo;
+}
+
+void SSuperManagerResultsPanel::BuildNodes()
+{
+	RootNodes.Empty();
+
+	if (Report.IsValid() == false) { return; }
+
+	TMap<FString, TSharedPtr<FSuperManagerResultNode>> GroupNodes;
+
+	for (const TSharedPtr<FSuperManagerResultItem>& Item : Report->Items)
+	{
+		TSharedPtr<FSuperManagerResultNode> ItemNode = MakeShared<FSuperManagerResultNode>();
+		ItemNode->Text = Item->Text;
+		ItemNode->Item = Item;
+
+		// Ungrouped items sit at the top level
+		if (Item->Group.IsEmpty())
+		{
+			RootNodes.Add(ItemNode);
+			continue;
+		}
+
+		TSharedPtr<FSuperManagerResultNode>& GroupNode = GroupNodes.FindOrAdd(Item->Group);
+		if (GroupNode.IsValid() == false)
+		{
+			GroupNode = MakeShared<FSuperManagerResultNode>();
+			RootNodes.Add(GroupNode);
+		}
+
+		GroupNode->Children.Add(ItemNode);
+	}
+
+	for (const TPair<FString, TSharedPtr<FSuperManagerResultNode>>& GroupNode : GroupNodes)
+	{
+		GroupNode.Value->Text = GroupNode.Key + TEXT(" (") + FString::FromInt(GroupNode.Value->Children.Num()) + TEXT(")");
+	}
+}
+
+FString SSuperManagerResultsPanel::BuildReportText(bool bAsCSV) const
+{
+	TArray<FString> Lines;
+	Lines.Reserve(Report->Items.Num() + 1);
+
+	if (bAsCSV)
+	{
+		Lines.Add(TEXT("Group,Result,Object"));
+	}
+
+	for (const TSharedPtr<FSuperManagerResultItem>& Item : Report->Items)
+	{
+		if (bAsCSV)
+		{
+			Lines.Add(FString::Printf(TEXT("\"%s\",\"%s\",%s"), *Item->Group.Replace(TEXT("\""), TEXT("\"\"")), *Item->Text.Replace(TEXT("\""), TEXT("\"\"")), *Item->ObjectPath));
+			continue;
+		}
+
+		Lines.Add(Item->Group.IsEmpty() ? Item->Text : Item->Group + TEXT("\t") + Item->Text);
+	}
+
+	return FString::Join(Lines, TEXT("\n"));
+}
+
+FText SSuperManagerResultsPanel::GetTitleText() const
+{
+	return FText::FromString(Report.IsValid() ? Report->Title : TEXT("SuperManager Results"));
+}
+
+FText SSuperManagerResultsPanel::GetSummaryText() const
+{
+	if (Report.IsValid() == false) { return FText::GetEmpty(); }
+
+	return FText::FromString(Report->Summary + TEXT("\nDouble click a result to go to asset location"));
+}
+
+EVisibility SSuperManagerResultsPanel::GetConfirmVisibility() const
+{
+	return Report.IsValid() && Report->OnConfirm ? EVisibility::Visible : EVisibility::Collapsed;
+}
+
+FText SSuperManagerResultsPanel::GetConfirmText() const
+{
+	return FText::FromString(Report.IsValid() ? Report->ConfirmLabel : FString());
+}
+#pragma endregion
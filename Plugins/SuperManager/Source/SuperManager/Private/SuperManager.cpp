@@ -6,9 +6,24 @@
 #include "EditorAssetLibrary.h"
 #include "ObjectTools.h"
 #include "AssetToolsModule.h"
-#include "AssetViewUtils.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetAnalysis/BulkAssetProcessing.h"
+#include "AssetAnalysis/SourceControlBatch.h"
+#include "AssetAnalysis/SnapshotFile.h"
+#include "AssetAnalysis/SimilarityGrouping.h"
+#include "AssetAnalysis/MeshSimilarity.h"
+#include "AssetAnalysis/NameSimilarity.h"
+#include "AssetAnalysis/ChunkAnalysis.h"
+#include "AssetAnalysis/MapLoadClosure.h"
+#include "AssetActions/QuickAssetAction.h"
+#include "Engine/Texture2D.h"
+#include "DesktopPlatformModule.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Engine/StaticMesh.h"
+#include "Styling/AppStyle.h"
 #include "SlateWidgets/AdvancedDeletionWidget.h"
+#include "SlateWidgets/MeshAuditWidget.h"
+#include "SlateWidgets/ResultsPanelWidget.h"
 #include "CustomStyle/SuperManagerStyle.h"
 
 #define LOCTEXT_NAMESPACE "FSuperManagerModule"
@@ -19,11 +34,24 @@ void FSuperManagerModule::StartupModule()
 
 	InitCBMenuExtention();
 	RegisterAdvancedDeletionTab();
+	RegisterMeshAuditTab();
+	RegisterResultsTab();
+	RegisterAssetRegistryCallbacks();
+	InitAssetStatusCache();
+	RegisterAssetStatusIndicators();
+	NamingConvention.Register();
 }
 
 void FSuperManagerModule::ShutdownModule()
 {
 	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(FName("AdvancedDeletion"));
+	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(FName("MeshAudit"));
+	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(FName("SuperManagerResults"));
+
+	UnregisterAssetRegistryCallbacks();
+	UnregisterAssetStatusIndicators();
+	AssetStatusCache.Reset();
+	NamingConvention.Unregister();
 
 	FSuperManagerStyle::ShutDown();
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
@@ -91,6 +119,76 @@ void FSuperManagerModule::AddCBMenuEntry(class FMenuBuilder& MenuBuilder)
 		FSlateIcon(FSuperManagerStyle::GetStyleSetName(), "ContentBrowser.AdvanceDeletion"),
 		FExecuteAction::CreateRaw(this, &FSuperManagerModule::OnAdvancedDeletionButtonCLicked)
 	);
+
+	MenuBuilder.AddMenuEntry
+	(
+		FText::FromString(TEXT("Static Mesh Audit")),
+		FText::FromString(TEXT("List static meshes by triangle count, LODs, Nanite and collision")),
+		FSlateIcon(FAppStyle::GetAppStyleSetName(), "ClassIcon.StaticMesh"),
+		FExecuteAction::CreateRaw(this, &FSuperManagerModule::OnMeshAuditButtonClicked)
+	);
+
+	MenuBuilder.AddMenuEntry
+	(
+		FText::FromString(TEXT("Export Analysis Snapshot")),
+		FText::FromString(TEXT("Write packages, sizes, hashes and dependencies of the whole project to a snapshot file")),
+		FSlateIcon(FAppStyle::GetAppStyleSetName(), "Icons.Save"),
+		FExecuteAction::CreateRaw(this, &FSuperManagerModule::OnExportSnapshotButtonClicked)
+	);
+
+	MenuBuilder.AddMenuEntry
+	(
+		FText::FromString(TEXT("Compare Analysis Snapshots")),
+		FText::FromString(TEXT("List assets added, removed, newly unused, grown or gaining hard references between two snapshot files")),
+		FSlateIcon(FAppStyle::GetAppStyleSetName(), "Icons.Diff"),
+		FExecuteAction::CreateRaw(this, &FSuperManagerModule::OnCompareSnapshotsButtonClicked)
+	);
+
+	MenuBuilder.AddMenuEntry
+	(
+		FText::FromString(TEXT("Chunk Duplication")),
+		FText::FromString(TEXT("List packages the primary asset rules cook into several chunks, most duplicated bytes first")),
+		FSlateIcon(FAppStyle::GetAppStyleSetName(), "Icons.Package"),
+		FExecuteAction::CreateRaw(this, &FSuperManagerModule::OnChunkDuplicationButtonClicked)
+	);
+
+	MenuBuilder.AddMenuEntry
+	(
+		FText::FromString(TEXT("Map Load Closures")),
+		FText::FromString(TEXT("Estimate what each map loads through hard references, per asset class, with its largest packages")),
+		FSlateIcon(FAppStyle::GetAppStyleSetName(), "ClassIcon.World"),
+		FExecuteAction::CreateRaw(this, &FSuperManagerModule::OnMapLoadClosureButtonClicked)
+	);
+
+	MenuBuilder.AddSubMenu
+	(
+		FText::FromString(TEXT("Naming Convention For New Assets")),
+		FText::FromString(TEXT("What happens to created or imported assets missing the prefix of their class")),
+		FNewMenuDelegate::CreateRaw(this, &FSuperManagerModule::AddNamingConventionMenu)
+	);
+}
+
+void FSuperManagerModule::AddNamingConventionMenu(FMenuBuilder& MenuBuilder)
+{
+	auto AddModeEntry = [this, &MenuBuilder](const TCHAR* Label, const TCHAR* ToolTip, ESuperManagerNamingMode Mode)
+		{
+			MenuBuilder.AddMenuEntry
+			(
+				FText::FromString(Label),
+				FText::FromString(ToolTip),
+				FSlateIcon(),
+				FUIAction(
+					FExecuteAction::CreateLambda([this, Mode]() { NamingConvention.SetMode(Mode); }),
+					FCanExecuteAction(),
+					FIsActionChecked::CreateLambda([this, Mode]() { return NamingConvention.GetMode() == Mode; })),
+				NAME_None,
+				EUserInterfaceActionType::RadioButton
+			);
+		};
+
+	AddModeEntry(TEXT("Off"), TEXT("Leave new assets alone"), ESuperManagerNamingMode::Off);
+	AddModeEntry(TEXT("Warn"), TEXT("Log new assets missing their prefix"), ESuperManagerNamingMode::Warn);
+	AddModeEntry(TEXT("Rename"), TEXT("Add the missing prefix to new assets right after they are created"), ESuperManagerNamingMode::Rename);
 }
 
 void FSuperManagerModule::OnDeleteUnusedAssetButtonCLicked()
@@ -101,54 +199,74 @@ void FSuperManagerModule::OnDeleteUnusedAssetButtonCLicked()
 		return;
 	}
 
-	TArray<FString> AssetsNames = UEditorAssetLibrary::ListAssets(SelectedFolderPath[0]);
+	FixupRedirectors();
 
-	if (AssetsNames.Num() == 0)
+	TArray<FAssetData> UnusedAssetsData;
+	GatherUnusedAssets(SelectedFolderPath[0], UnusedAssetsData);
+
+	if (UnusedAssetsData.Num() == 0)
 	{
-		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No assets found under selected folder"));
+		DebugHeader::ShowNotifyInfo(TEXT("No unused assets found under selected folder"));
 		return;
 	}
 
-	EAppReturnType::Type ReturnResult = DebugHeader::ShowMsgDialog(EAppMsgType::YesNo, TEXT("A total of ") + FString::FromInt(AssetsNames.Num()) + " assets found\nWould you like to proceed", false);
+	TSharedRef<FSuperManagerResultsReport> Report = MakeShared<FSuperManagerResultsReport>();
+	Report->Title = TEXT("Delete Unused Assets");
+	Report->Summary = FString::FromInt(UnusedAssetsData.Num()) + TEXT(" unused assets found under ") + SelectedFolderPath[0];
+	AddAssetsToReport(*Report, UnusedAssetsData);
 
-	if (ReturnResult == EAppReturnType::No)
+	Report->ConfirmLabel = TEXT("Delete ") + FString::FromInt(UnusedAssetsData.Num()) + TEXT(" unused assets");
+	Report->OnConfirm = [UnusedAssetsData]()
+		{
+			int32 NumOfAssetsDeleted = SuperManagerSourceControl::DeleteAssets(UnusedAssetsData);
+
+			if (NumOfAssetsDeleted == 0) { return; }
+
+			DebugHeader::ShowNotifyInfo(TEXT("Successfully deleted " + FString::FromInt(NumOfAssetsDeleted) + " unused assets"));
+		};
+
+	ShowResultsReport(Report);
+}
+
+void FSuperManagerModule::OnDeleteEmptyFoldersButtonCLicked()
+{
+	if (SelectedFolderPath.Num() > 1)
 	{
-		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Operation Canceled"));
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("You can only do this to one folder"));
 		return;
 	}
 
 	FixupRedirectors();
 
-	TArray<FAssetData> UnusedAssetsData;
+	TArray<FString> EmptyFolders;
+	GatherEmptyFolders(SelectedFolderPath[0], EmptyFolders);
 
-	for (const FString& AssetName : AssetsNames)
+	if (EmptyFolders.Num() == 0)
 	{
-		if (AssetName.Contains(TEXT("Collections")) || AssetName.Contains(TEXT("Developers"))) { continue; }
-
-		if (UEditorAssetLibrary::DoesAssetExist(AssetName) == false) { continue; }
-
-		TArray<FString> AssetsReferences = UEditorAssetLibrary::FindPackageReferencersForAsset(AssetName);
-
-		if (AssetsReferences.Num() == 0)
-		{
-			UnusedAssetsData.Add(UEditorAssetLibrary::FindAssetData(AssetName));
-		}
+		DebugHeader::ShowNotifyInfo(TEXT("No empty folders found under selected folder"));
+		return;
 	}
 
-	if (UnusedAssetsData.Num() == 0)
+	// The panel only lays out the rows on screen, so thousands of folders cost no more than ten
+	TSharedRef<FSuperManagerResultsReport> Report = MakeShared<FSuperManagerResultsReport>();
+	Report->Title = TEXT("Delete Empty Folders");
+	Report->Summary = FString::FromInt(EmptyFolders.Num()) + TEXT(" empty folders found under ") + SelectedFolderPath[0];
+
+	for (const FString& EmptyFolder : EmptyFolders)
 	{
-		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No unused assets found under selected folder"), false);
-		return;
+		Report->AddItem(TEXT("Empty folders"), EmptyFolder);
 	}
 
-	int32 NumOfAssetsDeleted = ObjectTools::DeleteAssets(UnusedAssetsData);
-
-	if (NumOfAssetsDeleted == 0) { return; }
+	Report->ConfirmLabel = TEXT("Delete ") + FString::FromInt(EmptyFolders.Num()) + TEXT(" empty folders");
+	Report->OnConfirm = [this, EmptyFolders]()
+		{
+			DeleteEmptyFolders(EmptyFolders);
+		};
 
-	DebugHeader::ShowNotifyInfo(TEXT("Successfully deleted " + FString::FromInt(NumOfAssetsDeleted) + " unused assets"));
+	ShowResultsReport(Report);
 }
 
-void FSuperManagerModule::OnDeleteEmptyFoldersButtonCLicked()
+void FSuperManagerModule::OnDeleteUnusedAssetsAndEmptyFoldersButtonCLicked()
 {
 	if (SelectedFolderPath.Num() > 1)
 	{
@@ -156,59 +274,116 @@ void FSuperManagerModule::OnDeleteEmptyFoldersButtonCLicked()
 		return;
 	}
 
-	TArray<FString> AssetsNames = UEditorAssetLibrary::ListAssets(SelectedFolderPath[0], true, true);
+	FixupRedirectors();
+
+	const FString FolderPath = SelectedFolderPath[0];
 
-	if (AssetsNames.Num() == 0)
+	TArray<FAssetData> UnusedAssetsData;
+	GatherUnusedAssets(FolderPath, UnusedAssetsData);
+
+	TArray<FString> EmptyFolders;
+	GatherEmptyFolders(FolderPath, EmptyFolders);
+
+	if (UnusedAssetsData.Num() == 0 && EmptyFolders.Num() == 0)
 	{
-		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No folders found under selected folder"));
+		DebugHeader::ShowNotifyInfo(TEXT("No unused assets or empty folders found under selected folder"));
 		return;
 	}
 
-	FixupRedirectors();
+	TSharedRef<FSuperManagerResultsReport> Report = MakeShared<FSuperManagerResultsReport>();
+	Report->Title = TEXT("Delete Unused Assets And Empty Folders");
+	Report->Summary = FString::FromInt(UnusedAssetsData.Num()) + TEXT(" unused assets and ") + FString::FromInt(EmptyFolders.Num())
+		+ TEXT(" empty folders found under ") + FolderPath + TEXT("\nFolders emptied by the deletion are removed as well");
+	AddAssetsToReport(*Report, UnusedAssetsData);
 
-	FString EmptyFoldersPathNames;
-	TArray<FString> EmptyFolders;
-	int32 NumberOfFolders = 0;
+	for (const FString& EmptyFolder : EmptyFolders)
+	{
+		Report->AddItem(TEXT("Empty folders"), EmptyFolder);
+	}
+
+	Report->ConfirmLabel = TEXT("Delete all");
+	Report->OnConfirm = [this, UnusedAssetsData, FolderPath]()
+		{
+			int32 NumOfAssetsDeleted = SuperManagerSourceControl::DeleteAssets(UnusedAssetsData);
+
+			if (NumOfAssetsDeleted > 0)
+			{
+				DebugHeader::ShowNotifyInfo(TEXT("Successfully deleted " + FString::FromInt(NumOfAssetsDeleted) + " unused assets"));
+			}
+
+			// Rescan, deleting the assets may have emptied more folders
+			TArray<FString> EmptyFoldersAfterDeletion;
+			GatherEmptyFolders(FolderPath, EmptyFoldersAfterDeletion);
+			DeleteEmptyFolders(EmptyFoldersAfterDeletion);
+		};
+
+	ShowResultsReport(Report);
+}
+
+void FSuperManagerModule::GatherUnusedAssets(const FString& FolderPath, TArray<FAssetData>& OutUnusedAssetsData)
+{
+	OutUnusedAssetsData.Empty();
+
+	TArray<FString> AssetsNames = UEditorAssetLibrary::ListAssets(FolderPath);
 
 	for (const FString& AssetName : AssetsNames)
 	{
 		if (AssetName.Contains(TEXT("Collections")) || AssetName.Contains(TEXT("Developers"))) { continue; }
 
-		if (UEditorAssetLibrary::DoesDirectoryExist(AssetName))
-		{
-			NumberOfFolders++;
-
-			if (UEditorAssetLibrary::DoesDirectoryHaveAssets(AssetName)) { continue; }
+		if (UEditorAssetLibrary::DoesAssetExist(AssetName) == false) { continue; }
 
-			EmptyFolders.Add(AssetName);
+		TArray<FString> AssetsReferences = UEditorAssetLibrary::FindPackageReferencersForAsset(AssetName);
 
-			EmptyFoldersPathNames.Append(AssetName);
-			EmptyFoldersPathNames.Append(TEXT("\n"));
+		if (AssetsReferences.Num() == 0)
+		{
+			OutUnusedAssetsData.Add(UEditorAssetLibrary::FindAssetData(AssetName));
 		}
 	}
+}
 
-	EAppReturnType::Type ReturnResult = DebugHeader::ShowMsgDialog(EAppMsgType::YesNo, TEXT("A total of ") + FString::FromInt(NumberOfFolders) + " folders found\nWould you like to proceed", false);
+void FSuperManagerModule::GatherEmptyFolders(const FString& FolderPath, TArray<FString>& OutEmptyFolders)
+{
+	OutEmptyFolders.Empty();
 
-	if (ReturnResult == EAppReturnType::No)
-	{
-		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Operation Canceled"));
-		return;
-	}
+	TArray<FString> AssetsNames = UEditorAssetLibrary::ListAssets(FolderPath, true, true);
 
-	if (EmptyFolders.Num() == 0)
+	for (const FString& AssetName : AssetsNames)
 	{
-		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No empty folders found under selected folder"), false);
-		return;
-	}
+		if (AssetName.Contains(TEXT("Collections")) || AssetName.Contains(TEXT("Developers"))) { continue; }
 
-	ReturnResult = DebugHeader::ShowMsgDialog(EAppMsgType::OkCancel, TEXT("Empty folder found: \n") + EmptyFoldersPathNames + "\nWould you like to delete all");
+		if (UEditorAssetLibrary::DoesDirectoryExist(AssetName) == false) { continue; }
 
-	if (ReturnResult == EAppReturnType::Cancel)
-	{
-		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Operation Canceled"));
-		return;
+		if (UEditorAssetLibrary::DoesDirectoryHaveAssets(AssetName)) { continue; }
+
+		OutEmptyFolders.Add(AssetName);
 	}
+}
+
+bool FSuperManagerModule::PickSnapshotFile(const FString& DialogTitle, FString& OutFilename)
+{
+	IDesktopPlatform* DesktopPlatform = FDesktopPlatformModule::Get();
+	if (DesktopPlatform == nullptr) { return false; }
 
+	TArray<FString> PickedFilenames;
+
+	const bool bPicked = DesktopPlatform->OpenFileDialog(
+		FSlateApplication::Get().FindBestParentWindowHandleForDialogs(nullptr),
+		DialogTitle,
+		FPaths::ProjectSavedDir() / TEXT("SuperManager") / TEXT("Snapshots"),
+		FString(),
+		TEXT("SuperManager Snapshot (*.smsnap)|*.smsnap"),
+		EFileDialogFlags::None,
+		PickedFilenames);
+
+	if (bPicked == false || PickedFilenames.Num() == 0) { return false; }
+
+	OutFilename = FPaths::ConvertRelativePathToFull(PickedFilenames[0]);
+
+	return true;
+}
+
+void FSuperManagerModule::DeleteEmptyFolders(const TArray<FString>& EmptyFolders)
+{
 	int32 NumOfDeletedFolders = 0;
 
 	for (const FString& FolderName : EmptyFolders)
@@ -225,13 +400,14 @@ void FSuperManagerModule::OnDeleteEmptyFoldersButtonCLicked()
 	if (NumOfDeletedFolders == 0) { return; }
 
 	DebugHeader::ShowNotifyInfo(TEXT("Successfully deleted " + FString::FromInt(NumOfDeletedFolders) + " empty folders"));
-
 }
 
-void FSuperManagerModule::OnDeleteUnusedAssetsAndEmptyFoldersButtonCLicked()
+void FSuperManagerModule::AddAssetsToReport(FSuperManagerResultsReport& Report, const TArray<FAssetData>& AssetsData)
 {
-	OnDeleteUnusedAssetButtonCLicked();
-	OnDeleteEmptyFoldersButtonCLicked();
+	for (const FAssetData& AssetData : AssetsData)
+	{
+		Report.AddItem(AssetData.AssetClassPath.GetAssetName().ToString(), AssetData.AssetName.ToString(), AssetData.GetSoftObjectPath().ToString());
+	}
 }
 
 void FSuperManagerModule::OnAdvancedDeletionButtonCLicked()
@@ -241,6 +417,174 @@ void FSuperManagerModule::OnAdvancedDeletionButtonCLicked()
 	FGlobalTabmanager::Get()->TryInvokeTab(FName("AdvancedDeletion"));
 }
 
+void FSuperManagerModule::OnMeshAuditButtonClicked()
+{
+	FGlobalTabmanager::Get()->TryInvokeTab(FName("MeshAudit"));
+}
+
+void FSuperManagerModule::OnExportSnapshotButtonClicked()
+{
+	const FString SnapshotPath = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("SuperManager") / TEXT("Snapshots") /
+		FApp::GetProjectName() + FDateTime::Now().ToString(TEXT("_%Y%m%d_%H%M%S")) + TEXT(".smsnap"));
+
+	if (FSuperManagerSnapshotFile::Write(*GetProjectAssetSnapshot(), SnapshotPath) == false)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Failed to write snapshot to ") + SnapshotPath);
+		return;
+	}
+
+	DebugHeader::ShowNotifyInfo(TEXT("Snapshot exported to ") + SnapshotPath);
+}
+
+void FSuperManagerModule::OnCompareSnapshotsButtonClicked()
+{
+	FString BaseFilename;
+	FString CompareFilename;
+
+	if (PickSnapshotFile(TEXT("Pick the base snapshot"), BaseFilename) == false) { return; }
+	if (PickSnapshotFile(TEXT("Pick the snapshot to compare against the base"), CompareFilename) == false) { return; }
+
+	FString Error;
+
+	TUniquePtr<FSuperManagerSnapshotFile> BaseFile = FSuperManagerSnapshotFile::Open(BaseFilename, Error);
+	TUniquePtr<FSuperManagerSnapshotFile> CompareFile = BaseFile.IsValid() ? FSuperManagerSnapshotFile::Open(CompareFilename, Error) : nullptr;
+
+	if (CompareFile.IsValid() == false)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, Error);
+		return;
+	}
+
+	const FSuperManagerSnapshotDiff Diff = FSuperManagerSnapshotDiff::Compare(*BaseFile, *CompareFile);
+
+	TSharedRef<FSuperManagerResultsReport> Report = MakeShared<FSuperManagerResultsReport>();
+	Report->Title = TEXT("Snapshot Diff");
+	Report->Summary = FPaths::GetCleanFilename(BaseFilename) + TEXT(" -> ") + FPaths::GetCleanFilename(CompareFilename) + TEXT("\n") + Diff.Describe();
+
+	auto AddEntries = [&Report](const FString& Group, const TArray<FSuperManagerSnapshotDiffEntry>& Entries, bool bExistsNow)
+		{
+			for (const FSuperManagerSnapshotDiffEntry& Entry : Entries)
+			{
+				const FString Text = FString::Printf(TEXT("%s  (%.1f KB -> %.1f KB, hard referencers %d -> %d)"), *Entry.PackageName,
+					Entry.OldDiskSize / 1024.0, Entry.NewDiskSize / 1024.0, Entry.OldHardReferencers, Entry.NewHardReferencers);
+
+				Report->AddItem(Group, Text, bExistsNow ? Entry.PackageName : FString());
+			}
+		};
+
+	AddEntries(TEXT("Added"), Diff.Added, true);
+	AddEntries(TEXT("Removed"), Diff.Removed, false);
+	AddEntries(TEXT("Newly Unused"), Diff.NewlyUnused, true);
+	AddEntries(TEXT("Gained Hard References"), Diff.GainedHardReferences, true);
+	AddEntries(TEXT("Size Changed"), Diff.SizeChanged, true);
+
+	if (Report->Items.Num() == 0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("No differences found in /Game between the two snapshots"));
+		return;
+	}
+
+	ShowResultsReport(Report);
+}
+
+void FSuperManagerModule::OnChunkDuplicationButtonClicked()
+{
+	const FSuperManagerAssetSnapshotRef Snapshot = GetProjectAssetSnapshot();
+
+	TArray<FSuperManagerChunkSeed> Seeds;
+	TBitArray<> PrimaryAssetPackages;
+
+	if (SuperManagerChunkAnalysis::GatherChunkSeeds(*Snapshot, Seeds, PrimaryAssetPackages) == false)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("The asset manager is not initialized, chunks cannot be resolved yet"));
+		return;
+	}
+
+	TArray<TArray<int32>> PackageChunks;
+	SuperManagerChunkAnalysis::ResolveChunks(*Snapshot, Seeds, PrimaryAssetPackages, PackageChunks);
+
+	TArray<FSuperManagerChunkDuplicate> Duplicates;
+	SuperManagerChunkAnalysis::ListDuplicatedPackages(*Snapshot, PackageChunks, Duplicates);
+
+	if (Duplicates.Num() == 0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("No package is cooked into more than one chunk"));
+		return;
+	}
+
+	int64 TotalDuplicatedBytes = 0;
+	for (const FSuperManagerChunkDuplicate& Duplicate : Duplicates)
+	{
+		TotalDuplicatedBytes += Duplicate.GetDuplicatedBytes();
+	}
+
+	TSharedRef<FSuperManagerResultsReport> Report = MakeShared<FSuperManagerResultsReport>();
+	Report->Title = TEXT("Chunk Duplication");
+	Report->Summary = FString::Printf(TEXT("%d packages are cooked into several chunks, %.1f MB of duplicated data"),
+		Duplicates.Num(), TotalDuplicatedBytes / (1024.0 * 1024.0));
+
+	// Grouped by the chunks they are shared between, the candidates for one shared chunk end up together
+	for (const FSuperManagerChunkDuplicate& Duplicate : Duplicates)
+	{
+		const FString Group = TEXT("Chunks ") + FString::JoinBy(Duplicate.ChunkIds, TEXT(", "), [](int32 ChunkId) { return FString::FromInt(ChunkId); });
+		const FString PackageName = Snapshot->GetPackageName(Duplicate.PackageIndex).ToString();
+
+		const FString Text = FString::Printf(TEXT("%s  (%.1f KB x %d chunks, %.1f KB duplicated)"), *PackageName,
+			Duplicate.DiskSize / 1024.0, Duplicate.ChunkIds.Num(), Duplicate.GetDuplicatedBytes() / 1024.0);
+
+		Report->AddItem(Group, Text, PackageName);
+	}
+
+	ShowResultsReport(Report);
+}
+
+void FSuperManagerModule::OnMapLoadClosureButtonClicked()
+{
+	const FSuperManagerAssetSnapshotRef Snapshot = GetProjectAssetSnapshot();
+
+	TArray<FSuperManagerMapLoadClosure> Closures;
+	SuperManagerMapLoadClosure::AnalyseMaps(*Snapshot, 10, Closures);
+
+	if (Closures.Num() == 0)
+	{
+		DebugHeader::ShowNotifyInfo(TEXT("No map found under /Game"));
+		return;
+	}
+
+	auto ToMegabytes = [](int64 Bytes) { return Bytes / (1024.0 * 1024.0); };
+
+	TSharedRef<FSuperManagerResultsReport> Report = MakeShared<FSuperManagerResultsReport>();
+	Report->Title = TEXT("Map Load Closures");
+	Report->Summary = FString::Printf(TEXT("%d maps, heaviest first. Resident sizes are estimated from the registry tags, nothing is loaded"),
+		Closures.Num());
+
+	for (const FSuperManagerMapLoadClosure& Closure : Closures)
+	{
+		const FString MapName = Snapshot->GetPackageName(Closure.MapPackageIndex).ToString();
+
+		const FString Group = FString::Printf(TEXT("%s  (%d packages, %.1f MB on disk, ~%.1f MB resident)"), *MapName,
+			Closure.Total.NumPackages, ToMegabytes(Closure.Total.DiskBytes), ToMegabytes(Closure.Total.ResidentBytes));
+
+		for (const TPair<FName, FSuperManagerMemoryEstimate>& ClassEstimate : Closure.PerClass)
+		{
+			const FString Text = FString::Printf(TEXT("%s: %d packages, %.1f MB on disk, ~%.1f MB resident"), *ClassEstimate.Key.ToString(),
+				ClassEstimate.Value.NumPackages, ToMegabytes(ClassEstimate.Value.DiskBytes), ToMegabytes(ClassEstimate.Value.ResidentBytes));
+
+			Report->AddItem(Group, Text, MapName);
+		}
+
+		for (const TPair<int32, int64>& LargestPackage : Closure.LargestPackages)
+		{
+			const FString PackageName = Snapshot->GetPackageName(LargestPackage.Key).ToString();
+			const FString Text = FString::Printf(TEXT("Largest: %s  (~%.1f MB resident)"), *PackageName, ToMegabytes(LargestPackage.Value));
+
+			Report->AddItem(Group, Text, PackageName);
+		}
+	}
+
+	ShowResultsReport(Report);
+}
+
 void FSuperManagerModule::FixupRedirectors()
 {
 	// Array for fillin object redirectors
@@ -264,29 +608,30 @@ void FSuperManagerModule::FixupRedirectors()
 
 	if (AssetList.Num() == 0) return;
 
-	TArray<FString> ObjectPaths;
-	for (const FAssetData& Asset : AssetList)
-	{
-		ObjectPaths.Add(Asset.GetObjectPathString());
-	}
+	// Load the asset tools module
+	FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
 
-	TArray<UObject*> Objects;
-	const bool bAllowedToPromptToLoadAssets = true;
-	const bool bLoadRedirects = true;
+	// FixupReferencers resaves the referencers and deletes the redirectors itself
+	FSuperManagerBulkSettings Settings;
+	Settings.bSaveModifiedAssets = false;
 
-	if (AssetViewUtils::LoadAssetsIfNeeded(ObjectPaths, Objects, bAllowedToPromptToLoadAssets, bLoadRedirects))
-	{
-		// Transform Objects array to ObjectRedirectors array
-		TArray<UObjectRedirector*> Redirectors;
-		for (UObject* Object : Objects)
+	// Redirectors are loaded and fixed one wave at a time instead of all at once
+	SuperManagerBulk::ProcessWaves(AssetList, [&AssetToolsModule](const TArray<UObject*>& LoadedAssets, TArray<UObject*>& OutModifiedAssets)
 		{
-			Redirectors.Add(CastChecked<UObjectRedirector>(Object));
-		}
-
-		// Load the asset tools module
-		FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
-		AssetToolsModule.Get().FixupReferencers(Redirectors);
-	}
+			TArray<UObjectRedirector*> Redirectors;
+			for (UObject* LoadedAsset : LoadedAssets)
+			{
+				if (UObjectRedirector* Redirector = Cast<UObjectRedirector>(LoadedAsset))
+				{
+					Redirectors.Add(Redirector);
+				}
+			}
+
+			if (Redirectors.Num() == 0) { return; }
+
+			AssetToolsModule.Get().FixupReferencers(Redirectors);
+		},
+		Settings);
 }
 #pragma endregion
 
@@ -309,6 +654,69 @@ TSharedRef<SDockTab> FSuperManagerModule::OnSpawnAdvancedDeletionTab(const FSpaw
 		];
 }
 
+void FSuperManagerModule::RegisterMeshAuditTab()
+{
+	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(FName("MeshAudit"), FOnSpawnTab::CreateRaw(this, &FSuperManagerModule::OnSpawnMeshAuditTab))
+		.SetDisplayName(FText::FromString(TEXT("Static Mesh Audit")))
+		.SetIcon(FSlateIcon(FAppStyle::GetAppStyleSetName(), "ClassIcon.StaticMesh"));
+}
+
+TSharedRef<SDockTab> FSuperManagerModule::OnSpawnMeshAuditTab(const FSpawnTabArgs& SpawnTabArgs)
+{
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	// Tags are all the audit needs, so nothing gets loaded here
+	FARFilter Filter;
+	Filter.bRecursivePaths = true;
+	Filter.PackagePaths.Emplace(*SelectedFolderPath[0]);
+	Filter.ClassPaths.Add(UStaticMesh::StaticClass()->GetClassPathName());
+
+	TArray<FAssetData> StaticMeshesData;
+	AssetRegistry.GetAssets(Filter, StaticMeshesData);
+
+	return
+		SNew(SDockTab).TabRole(ETabRole::NomadTab)
+		[
+			SNew(SMeshAuditWidget)
+				.StaticMeshesData(StaticMeshesData)
+				.CurrentSelectedFolder(SelectedFolderPath[0])
+		];
+}
+
+void FSuperManagerModule::RegisterResultsTab()
+{
+	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(FName("SuperManagerResults"), FOnSpawnTab::CreateRaw(this, &FSuperManagerModule::OnSpawnResultsTab))
+		.SetDisplayName(FText::FromString(TEXT("SuperManager Results")))
+		.SetIcon(FSlateIcon(FAppStyle::GetAppStyleSetName(), "Icons.Info"));
+}
+
+TSharedRef<SDockTab> FSuperManagerModule::OnSpawnResultsTab(const FSpawnTabArgs& SpawnTabArgs)
+{
+	TSharedRef<SSuperManagerResultsPanel> ConstructedResultsPanel = SNew(SSuperManagerResultsPanel)
+		.Report(CurrentResultsReport);
+
+	ResultsPanel = ConstructedResultsPanel;
+
+	return
+		SNew(SDockTab).TabRole(ETabRole::NomadTab)
+		[
+			ConstructedResultsPanel
+		];
+}
+
+void FSuperManagerModule::ShowResultsReport(const TSharedRef<FSuperManagerResultsReport>& Report)
+{
+	CurrentResultsReport = Report;
+
+	if (TSharedPtr<SSuperManagerResultsPanel> ExistingResultsPanel = ResultsPanel.Pin())
+	{
+		ExistingResultsPanel->SetReport(CurrentResultsReport);
+	}
+
+	FGlobalTabmanager::Get()->TryInvokeTab(FName("SuperManagerResults"));
+}
+
 TArray<TSharedPtr<FAssetData>> FSuperManagerModule::GetAllAssetDataUnderSelectedFolder()
 {
 	TArray<TSharedPtr<FAssetData>> AvailableAssetsData;
@@ -342,7 +750,7 @@ bool FSuperManagerModule::DeleteSingleAsset(const FAssetData& AssetDataToDelete)
 	TArray<FAssetData> AssetDataToDeleteArray;
 	AssetDataToDeleteArray.Add(AssetDataToDelete);
 
-	return ObjectTools::DeleteAssets(AssetDataToDeleteArray) > 0;
+	return SuperManagerSourceControl::DeleteAssets(AssetDataToDeleteArray) > 0;
 }
 
 int32 FSuperManagerModule::DeleteMultipleAssets(const TArray<FAssetData>& AssetDataToDeleteArray)
@@ -352,7 +760,129 @@ int32 FSuperManagerModule::DeleteMultipleAssets(const TArray<FAssetData>& AssetD
 		return 0;
 	}
 
-	return ObjectTools::DeleteAssets(AssetDataToDeleteArray);
+	return SuperManagerSourceControl::DeleteAssets(AssetDataToDeleteArray);
+}
+
+int32 FSuperManagerModule::ConsolidateAssets(const FAssetData& SurvivorData, const TArray<FAssetData>& DuplicatesData)
+{
+	UObject* Survivor = SurvivorData.GetAsset();
+	if (Survivor == nullptr) { return 0; }
+
+	TArray<UObject*> Duplicates;
+	TArray<FAssetData> MergedDuplicatesData;
+
+	for (const FAssetData& DuplicateData : DuplicatesData)
+	{
+		// Consolidation only ever merges objects of one class
+		if (DuplicateData.PackageName == SurvivorData.PackageName || DuplicateData.AssetClassPath != SurvivorData.AssetClassPath) { continue; }
+
+		if (UObject* Duplicate = DuplicateData.GetAsset())
+		{
+			Duplicates.Add(Duplicate);
+			MergedDuplicatesData.Add(DuplicateData);
+		}
+	}
+
+	if (Duplicates.Num() == 0) { return 0; }
+
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	// Every package referencing any of the duplicates, once however many of them it references
+	const FSuperManagerAssetSnapshotRef Snapshot = GetProjectAssetSnapshot();
+	TSet<FName> ReferencerPackageNames;
+
+	for (const FAssetData& DuplicateData : MergedDuplicatesData)
+	{
+		TArray<FName> Referencers;
+		Snapshot->ListReferencers(DuplicateData.PackageName, Referencers);
+
+		for (const FName& Referencer : Referencers)
+		{
+			if (FPackageName::IsScriptPackage(Referencer.ToString())) { continue; }
+
+			ReferencerPackageNames.Add(Referencer);
+		}
+	}
+
+	for (const FAssetData& DuplicateData : MergedDuplicatesData)
+	{
+		ReferencerPackageNames.Remove(DuplicateData.PackageName);
+	}
+
+	// Loading any asset of a package loads all of it
+	TArray<FAssetData> ReferencerAssetsData;
+
+	for (const FName& ReferencerPackageName : ReferencerPackageNames)
+	{
+		TArray<FAssetData> PackageAssetsData;
+		AssetRegistry.GetAssetsByPackageName(ReferencerPackageName, PackageAssetsData);
+
+		if (PackageAssetsData.Num() > 0)
+		{
+			ReferencerAssetsData.Add(PackageAssetsData[0]);
+		}
+	}
+
+	// One status query and one checkout for the duplicates and all of their referencers
+	SuperManagerSourceControl::PrepareForRename(MergedDuplicatesData);
+
+	// Each referencing package is loaded, rewritten for all duplicates at once and saved a single time
+	const FSuperManagerBulkStats Stats = SuperManagerBulk::ProcessWaves(ReferencerAssetsData, [Survivor, &Duplicates](const TArray<UObject*>& LoadedAssets, TArray<UObject*>& OutModifiedAssets)
+		{
+			// Only the objects of this wave's packages are searched, not everything in memory
+			TSet<UObject*> ObjectsInWave;
+			TSet<UPackage*> PackagesInWave;
+
+			for (UObject* LoadedAsset : LoadedAssets)
+			{
+				bool bAlreadyInWave = false;
+				PackagesInWave.Add(LoadedAsset->GetPackage(), &bAlreadyInWave);
+
+				if (bAlreadyInWave) { continue; }
+
+				ForEachObjectWithPackage(LoadedAsset->GetPackage(), [&ObjectsInWave](UObject* Object)
+					{
+						ObjectsInWave.Add(Object);
+						return true;
+					});
+			}
+
+			ObjectTools::ForceReplaceReferences(Survivor, Duplicates, ObjectsInWave);
+
+			for (UObject* LoadedAsset : LoadedAssets)
+			{
+				if (LoadedAsset->GetPackage()->IsDirty())
+				{
+					OutModifiedAssets.Add(LoadedAsset);
+				}
+			}
+		});
+
+	DebugHeader::PrintLog(TEXT("Consolidation rewrote referencers: ") + Stats.Describe());
+
+	// Swaps whatever else still holds the duplicates in memory, open editors included, then deletes them
+	const ObjectTools::FConsolidationResults Results = ObjectTools::ConsolidateObjects(Survivor, Duplicates, false);
+
+	// Consolidation leaves a redirector in place of each duplicate; with the referencers already saved they point at
+	// nothing and get deleted, only those still referenced by a package that could not be saved stay behind
+	TArray<UObjectRedirector*> Redirectors;
+
+	for (const FAssetData& DuplicateData : MergedDuplicatesData)
+	{
+		if (UObjectRedirector* Redirector = FindObject<UObjectRedirector>(nullptr, *DuplicateData.GetObjectPathString()))
+		{
+			Redirectors.Add(Redirector);
+		}
+	}
+
+	if (Redirectors.Num() > 0)
+	{
+		FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
+		AssetToolsModule.Get().FixupReferencers(Redirectors, false);
+	}
+
+	return Duplicates.Num() - Results.FailedConsolidationObjs.Num();
 }
 
 void FSuperManagerModule::ListUnusedAssets(const TArray<TSharedPtr<FAssetData>>& AssetsDataToFilter, TArray<TSharedPtr<FAssetData>>& OutUnusedAssetData)
@@ -410,6 +940,134 @@ void FSuperManagerModule::ListSameNameAssets(const TArray<TSharedPtr<FAssetData>
 
 }
 
+int32 FSuperManagerModule::ListSimilarTextures(const TArray<TSharedPtr<FAssetData>>& AssetsDataToFilter, TArray<TSharedPtr<FAssetData>>& OutSimilarTextureData)
+{
+	// Bits out of 64 two hashes may differ by; catches re-imports, resizes and recompressions, not merely similar art
+	constexpr int32 MaxHashDistance = 6;
+
+	OutSimilarTextureData.Empty();
+
+	TArray<TSharedPtr<FAssetData>> TexturesDataPtrs;
+	TArray<FAssetData> TexturesData;
+
+	for (const TSharedPtr<FAssetData>& DataPtr : AssetsDataToFilter)
+	{
+		if (DataPtr->IsInstanceOf(UTexture2D::StaticClass()) == false) { continue; }
+
+		FString AssetPath = DataPtr->GetSoftObjectPath().ToString();
+		if (AssetPath.Contains(TEXT("Collections")) || AssetPath.Contains(TEXT("Developers"))) { continue; }
+
+		TexturesDataPtrs.Add(DataPtr);
+		TexturesData.Add(*DataPtr);
+	}
+
+	TArray<TOptional<FSuperManagerTextureHash>> Hashes;
+	TextureHashCache.HashTextures(TexturesData, Hashes);
+
+	TArray<uint64> PerceptualHashes;
+	TArray<uint64> DifferenceHashes;
+	TArray<int32> HashedTextureIndices;
+
+	for (int32 TextureIndex = 0; TextureIndex < Hashes.Num(); TextureIndex++)
+	{
+		if (Hashes[TextureIndex].IsSet() == false) { continue; }
+
+		PerceptualHashes.Add(Hashes[TextureIndex]->PerceptualHash);
+		DifferenceHashes.Add(Hashes[TextureIndex]->DifferenceHash);
+		HashedTextureIndices.Add(TextureIndex);
+	}
+
+	// The DCT hash finds the candidates, the gradient hash has to agree before two textures are grouped
+	TArray<TArray<int32>> Groups;
+	SuperManagerSimilarity::GroupByHammingDistance(PerceptualHashes, MaxHashDistance,
+		[&DifferenceHashes](int32 A, int32 B)
+		{
+			return SuperManagerSimilarity::HammingDistance(DifferenceHashes[A], DifferenceHashes[B]) <= MaxHashDistance;
+		},
+		Groups);
+
+	// Members of a group stay next to each other in the list
+	for (const TArray<int32>& Group : Groups)
+	{
+		for (int32 HashIndex : Group)
+		{
+			OutSimilarTextureData.Add(TexturesDataPtrs[HashedTextureIndices[HashIndex]]);
+		}
+	}
+
+	return Groups.Num();
+}
+
+int32 FSuperManagerModule::ListSimilarStaticMeshes(const TArray<TSharedPtr<FAssetData>>& AssetsDataToFilter, TArray<TSharedPtr<FAssetData>>& OutSimilarMeshData)
+{
+	OutSimilarMeshData.Empty();
+
+	TArray<TSharedPtr<FAssetData>> MeshesDataPtrs;
+	TArray<FAssetData> MeshesData;
+
+	for (const TSharedPtr<FAssetData>& DataPtr : AssetsDataToFilter)
+	{
+		if (DataPtr->IsInstanceOf(UStaticMesh::StaticClass()) == false) { continue; }
+
+		FString AssetPath = DataPtr->GetSoftObjectPath().ToString();
+		if (AssetPath.Contains(TEXT("Collections")) || AssetPath.Contains(TEXT("Developers"))) { continue; }
+
+		MeshesDataPtrs.Add(DataPtr);
+		MeshesData.Add(*DataPtr);
+	}
+
+	TArray<TOptional<FSuperManagerMeshFingerprint>> Fingerprints;
+	SuperManagerMeshSimilarity::FingerprintStaticMeshes(MeshesData, Fingerprints);
+
+	TArray<TArray<int32>> Groups;
+	SuperManagerMeshSimilarity::GroupSimilarMeshes(Fingerprints, Groups);
+
+	// Members of a group stay next to each other in the list, ready to be consolidated
+	for (const TArray<int32>& Group : Groups)
+	{
+		for (int32 MeshIndex : Group)
+		{
+			OutSimilarMeshData.Add(MeshesDataPtrs[MeshIndex]);
+		}
+	}
+
+	return Groups.Num();
+}
+
+int32 FSuperManagerModule::ListSimilarNameAssets(const TArray<TSharedPtr<FAssetData>>& AssetsDataToFilter, TArray<TSharedPtr<FAssetData>>& OutSimilarNameAssetData)
+{
+	OutSimilarNameAssetData.Empty();
+
+	TArray<FString> KnownPrefixes;
+	UQuickAssetAction::GetKnownPrefixes(KnownPrefixes);
+
+	TArray<TSharedPtr<FAssetData>> NamedAssetsData;
+	TArray<FString> NormalizedNames;
+
+	for (const TSharedPtr<FAssetData>& DataPtr : AssetsDataToFilter)
+	{
+		FString AssetPath = DataPtr->GetSoftObjectPath().ToString();
+		if (AssetPath.Contains(TEXT("Collections")) || AssetPath.Contains(TEXT("Developers"))) { continue; }
+
+		NamedAssetsData.Add(DataPtr);
+		NormalizedNames.Add(SuperManagerNameSimilarity::NormalizeName(DataPtr->AssetName.ToString(), KnownPrefixes));
+	}
+
+	TArray<TArray<int32>> Groups;
+	SuperManagerNameSimilarity::GroupSimilarNames(NormalizedNames, Groups);
+
+	// Members of a group stay next to each other in the list
+	for (const TArray<int32>& Group : Groups)
+	{
+		for (int32 NameIndex : Group)
+		{
+			OutSimilarNameAssetData.Add(NamedAssetsData[NameIndex]);
+		}
+	}
+
+	return Groups.Num();
+}
+
 void FSuperManagerModule::SyncCBToClickedAsset(const FString& ClickedAssetPath)
 {
 	TArray<FString> AssetsPathToSyncArray;
@@ -418,6 +1076,142 @@ void FSuperManagerModule::SyncCBToClickedAsset(const FString& ClickedAssetPath)
 	UEditorAssetLibrary::SyncBrowserToObjects(AssetsPathToSyncArray);
 }
 
+FSuperManagerAssetSnapshotRef FSuperManagerModule::GetProjectAssetSnapshot()
+{
+	if (ProjectAssetSnapshot.IsValid() == false)
+	{
+		ProjectAssetSnapshot = FSuperManagerAssetSnapshot::Capture(TArray<FString>());
+	}
+
+	return ProjectAssetSnapshot.ToSharedRef();
+}
+
+void FSuperManagerModule::RegisterAssetRegistryCallbacks()
+{
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	// Saving an asset updates its dependencies, so updates invalidate just like adds and removes
+	AssetRegistry.OnAssetAdded().AddRaw(this, &FSuperManagerModule::OnAssetAddedOrRemoved);
+	AssetRegistry.OnAssetRemoved().AddRaw(this, &FSuperManagerModule::OnAssetAddedOrRemoved);
+	AssetRegistry.OnAssetUpdated().AddRaw(this, &FSuperManagerModule::OnAssetAddedOrRemoved);
+	AssetRegistry.OnAssetRenamed().AddRaw(this, &FSuperManagerModule::OnAssetRenamed);
+}
+
+void FSuperManagerModule::UnregisterAssetRegistryCallbacks()
+{
+	if (FModuleManager::Get().IsModuleLoaded(TEXT("AssetRegistry")) == false) { return; }
+
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::GetModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	AssetRegistry.OnAssetAdded().RemoveAll(this);
+	AssetRegistry.OnAssetRemoved().RemoveAll(this);
+	AssetRegistry.OnAssetUpdated().RemoveAll(this);
+	AssetRegistry.OnAssetRenamed().RemoveAll(this);
+	AssetRegistry.OnFilesLoaded().RemoveAll(this);
+}
+
+void FSuperManagerModule::OnAssetAddedOrRemoved(const FAssetData& AssetData)
+{
+	ProjectAssetSnapshot.Reset();
+
+	AssetStatusCache.UpdatePackage(AssetData.PackageName);
+}
+
+void FSuperManagerModule::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	ProjectAssetSnapshot.Reset();
+
+	AssetStatusCache.UpdatePackage(FName(*FPackageName::ObjectPathToPackageName(OldObjectPath)));
+	AssetStatusCache.UpdatePackage(AssetData.PackageName);
+}
+
+#pragma endregion
+
+#pragma region ContentBrowserAssetStatus
+void FSuperManagerModule::InitAssetStatusCache()
+{
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	// Building from a half scanned registry would flag everything not discovered yet
+	if (AssetRegistry.IsLoadingAssets())
+	{
+		AssetRegistry.OnFilesLoaded().AddRaw(this, &FSuperManagerModule::BuildAssetStatusCache);
+		return;
+	}
+
+	BuildAssetStatusCache();
+}
+
+void FSuperManagerModule::BuildAssetStatusCache()
+{
+	AssetStatusCache.Build(*GetProjectAssetSnapshot());
+}
+
+void FSuperManagerModule::RegisterAssetStatusIndicators()
+{
+	FContentBrowserModule& ContentBrowserModule = FModuleManager::LoadModuleChecked<FContentBrowserModule>(TEXT("ContentBrowser"));
+
+	AssetStatusIndicatorsHandle = ContentBrowserModule.AddAssetViewExtraStateGenerator(FAssetViewExtraStateGenerator(
+		FOnGenerateAssetViewExtraStateIndicators::CreateRaw(this, &FSuperManagerModule::OnGenerateAssetStatusIcon),
+		FOnGenerateAssetViewExtraStateIndicators::CreateRaw(this, &FSuperManagerModule::OnGenerateAssetStatusToolTip)));
+}
+
+void FSuperManagerModule::UnregisterAssetStatusIndicators()
+{
+	if (AssetStatusIndicatorsHandle.IsValid() == false) { return; }
+
+	if (FContentBrowserModule* ContentBrowserModule = FModuleManager::GetModulePtr<FContentBrowserModule>(TEXT("ContentBrowser")))
+	{
+		ContentBrowserModule->RemoveAssetViewExtraStateGenerator(AssetStatusIndicatorsHandle);
+	}
+
+	AssetStatusIndicatorsHandle.Reset();
+}
+
+TSharedRef<SWidget> FSuperManagerModule::OnGenerateAssetStatusIcon(const FAssetData& AssetData)
+{
+	const FName PackageName = AssetData.PackageName;
+
+	// Bound attributes read the cache when painted, so tiles follow the cache without being regenerated
+	return SNew(STextBlock)
+		.Font(FCoreStyle::GetDefaultFontStyle("Bold", 7))
+		.Text_Lambda([this, PackageName]()
+			{
+				FSuperManagerAssetStatus Status;
+				if (AssetStatusCache.GetStatus(PackageName, Status) == false) { return FText::GetEmpty(); }
+
+				return FText::FromString(Status.bUnused ? TEXT("Unused") : Status.bUnreachable ? TEXT("Unreachable") : TEXT(""));
+			})
+		.ColorAndOpacity_Lambda([this, PackageName]()
+			{
+				FSuperManagerAssetStatus Status;
+				AssetStatusCache.GetStatus(PackageName, Status);
+
+				return FSlateColor(Status.bUnused ? FLinearColor::Red : FLinearColor(1.0f, 0.5f, 0.0f));
+			});
+}
+
+TSharedRef<SWidget> FSuperManagerModule::OnGenerateAssetStatusToolTip(const FAssetData& AssetData)
+{
+	const FName PackageName = AssetData.PackageName;
+
+	return SNew(STextBlock)
+		.Text_Lambda([this, PackageName]()
+			{
+				FSuperManagerAssetStatus Status;
+				if (AssetStatusCache.GetStatus(PackageName, Status) == false) { return FText::GetEmpty(); }
+
+				FString StatusText = TEXT("Referenced by ") + FString::FromInt(Status.NumReferencers) + TEXT(" packages");
+
+				if (Status.bUnused) { StatusText += TEXT(", unused"); }
+				if (Status.bUnreachable) { StatusText += TEXT(", unreachable from any map or primary asset"); }
+
+				return FText::FromString(StatusText);
+			});
+}
 #pragma endregion
 
 #undef LOCTEXT_NAMESPACE
@@ -0,0 +1,750 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Tests/SuperManagerTestAsset.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "SuperManager.h"
+#include "AssetAnalysis/AssetQuery.h"
+#include "AssetAnalysis/AssetSnapshot.h"
+#include "AssetAnalysis/AssetStatusCache.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "EditorAssetLibrary.h"
+#include "Engine/AssetManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+/**
+ * Differential tests: every snapshot and status cache query has to give exactly what the registry walks
+ * in FSuperManagerModule give (FindPackageReferencersForAsset, DoesDirectoryHaveAssets...) on the same content.
+ * Each seed generates a random tree of folders and assets wired with hard and soft references, some of them
+ * primary assets so the asset manager adds management edges, saves it under
+ * a scratch folder, runs both implementations and, on a divergence, shrinks the tree to the smallest one that
+ * still diverges so the log holds a reproduction rather than a random project.
+ *
+ * Run with: Automation RunTests SuperManager.Analysis.Differential ; -SuperManagerDiffSeeds=N runs N seeds.
+ *
+ * The asset query the differential trees are filtered with has its own tests at the end of the file: what the parser
+ * makes of each term and in which order a compiled query runs its stages.
+ * Run with: Automation RunTests SuperManager.Analysis.Query
+ */
+
+namespace
+{
+	const TCHAR* DiffTestRoot = TEXT("/Game/__SuperManagerDiffTest");
+
+	constexpr int32 DefaultNumSeeds = 8;
+
+	// Every shrink step saves and scans a whole tree, so the search is capped
+	constexpr int32 MaxShrinkRuns = 48;
+
+	struct FDiffTreeNode
+	{
+		/** Index into FDiffTree::Folders, INDEX_NONE for the run root */
+		int32 Folder = INDEX_NONE;
+		FString Name;
+		TArray<int32> HardReferences;
+		TArray<int32> SoftReferences;
+
+		/** References are dropped and re-saved after the first comparison, to exercise incremental updates */
+		bool bClearedLater = false;
+
+		/** Registered with the asset manager, which then manages the asset and everything it references */
+		bool bPrimary = false;
+	};
+
+	struct FDiffTree
+	{
+		/** Paths relative to the run root, parents before children */
+		TArray<FString> Folders;
+		TArray<FDiffTreeNode> Nodes;
+
+		FString GetFolderPath(const FString& RunRoot, int32 Folder) const
+		{
+			return Folder == INDEX_NONE ? RunRoot : RunRoot / Folders[Folder];
+		}
+
+		bool IsFolderRemovable(int32 FolderIndex) const
+		{
+			for (const FDiffTreeNode& Node : Nodes)
+			{
+				if (Node.Folder == FolderIndex) { return false; }
+			}
+
+			for (const FString& Folder : Folders)
+			{
+				if (Folder.StartsWith(Folders[FolderIndex] + TEXT("/"))) { return false; }
+			}
+
+			return true;
+		}
+
+		FDiffTree WithoutNode(int32 NodeIndex) const
+		{
+			FDiffTree Smaller = *this;
+			Smaller.Nodes.RemoveAt(NodeIndex);
+
+			auto RemapReferences = [NodeIndex](TArray<int32>& References)
+			{
+				References.Remove(NodeIndex);
+				for (int32& Reference : References)
+				{
+					if (Reference > NodeIndex) { Reference--; }
+				}
+			};
+
+			for (FDiffTreeNode& Node : Smaller.Nodes)
+			{
+				RemapReferences(Node.HardReferences);
+				RemapReferences(Node.SoftReferences);
+			}
+
+			return Smaller;
+		}
+
+		FDiffTree WithoutFolder(int32 FolderIndex) const
+		{
+			FDiffTree Smaller = *this;
+			Smaller.Folders.RemoveAt(FolderIndex);
+
+			for (FDiffTreeNode& Node : Smaller.Nodes)
+			{
+				if (Node.Folder > FolderIndex) { Node.Folder--; }
+			}
+
+			return Smaller;
+		}
+
+		FString Describe() const
+		{
+			FString Description;
+
+			for (const FString& Folder : Folders)
+			{
+				Description += TEXT("\n  folder ") + Folder;
+			}
+
+			for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); NodeIndex++)
+			{
+				const FDiffTreeNode& Node = Nodes[NodeIndex];
+
+				auto JoinIndices = [](const TArray<int32>& Indices)
+				{
+					return FString::JoinBy(Indices, TEXT(", "), [](int32 Index) { return FString::Printf(TEXT("#%d"), Index); });
+				};
+
+				Description += FString::Printf(TEXT("\n  #%d %s hard {%s} soft {%s}%s%s"),
+					NodeIndex,
+					*(GetFolderPath(TEXT("."), Node.Folder) / Node.Name),
+					*JoinIndices(Node.HardReferences),
+					*JoinIndices(Node.SoftReferences),
+					Node.bPrimary ? TEXT(" primary") : TEXT(""),
+					Node.bClearedLater ? TEXT(" cleared after the first pass") : TEXT(""));
+			}
+
+			return Description;
+		}
+	};
+
+	struct FDivergence
+	{
+		FString Check;
+		FString Subject;
+		TArray<FString> SlowOnly;
+		TArray<FString> FastOnly;
+
+		FString ToString() const
+		{
+			return FString::Printf(TEXT("[%s] %s: only the slow path gives {%s}, only the fast path gives {%s}"),
+				*Check, *Subject, *FString::Join(SlowOnly, TEXT(", ")), *FString::Join(FastOnly, TEXT(", ")));
+		}
+	};
+
+	FDiffTree GenerateTree(int32 Seed)
+	{
+		FRandomStream Random(Seed);
+		FDiffTree Tree;
+
+		const int32 NumFolders = Random.RandRange(2, 8);
+		for (int32 FolderIndex = 0; FolderIndex < NumFolders; FolderIndex++)
+		{
+			const int32 Parent = Random.RandRange(INDEX_NONE, FolderIndex - 1);
+			const FString FolderName = FString::Printf(TEXT("F%d"), FolderIndex);
+
+			Tree.Folders.Add(Parent == INDEX_NONE ? FolderName : Tree.Folders[Parent] / FolderName);
+		}
+
+		// A small pool makes the same name turn up in several folders
+		static const TCHAR* NamePool[] = { TEXT("Rock"), TEXT("Door"), TEXT("Lamp"), TEXT("Crate"), TEXT("Rock_1"), TEXT("Fence") };
+
+		const int32 NumNodes = Random.RandRange(4, 20);
+		TSet<FString> UsedPaths;
+
+		for (int32 Attempt = 0; Tree.Nodes.Num() < NumNodes && Attempt < NumNodes * 4; Attempt++)
+		{
+			FDiffTreeNode Node;
+			Node.Folder = Random.RandRange(INDEX_NONE, NumFolders - 1);
+			Node.Name = NamePool[Random.RandRange(0, UE_ARRAY_COUNT(NamePool) - 1)];
+			Node.bClearedLater = Random.FRand() < 0.2f;
+			Node.bPrimary = Random.FRand() < 0.25f;
+
+			bool bAlreadyUsed = false;
+			UsedPaths.Add(Tree.GetFolderPath(TEXT(""), Node.Folder) / Node.Name, &bAlreadyUsed);
+
+			if (bAlreadyUsed) { continue; }
+
+			Tree.Nodes.Add(MoveTemp(Node));
+		}
+
+		for (int32 NodeIndex = 0; NodeIndex < Tree.Nodes.Num(); NodeIndex++)
+		{
+			const int32 NumHardReferences = Random.RandRange(0, 2);
+			const int32 NumSoftReferences = Random.RandRange(0, 1);
+
+			for (int32 ReferenceIndex = 0; ReferenceIndex < NumHardReferences + NumSoftReferences; ReferenceIndex++)
+			{
+				const int32 Target = Random.RandRange(0, Tree.Nodes.Num() - 1);
+				if (Target == NodeIndex) { continue; }
+
+				TArray<int32>& References = ReferenceIndex < NumHardReferences ? Tree.Nodes[NodeIndex].HardReferences : Tree.Nodes[NodeIndex].SoftReferences;
+				References.AddUnique(Target);
+			}
+		}
+
+		return Tree;
+	}
+
+	bool SaveAndRescan(const TArray<USuperManagerTestAsset*>& Assets)
+	{
+		TArray<FString> Filenames;
+
+		for (USuperManagerTestAsset* Asset : Assets)
+		{
+			UPackage* Package = Asset->GetPackage();
+			const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+
+			FSavePackageArgs SaveArgs;
+			SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+
+			if (UPackage::SavePackage(Package, Asset, *Filename, SaveArgs) == false) { return false; }
+
+			Filenames.Add(Filename);
+		}
+
+		// Dependencies only reach the registry from the saved files
+		IAssetRegistry& AssetRegistry =
+			FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+		AssetRegistry.ScanFilesSynchronous(Filenames, true);
+
+		return true;
+	}
+
+	bool BuildTree(const FDiffTree& Tree, const FString& RunRoot, TArray<USuperManagerTestAsset*>& OutAssets)
+	{
+		OutAssets.Empty();
+
+		UEditorAssetLibrary::MakeDirectory(RunRoot);
+		for (const FString& Folder : Tree.Folders)
+		{
+			UEditorAssetLibrary::MakeDirectory(RunRoot / Folder);
+		}
+
+		for (const FDiffTreeNode& Node : Tree.Nodes)
+		{
+			UPackage* Package = CreatePackage(*(Tree.GetFolderPath(RunRoot, Node.Folder) / Node.Name));
+			USuperManagerTestAsset* Asset = NewObject<USuperManagerTestAsset>(Package, *Node.Name, RF_Public | RF_Standalone);
+			Asset->bPrimaryAsset = Node.bPrimary;
+
+			FAssetRegistryModule::AssetCreated(Asset);
+			OutAssets.Add(Asset);
+		}
+
+		for (int32 NodeIndex = 0; NodeIndex < Tree.Nodes.Num(); NodeIndex++)
+		{
+			for (int32 Target : Tree.Nodes[NodeIndex].HardReferences)
+			{
+				OutAssets[NodeIndex]->HardReferences.Add(OutAssets[Target]);
+			}
+
+			for (int32 Target : Tree.Nodes[NodeIndex].SoftReferences)
+			{
+				OutAssets[NodeIndex]->SoftReferences.Add(TSoftObjectPtr<UObject>(OutAssets[Target]));
+			}
+		}
+
+		return SaveAndRescan(OutAssets);
+	}
+
+	/** Management edges only exist for scanned primary asset types and are only rebuilt on request, as a cook would */
+	void RefreshManagementDatabase(const FString& RunRoot)
+	{
+		UAssetManager& AssetManager = UAssetManager::Get();
+
+		AssetManager.ScanPathForPrimaryAssets(USuperManagerTestAsset::GetTestPrimaryAssetType(), RunRoot, USuperManagerTestAsset::StaticClass(), false, false, true);
+		AssetManager.UpdateManagementDatabase(true);
+	}
+
+	void CompareSets(const FString& Check, const FString& Subject, TArray<FString> Slow, TArray<FString> Fast, TArray<FDivergence>& OutDivergences)
+	{
+		FDivergence Divergence;
+		Divergence.Check = Check;
+		Divergence.Subject = Subject;
+
+		for (const FString& Item : Slow)
+		{
+			if (Fast.Contains(Item) == false) { Divergence.SlowOnly.Add(Item); }
+		}
+
+		for (const FString& Item : Fast)
+		{
+			if (Slow.Contains(Item) == false) { Divergence.FastOnly.Add(Item); }
+		}
+
+		// Duplicates matter too: the same referencer twice is as wrong as a missing one
+		if (Divergence.SlowOnly.Num() == 0 && Divergence.FastOnly.Num() == 0 && Slow.Num() == Fast.Num()) { return; }
+
+		OutDivergences.Add(MoveTemp(Divergence));
+	}
+
+	TArray<FString> ToObjectPaths(const TArray<FAssetData>& AssetsData)
+	{
+		TArray<FString> ObjectPaths;
+		for (const FAssetData& AssetData : AssetsData)
+		{
+			ObjectPaths.Add(AssetData.GetSoftObjectPath().ToString());
+		}
+
+		return ObjectPaths;
+	}
+
+	void CompareImplementations(const FString& Phase, const FString& RunRoot, const TArray<USuperManagerTestAsset*>& Assets, const FSuperManagerAssetStatusCache& StatusCache, TArray<FDivergence>& OutDivergences)
+	{
+		FSuperManagerModule& SuperManagerModule =
+			FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+
+		const FSuperManagerAssetSnapshotRef Snapshot = FSuperManagerAssetSnapshot::Capture({ RunRoot });
+
+		for (USuperManagerTestAsset* Asset : Assets)
+		{
+			const FString ObjectPath = FSoftObjectPath(Asset).ToString();
+			const FName PackageName = Asset->GetPackage()->GetFName();
+
+			const TArray<FString> SlowReferencers = UEditorAssetLibrary::FindPackageReferencersForAsset(ObjectPath);
+
+			TArray<FName> FastReferencerNames;
+			Snapshot->ListReferencers(PackageName, FastReferencerNames);
+
+			TArray<FString> FastReferencers;
+			for (FName ReferencerName : FastReferencerNames)
+			{
+				FastReferencers.Add(ReferencerName.ToString());
+			}
+
+			CompareSets(Phase + TEXT(" snapshot referencers"), ObjectPath, SlowReferencers, FastReferencers, OutDivergences);
+
+			FSuperManagerAssetStatus Status;
+			const bool bKnown = StatusCache.GetStatus(PackageName, Status);
+
+			if (bKnown == false || Status.NumReferencers != SlowReferencers.Num())
+			{
+				FDivergence Divergence;
+				Divergence.Check = Phase + TEXT(" status cache referencer count");
+				Divergence.Subject = ObjectPath;
+				Divergence.SlowOnly.Add(FString::FromInt(SlowReferencers.Num()));
+				Divergence.FastOnly.Add(bKnown ? FString::FromInt(Status.NumReferencers) : TEXT("unknown package"));
+
+				OutDivergences.Add(MoveTemp(Divergence));
+			}
+		}
+
+		TArray<FAssetData> SlowUnused;
+		SuperManagerModule.GatherUnusedAssets(RunRoot, SlowUnused);
+
+		TArray<FAssetData> FastUnused;
+		Snapshot->ListUnusedAssets(FastUnused);
+
+		CompareSets(Phase + TEXT(" unused assets"), RunRoot, ToObjectPaths(SlowUnused), ToObjectPaths(FastUnused), OutDivergences);
+
+		// Same input the Advanced Deletion tab builds for its list
+		TArray<TSharedPtr<FAssetData>> AssetsUnderRoot;
+		for (const FString& AssetPath : UEditorAssetLibrary::ListAssets(RunRoot))
+		{
+			AssetsUnderRoot.Add(MakeShared<FAssetData>(UEditorAssetLibrary::FindAssetData(AssetPath)));
+		}
+
+		TArray<TSharedPtr<FAssetData>> SlowSameNamePtrs;
+		SuperManagerModule.ListSameNameAssets(AssetsUnderRoot, SlowSameNamePtrs);
+
+		TArray<FAssetData> SlowSameName;
+		for (const TSharedPtr<FAssetData>& DataPtr : SlowSameNamePtrs)
+		{
+			SlowSameName.Add(*DataPtr);
+		}
+
+		TArray<FAssetData> FastSameName;
+		Snapshot->ListSameNameAssets(FastSameName);
+
+		CompareSets(Phase + TEXT(" same name assets"), RunRoot, ToObjectPaths(SlowSameName), ToObjectPaths(FastSameName), OutDivergences);
+
+		// ListAssets hands folders back with a trailing slash
+		TArray<FString> SlowEmptyFolders;
+		SuperManagerModule.GatherEmptyFolders(RunRoot, SlowEmptyFolders);
+		for (FString& EmptyFolder : SlowEmptyFolders)
+		{
+			EmptyFolder.RemoveFromEnd(TEXT("/"));
+		}
+
+		TArray<FString> FastEmptyFolders;
+		Snapshot->ListEmptyFolders(RunRoot, FastEmptyFolders);
+
+		CompareSets(Phase + TEXT(" empty folders"), RunRoot, SlowEmptyFolders, FastEmptyFolders, OutDivergences);
+
+		// The cache patches its edges one package at a time, a fresh snapshot walks every edge again
+		TArray<FAssetData> FreshUnreachable;
+		Snapshot->ListUnreachableAssets(FreshUnreachable);
+
+		TArray<FString> CachedUnreachable;
+		for (USuperManagerTestAsset* Asset : Assets)
+		{
+			FSuperManagerAssetStatus Status;
+			if (StatusCache.GetStatus(Asset->GetPackage()->GetFName(), Status) && Status.bUnreachable)
+			{
+				CachedUnreachable.Add(FSoftObjectPath(Asset).ToString());
+			}
+		}
+
+		CompareSets(Phase + TEXT(" unreachable assets"), RunRoot, ToObjectPaths(FreshUnreachable), CachedUnreachable, OutDivergences);
+	}
+
+	/** Builds the tree under RunRoot, compares before and after the incremental edits, then deletes it again */
+	bool ExecuteTree(const FDiffTree& Tree, const FString& RunRoot, TArray<FDivergence>& OutDivergences)
+	{
+		OutDivergences.Empty();
+
+		if (UEditorAssetLibrary::DoesDirectoryExist(RunRoot))
+		{
+			UEditorAssetLibrary::DeleteDirectory(RunRoot);
+		}
+
+		TArray<USuperManagerTestAsset*> Assets;
+		bool bSaved = BuildTree(Tree, RunRoot, Assets);
+
+		if (bSaved)
+		{
+			RefreshManagementDatabase(RunRoot);
+
+			// Built the way the module builds its own: from a snapshot of the whole project
+			FSuperManagerAssetStatusCache StatusCache;
+			StatusCache.Build(*FSuperManagerAssetSnapshot::Capture(TArray<FString>()));
+
+			CompareImplementations(TEXT("Initial"), RunRoot, Assets, StatusCache, OutDivergences);
+
+			TArray<USuperManagerTestAsset*> ChangedAssets;
+			for (int32 NodeIndex = 0; NodeIndex < Tree.Nodes.Num(); NodeIndex++)
+			{
+				if (Tree.Nodes[NodeIndex].bClearedLater == false) { continue; }
+
+				Assets[NodeIndex]->HardReferences.Empty();
+				Assets[NodeIndex]->SoftReferences.Empty();
+				ChangedAssets.Add(Assets[NodeIndex]);
+			}
+
+			if (ChangedAssets.Num() > 0)
+			{
+				bSaved = SaveAndRescan(ChangedAssets);
+				RefreshManagementDatabase(RunRoot);
+
+				for (USuperManagerTestAsset* ChangedAsset : ChangedAssets)
+				{
+					StatusCache.UpdatePackage(ChangedAsset->GetPackage()->GetFName());
+				}
+
+				StatusCache.FlushReachabilityRefresh();
+
+				if (bSaved)
+				{
+					CompareImplementations(TEXT("After edits"), RunRoot, Assets, StatusCache, OutDivergences);
+				}
+			}
+		}
+
+		UAssetManager::Get().RemoveScanPathsForPrimaryAssets(USuperManagerTestAsset::GetTestPrimaryAssetType(), { RunRoot }, USuperManagerTestAsset::StaticClass(), false, false);
+		UEditorAssetLibrary::DeleteDirectory(RunRoot);
+
+		return bSaved;
+	}
+
+	/** Greedily drops assets, references, primary flags and folders for as long as the tree still fails the same check */
+	FDiffTree ShrinkTree(const FDiffTree& Tree, int32 Seed, const FString& Check)
+	{
+		FDiffTree Smallest = Tree;
+		int32 NumRuns = 0;
+
+		auto StillDiverges = [Seed, &Check, &NumRuns](const FDiffTree& Candidate)
+		{
+			const FString RunRoot = FString(DiffTestRoot) / FString::Printf(TEXT("Seed%d_Shrink%d"), Seed, NumRuns++);
+
+			TArray<FDivergence> Divergences;
+			if (ExecuteTree(Candidate, RunRoot, Divergences) == false) { return false; }
+
+			return Divergences.ContainsByPredicate([&Check](const FDivergence& Divergence) { return Divergence.Check == Check; });
+		};
+
+		bool bShrunk = true;
+		while (bShrunk && NumRuns < MaxShrinkRuns)
+		{
+			bShrunk = false;
+
+			for (int32 NodeIndex = Smallest.Nodes.Num() - 1; NodeIndex >= 0 && NumRuns < MaxShrinkRuns; NodeIndex--)
+			{
+				FDiffTree Candidate = Smallest.WithoutNode(NodeIndex);
+				if (StillDiverges(Candidate) == false) { continue; }
+
+				Smallest = MoveTemp(Candidate);
+				bShrunk = true;
+			}
+
+			for (int32 NodeIndex = 0; NodeIndex < Smallest.Nodes.Num() && NumRuns < MaxShrinkRuns; NodeIndex++)
+			{
+				for (bool bSoft : { false, true })
+				{
+					for (int32 ReferenceIndex = (bSoft ? Smallest.Nodes[NodeIndex].SoftReferences : Smallest.Nodes[NodeIndex].HardReferences).Num() - 1; ReferenceIndex >= 0 && NumRuns < MaxShrinkRuns; ReferenceIndex--)
+					{
+						FDiffTree Candidate = Smallest;
+						(bSoft ? Candidate.Nodes[NodeIndex].SoftReferences : Candidate.Nodes[NodeIndex].HardReferences).RemoveAt(ReferenceIndex);
+
+						if (StillDiverges(Candidate) == false) { continue; }
+
+						Smallest = MoveTemp(Candidate);
+						bShrunk = true;
+					}
+				}
+			}
+
+			for (int32 NodeIndex = 0; NodeIndex < Smallest.Nodes.Num() && NumRuns < MaxShrinkRuns; NodeIndex++)
+			{
+				if (Smallest.Nodes[NodeIndex].bPrimary == false) { continue; }
+
+				FDiffTree Candidate = Smallest;
+				Candidate.Nodes[NodeIndex].bPrimary = false;
+
+				if (StillDiverges(Candidate) == false) { continue; }
+
+				Smallest = MoveTemp(Candidate);
+				bShrunk = true;
+			}
+
+			for (int32 FolderIndex = Smallest.Folders.Num() - 1; FolderIndex >= 0 && NumRuns < MaxShrinkRuns; FolderIndex--)
+			{
+				if (Smallest.IsFolderRemovable(FolderIndex) == false) { continue; }
+
+				FDiffTree Candidate = Smallest.WithoutFolder(FolderIndex);
+				if (StillDiverges(Candidate) == false) { continue; }
+
+				Smallest = MoveTemp(Candidate);
+				bShrunk = true;
+			}
+		}
+
+		return Smallest;
+	}
+}
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FSuperManagerAnalysisDifferentialTest, "SuperManager.Analysis.Differential",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+void FSuperManagerAnalysisDifferentialTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	int32 NumSeeds = DefaultNumSeeds;
+	FParse::Value(FCommandLine::Get(), TEXT("SuperManagerDiffSeeds="), NumSeeds);
+
+	for (int32 Seed = 1; Seed <= NumSeeds; Seed++)
+	{
+		OutBeautifiedNames.Add(FString::Printf(TEXT("Seed %d"), Seed));
+		OutTestCommands.Add(FString::FromInt(Seed));
+	}
+}
+
+bool FSuperManagerAnalysisDifferentialTest::RunTest(const FString& Parameters)
+{
+	const int32 Seed = FCString::Atoi(*Parameters);
+	const FDiffTree Tree = GenerateTree(Seed);
+
+	TArray<FDivergence> Divergences;
+	if (ExecuteTree(Tree, FString(DiffTestRoot) / FString::Printf(TEXT("Seed%d"), Seed), Divergences) == false)
+	{
+		AddError(FString::Printf(TEXT("Could not save the content tree of seed %d"), Seed));
+		return false;
+	}
+
+	for (const FDivergence& Divergence : Divergences)
+	{
+		AddError(Divergence.ToString());
+	}
+
+	// One reproduction per failing check is enough to start debugging from
+	TSet<FString> ShrunkChecks;
+	for (const FDivergence& Divergence : Divergences)
+	{
+		bool bAlreadyShrunk = false;
+		ShrunkChecks.Add(Divergence.Check, &bAlreadyShrunk);
+
+		if (bAlreadyShrunk) { continue; }
+
+		const FDiffTree Smallest = ShrinkTree(Tree, Seed, Divergence.Check);
+
+		AddInfo(FString::Printf(TEXT("Smallest tree still failing [%s], seed %d:%s"), *Divergence.Check, Seed, *Smallest.Describe()));
+	}
+
+	UEditorAssetLibrary::DeleteDirectory(DiffTestRoot);
+
+	return Divergences.Num() == 0;
+}
+
+namespace
+{
+	/** Stage texts of a compiled query in the order they run, without the selectivity Describe appends */
+	TArray<FString> GetStageOrder(const FSuperManagerCompiledAssetQuery& CompiledQuery)
+	{
+		TArray<FString> StageTexts;
+		CompiledQuery.Describe().ParseIntoArray(StageTexts, TEXT(" -> "));
+
+		for (FString& StageText : StageTexts)
+		{
+			StageText.LeftInline(StageText.Find(TEXT(" (keeps")));
+		}
+
+		return StageTexts;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSuperManagerAssetQueryParseTest, "SuperManager.Analysis.Query.Parse",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSuperManagerAssetQueryParseTest::RunTest(const FString& Parameters)
+{
+	struct FParseCase
+	{
+		const TCHAR* QueryText;
+		ESuperManagerQueryField Field;
+		ESuperManagerQueryCompare Compare;
+		bool bNegated;
+		const TCHAR* Text;
+		int64 Number;
+	};
+
+	const FParseCase ParseCases[] =
+	{
+		{ TEXT("unused"), ESuperManagerQueryField::Unused, ESuperManagerQueryCompare::Equal, false, TEXT(""), 0 },
+		{ TEXT("-unused"), ESuperManagerQueryField::Unused, ESuperManagerQueryCompare::Equal, true, TEXT(""), 0 },
+		{ TEXT("-path:/Game/Dev/"), ESuperManagerQueryField::Path, ESuperManagerQueryCompare::Equal, true, TEXT("/Game/Dev"), 0 },
+		{ TEXT("PATH:/Game/Env"), ESuperManagerQueryField::Path, ESuperManagerQueryCompare::Equal, false, TEXT("/Game/Env"), 0 },
+		{ TEXT("class:Texture2D"), ESuperManagerQueryField::Class, ESuperManagerQueryCompare::Equal, false, TEXT("Texture2D"), 0 },
+		{ TEXT("name:Rock/"), ESuperManagerQueryField::Name, ESuperManagerQueryCompare::Equal, false, TEXT("Rock/"), 0 },
+		{ TEXT("size>4MB"), ESuperManagerQueryField::Size, ESuperManagerQueryCompare::Greater, false, TEXT(""), 4 * 1024 * 1024 },
+		{ TEXT("size<=512kb"), ESuperManagerQueryField::Size, ESuperManagerQueryCompare::LessOrEqual, false, TEXT(""), 512 * 1024 },
+		{ TEXT("-size>=1.5GB"), ESuperManagerQueryField::Size, ESuperManagerQueryCompare::GreaterOrEqual, true, TEXT(""), 3LL * 512 * 1024 * 1024 },
+		{ TEXT("size=100"), ESuperManagerQueryField::Size, ESuperManagerQueryCompare::Equal, false, TEXT(""), 100 },
+		{ TEXT("size<2B"), ESuperManagerQueryField::Size, ESuperManagerQueryCompare::Less, false, TEXT(""), 2 },
+		{ TEXT("refs>0"), ESuperManagerQueryField::Referencers, ESuperManagerQueryCompare::Greater, false, TEXT(""), 0 },
+		{ TEXT("refs=3"), ESuperManagerQueryField::Referencers, ESuperManagerQueryCompare::Equal, false, TEXT(""), 3 },
+	};
+
+	for (const FParseCase& ParseCase : ParseCases)
+	{
+		FSuperManagerAssetQuery Query;
+		FString Error;
+
+		if (FSuperManagerAssetQuery::Parse(ParseCase.QueryText, Query, Error) == false)
+		{
+			AddError(FString::Printf(TEXT("'%s' was rejected: %s"), ParseCase.QueryText, *Error));
+			continue;
+		}
+
+		if (TestEqual(FString::Printf(TEXT("'%s' term count"), ParseCase.QueryText), Query.GetTerms().Num(), 1) == false) { continue; }
+
+		const FSuperManagerQueryTerm& Term = Query.GetTerms()[0];
+		TestTrue(FString::Printf(TEXT("'%s' field"), ParseCase.QueryText), Term.Field == ParseCase.Field);
+		TestTrue(FString::Printf(TEXT("'%s' comparison"), ParseCase.QueryText), Term.Compare == ParseCase.Compare);
+		TestEqual(FString::Printf(TEXT("'%s' negation"), ParseCase.QueryText), Term.bNegated, ParseCase.bNegated);
+		TestEqual(FString::Printf(TEXT("'%s' text"), ParseCase.QueryText), Term.Text, FString(ParseCase.Text));
+		TestEqual(FString::Printf(TEXT("'%s' number"), ParseCase.QueryText), Term.Number, ParseCase.Number);
+	}
+
+	// Unknown keys and units, operators a field does not take and operators that are not operators at all
+	const TCHAR* RejectedQueries[] =
+	{
+		TEXT(""), TEXT("   "), TEXT("-"), TEXT("colour:red"), TEXT("size>4TB"), TEXT("size>MB"), TEXT("size=>4MB"), TEXT("size<>4MB"),
+		TEXT("size>"), TEXT("class>Texture2D"), TEXT("path=/Game"), TEXT("name<=Rock"), TEXT("refs>x"), TEXT("refs::1"), TEXT("Texture2D"),
+		TEXT("class:Texture2D sizee>4MB")
+	};
+
+	for (const TCHAR* RejectedQuery : RejectedQueries)
+	{
+		FSuperManagerAssetQuery Query;
+		FString Error;
+
+		if (TestFalse(FString::Printf(TEXT("'%s' is rejected"), RejectedQuery), FSuperManagerAssetQuery::Parse(RejectedQuery, Query, Error)))
+		{
+			TestFalse(FString::Printf(TEXT("'%s' explains why"), RejectedQuery), Error.IsEmpty());
+		}
+	}
+
+	FSuperManagerAssetQuery Query;
+	FString Error;
+	if (TestTrue(TEXT("Several terms parse"), FSuperManagerAssetQuery::Parse(TEXT("class:Texture2D  size>4MB\tunused -path:/Game/Dev"), Query, Error)))
+	{
+		TestEqual(TEXT("Several terms keep their count"), Query.GetTerms().Num(), 4);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSuperManagerAssetQueryStageOrderTest, "SuperManager.Analysis.Query.StageOrder",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSuperManagerAssetQueryStageOrderTest::RunTest(const FString& Parameters)
+{
+	// Without assets every term keeps the assumed half, so the order comes from the stage costs alone
+	const FSuperManagerAssetSnapshot EmptySnapshot;
+
+	struct FOrderCase
+	{
+		const TCHAR* QueryText;
+		TArray<FString> ExpectedOrder;
+	};
+
+	const FOrderCase OrderCases[] =
+	{
+		{ TEXT("name:Rock refs>0 unused"), { TEXT("unused"), TEXT("refs>0"), TEXT("name:Rock") } },
+		{ TEXT("name:Rock -size>4MB class:Texture2D"), { TEXT("-size>4194304"), TEXT("class:Texture2D"), TEXT("name:Rock") } },
+		{ TEXT("-name:Rock -refs=0 -unused path:/Game/Env/"), { TEXT("-unused"), TEXT("path:/Game/Env"), TEXT("-refs=0"), TEXT("-name:Rock") } },
+		{ TEXT("unused size<1KB"), { TEXT("unused"), TEXT("size<1024") } },
+	};
+
+	for (const FOrderCase& OrderCase : OrderCases)
+	{
+		FSuperManagerAssetQuery Query;
+		FString Error;
+
+		if (FSuperManagerAssetQuery::Parse(OrderCase.QueryText, Query, Error) == false)
+		{
+			AddError(FString::Printf(TEXT("'%s' was rejected: %s"), OrderCase.QueryText, *Error));
+			continue;
+		}
+
+		const TArray<FString> StageOrder = GetStageOrder(Query.Compile(EmptySnapshot));
+
+		TestEqual(FString::Printf(TEXT("'%s' runs as %s"), OrderCase.QueryText, *FString::Join(StageOrder, TEXT(", "))),
+			FString::Join(StageOrder, TEXT(", ")), FString::Join(OrderCase.ExpectedOrder, TEXT(", ")));
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,162 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Tests/SuperManagerTestAsset.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "AssetAnalysis/SourceControlBatch.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetToolsModule.h"
+#include "EditorAssetLibrary.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+/**
+ * The batched source control calls have to cost the same number of provider operations whatever the batch size.
+ * Deletes and renames run on a small and a large batch of saved assets and the provider call counts are compared:
+ * with a real provider (Git, Perforce...) they must match and stay under the few operations each batch issues,
+ * with source control disabled (the "None" provider) nothing may reach the provider at all.
+ *
+ * Run with: Automation RunTests SuperManager.SourceControl.BatchedProviderCalls
+ */
+
+namespace
+{
+	const TCHAR* SourceControlTestRoot = TEXT("/Game/__SuperManagerSourceControlTest");
+
+	constexpr int32 SmallBatchSize = 2;
+	constexpr int32 LargeBatchSize = 24;
+
+	// Delete: a status query, a second one ahead of marking for delete, the delete itself
+	constexpr int32 MaxDeleteProviderCalls = 3;
+
+	// Rename: a status query and a checkout
+	constexpr int32 MaxRenameProviderCalls = 2;
+
+	bool CreateSavedAssets(const FString& FolderPath, int32 NumAssets, TArray<FAssetData>& OutAssetsData)
+	{
+		OutAssetsData.Empty();
+
+		UEditorAssetLibrary::MakeDirectory(FolderPath);
+
+		TArray<FString> Filenames;
+
+		for (int32 AssetIndex = 0; AssetIndex < NumAssets; AssetIndex++)
+		{
+			const FString AssetName = FString::Printf(TEXT("Asset%d"), AssetIndex);
+
+			UPackage* Package = CreatePackage(*(FolderPath / AssetName));
+			USuperManagerTestAsset* Asset = NewObject<USuperManagerTestAsset>(Package, *AssetName, RF_Public | RF_Standalone);
+			FAssetRegistryModule::AssetCreated(Asset);
+
+			const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+
+			FSavePackageArgs SaveArgs;
+			SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+
+			if (UPackage::SavePackage(Package, Asset, *Filename, SaveArgs) == false) { return false; }
+
+			Filenames.Add(Filename);
+			OutAssetsData.Add(FAssetData(Asset));
+		}
+
+		IAssetRegistry& AssetRegistry =
+			FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+		AssetRegistry.ScanFilesSynchronous(Filenames, true);
+
+		return true;
+	}
+
+	/** Provider calls a bulk delete of NumAssets freshly saved assets issues, INDEX_NONE if the assets could not be saved */
+	int32 CountDeleteProviderCalls(int32 NumAssets)
+	{
+		const FString FolderPath = FString(SourceControlTestRoot) / FString::Printf(TEXT("Delete%d"), NumAssets);
+
+		TArray<FAssetData> AssetsData;
+		if (CreateSavedAssets(FolderPath, NumAssets, AssetsData) == false) { return INDEX_NONE; }
+
+		const int32 NumCallsBefore = SuperManagerSourceControl::GetNumProviderCalls();
+		SuperManagerSourceControl::DeleteAssets(AssetsData);
+		const int32 NumCalls = SuperManagerSourceControl::GetNumProviderCalls() - NumCallsBefore;
+
+		UEditorAssetLibrary::DeleteDirectory(FolderPath);
+
+		return NumCalls;
+	}
+
+	/** Provider calls a bulk rename of NumAssets freshly saved assets issues, INDEX_NONE if the assets could not be saved */
+	int32 CountRenameProviderCalls(int32 NumAssets)
+	{
+		const FString FolderPath = FString(SourceControlTestRoot) / FString::Printf(TEXT("Rename%d"), NumAssets);
+
+		TArray<FAssetData> AssetsData;
+		if (CreateSavedAssets(FolderPath, NumAssets, AssetsData) == false) { return INDEX_NONE; }
+
+		TArray<FAssetRenameData> AssetsToRename;
+		for (const FAssetData& AssetData : AssetsData)
+		{
+			AssetsToRename.Emplace(AssetData.GetAsset(), FolderPath, TEXT("Renamed_") + AssetData.AssetName.ToString());
+		}
+
+		const int32 NumCallsBefore = SuperManagerSourceControl::GetNumProviderCalls();
+		SuperManagerSourceControl::PrepareForRename(AssetsData);
+		const int32 NumCalls = SuperManagerSourceControl::GetNumProviderCalls() - NumCallsBefore;
+
+		FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
+		AssetToolsModule.Get().RenameAssets(AssetsToRename);
+
+		UEditorAssetLibrary::DeleteDirectory(FolderPath);
+
+		return NumCalls;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSuperManagerSourceControlBatchTest, "SuperManager.SourceControl.BatchedProviderCalls",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSuperManagerSourceControlBatchTest::RunTest(const FString& Parameters)
+{
+	const bool bProviderAvailable = SuperManagerSourceControl::IsAvailable();
+
+	AddInfo(bProviderAvailable ? TEXT("Counting calls against the active source control provider") : TEXT("Source control is disabled, no call may reach the provider"));
+
+	struct FBatchOperation
+	{
+		const TCHAR* Name;
+		TFunction<int32(int32)> CountProviderCalls;
+		int32 MaxProviderCalls;
+	};
+
+	const FBatchOperation Operations[] =
+	{
+		{ TEXT("Delete"), &CountDeleteProviderCalls, MaxDeleteProviderCalls },
+		{ TEXT("Rename"), &CountRenameProviderCalls, MaxRenameProviderCalls },
+	};
+
+	for (const FBatchOperation& Operation : Operations)
+	{
+		const int32 NumSmallBatchCalls = Operation.CountProviderCalls(SmallBatchSize);
+		const int32 NumLargeBatchCalls = Operation.CountProviderCalls(LargeBatchSize);
+
+		if (NumSmallBatchCalls == INDEX_NONE || NumLargeBatchCalls == INDEX_NONE)
+		{
+			AddError(FString::Printf(TEXT("%s: could not save the test assets"), Operation.Name));
+			continue;
+		}
+
+		const int32 MaxProviderCalls = bProviderAvailable ? Operation.MaxProviderCalls : 0;
+
+		TestEqual(FString::Printf(TEXT("%s: provider calls for %d and %d assets"), Operation.Name, SmallBatchSize, LargeBatchSize), NumLargeBatchCalls, NumSmallBatchCalls);
+		TestTrue(FString::Printf(TEXT("%s: %d provider calls, at most %d expected"), Operation.Name, NumLargeBatchCalls, MaxProviderCalls), NumLargeBatchCalls <= MaxProviderCalls);
+	}
+
+	UEditorAssetLibrary::DeleteDirectory(SourceControlTestRoot);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "UObject/PrimaryAssetId.h"
+#include "UObject/SoftObjectPtr.h"
+
+#include "SuperManagerTestAsset.generated.h"
+
+/**
+ * Bare asset the differential tests build their content trees from; it only holds hard and soft references
+ * and, when flagged, reports a primary asset id so the asset manager gives it management edges.
+ */
+UCLASS(NotBlueprintable, HideDropdown)
+class USuperManagerTestAsset : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY()
+	TArray<TObjectPtr<UObject>> HardReferences;
+
+	UPROPERTY()
+	TArray<TSoftObjectPtr<UObject>> SoftReferences;
+
+	UPROPERTY()
+	bool bPrimaryAsset = false;
+
+	static FPrimaryAssetType GetTestPrimaryAssetType() { return FPrimaryAssetType(TEXT("SuperManagerTestAsset")); }
+
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override
+	{
+		return bPrimaryAsset ? FPrimaryAssetId(GetTestPrimaryAssetType(), GetFName()) : Super::GetPrimaryAssetId();
+	}
+};
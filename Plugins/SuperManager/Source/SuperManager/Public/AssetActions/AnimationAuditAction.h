@@ -0,0 +1,70 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetActionUtility.h"
+
+#include "AnimationAuditAction.generated.h"
+
+class USkeletalMesh;
+class UAnimSequence;
+class UAnimBoneCompressionSettings;
+class UAnimCurveCompressionSettings;
+
+/** What an animation audit found out about one skeletal mesh */
+struct FSkeletalMeshAuditEntry
+{
+	FAssetData AssetData;
+
+	int32 NumBones = 0;
+	int32 NumLODs = 0;
+	int32 NumVertices = 0;
+	int64 ResourceSize = 0;
+
+	FString Describe() const;
+};
+
+/** What an animation audit found out about one anim sequence */
+struct FAnimSequenceAuditEntry
+{
+	FAssetData AssetData;
+
+	int32 NumBoneTracks = 0;
+	int32 NumKeys = 0;
+	double FrameRate = 0.0;
+	float PlayLength = 0.f;
+
+	/** The compression settings asset and the codecs it picks the smallest result from */
+	FString BoneCompression;
+	FString CurveCompression;
+
+	/** Every track keyed as a full transform of floats, what the sequence would take uncompressed */
+	int64 RawSize = 0;
+	int64 CompressedSize = 0;
+
+	float GetCompressionRatio() const { return RawSize > 0 ? float(CompressedSize) / float(RawSize) : 1.f; }
+	FString Describe() const;
+};
+
+/**
+ *
+ */
+UCLASS()
+class SUPERMANAGER_API UAnimationAuditAction : public UAssetActionUtility
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(CallInEditor)
+	void AuditAnimations(int32 MaxBones = 150, float MaxFrameRate = 30.f, float MinCompressionRatio = 0.5f);
+
+	UFUNCTION(CallInEditor)
+	void ListUnusedAnimSequences();
+
+	UFUNCTION(CallInEditor)
+	void ApplyAnimCompression(UAnimBoneCompressionSettings* BoneCompressionSettings, UAnimCurveCompressionSettings* CurveCompressionSettings, int32 WaveSize = 32, int32 MemoryCeilingMB = 4096);
+
+	static void AuditSkeletalMesh(USkeletalMesh* SkeletalMesh, FSkeletalMeshAuditEntry& OutEntry);
+	static void AuditAnimSequence(UAnimSequence* AnimSequence, FAnimSequenceAuditEntry& OutEntry);
+};
@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetActionUtility.h"
+#include "Sound/SoundWave.h"
+
+#include "AudioAuditAction.generated.h"
+
+/** What an audio audit found out about one sound wave */
+struct FSoundWaveAuditEntry
+{
+	FAssetData AssetData;
+
+	float Duration = 0.f;
+	int32 SampleRate = 0;
+	int32 NumChannels = 0;
+	int32 CompressionQuality = 0;
+	FString CompressionType;
+	ESoundAssetCompressionType CompressionFormat = ESoundAssetCompressionType::ProjectDefined;
+	FString LoadingBehavior;
+	bool bStreaming = false;
+
+	int64 EstimatedResidentMemory = 0;
+
+	bool IsUncompressed() const { return CompressionFormat == ESoundAssetCompressionType::PCM; }
+	FString Describe() const;
+};
+
+/**
+ *
+ */
+UCLASS()
+class SUPERMANAGER_API UAudioAuditAction : public UAssetActionUtility
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(CallInEditor)
+	void AuditSoundWaves(float LongWaveSeconds = 10.f);
+
+	UFUNCTION(CallInEditor)
+	void FixSoundWaves(float StreamingThresholdSeconds = 10.f, int32 CompressionQuality = 40);
+
+	UFUNCTION(CallInEditor)
+	void ListOrphanedSounds();
+
+	/** Reads registry tags first and only loads the wave when they are missing or its loading behavior is inherited */
+	static bool AuditSoundWave(const FAssetData& SoundWaveAssetData, FSoundWaveAuditEntry& OutEntry);
+};
@@ -0,0 +1,53 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetActionUtility.h"
+
+#include "BlueprintAuditAction.generated.h"
+
+/** Tick related facts about one actor Blueprint */
+struct FBlueprintTickAuditEntry
+{
+	FAssetData AssetData;
+
+	bool bCanEverTick = false;
+	bool bStartWithTickEnabled = false;
+	float TickInterval = 0.f;
+	bool bHasTickLogic = false;
+	bool bIsDataOnly = false;
+	int32 NumGraphNodes = 0;
+
+	/** External actor packages plus one per non partitioned map referencing the class */
+	int32 NumPlacedInstances = 0;
+
+	bool TicksEveryFrame() const { return bCanEverTick && bStartWithTickEnabled && TickInterval <= 0.f; }
+	FString Describe() const;
+};
+
+/**
+ *
+ */
+UCLASS()
+class SUPERMANAGER_API UBlueprintAuditAction : public UAssetActionUtility
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(CallInEditor)
+	void AuditBlueprintTick();
+
+	UFUNCTION(CallInEditor)
+	void ApplyTickInterval(float TickInterval = 0.1f);
+
+	UFUNCTION(CallInEditor)
+	void DisableStartWithTick();
+
+private:
+	/** Uses the NativeParentClass tag so non actor Blueprints are never loaded */
+	void GetSelectedActorBlueprintsData(TArray<FAssetData>& OutBlueprintsData) const;
+
+	/** Only defaults NeedsChange accepts are marked for undo, changed, recompiled and saved */
+	void ModifyActorDefaults(TFunctionRef<bool(const class AActor*)> NeedsChange, TFunctionRef<void(class AActor*)> ApplyChange, const FString& ActionDescription);
+};
@@ -0,0 +1,47 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetActionUtility.h"
+
+#include "EffectsAuditAction.generated.h"
+
+class UNiagaraSystem;
+
+/** One effect as ranked by the effects audit */
+struct FEffectAuditEntry
+{
+	FAssetData AssetData;
+
+	bool bLegacyCascade = false;
+	int32 NumReferencers = 0;
+
+	bool bMissingFixedBounds = false;
+	bool bMissingScalability = false;
+	int32 NumCPUEmitters = 0;
+	float HighestCPUSpawnRate = 0.f;
+
+	/** Relative cost used for ranking, higher is worse */
+	float CostScore = 0.f;
+
+	FString DescribeIssues() const;
+};
+
+/**
+ *
+ */
+UCLASS()
+class SUPERMANAGER_API UEffectsAuditAction : public UAssetActionUtility
+{
+	GENERATED_BODY()
+
+public:
+	/** Loads Niagara systems in waves, unloading them again whenever used memory passes MemoryBudgetMB */
+	UFUNCTION(CallInEditor)
+	void AuditEffects(float SpawnRateThreshold = 500.f, int32 MemoryBudgetMB = 4096);
+
+private:
+	void AuditNiagaraSystem(const UNiagaraSystem* NiagaraSystem, float SpawnRateThreshold, FEffectAuditEntry& OutEntry) const;
+	void ExportReport(const TArray<FEffectAuditEntry>& RankedEntries, FString& OutReportPath) const;
+};
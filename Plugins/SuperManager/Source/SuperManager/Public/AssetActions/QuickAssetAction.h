@@ -9,8 +9,9 @@
 #include "Sound/SoundCue.h"
 #include "Sound/SoundWave.h"
 #include "Engine/Texture.h"
-#include "Blueprint/UserWidget.h"
-#include "Components/SkeletalMeshComponent.h"
+#include "WidgetBlueprint.h"
+#include "Animation/AnimBlueprint.h"
+#include "Engine/SkeletalMesh.h"
 #include "NiagaraSystem.h"
 #include "NiagaraEmitter.h"
 
@@ -38,8 +39,27 @@ public:
 	UFUNCTION(CallInEditor)
 	void RemoveUnusedAssets();
 
+	UFUNCTION(CallInEditor)
+	void ListRedundantMaterialInstances();
+
+	UFUNCTION(CallInEditor)
+	void ConsolidateRedundantMaterialInstances();
+
+	UFUNCTION(CallInEditor)
+	void EstimateShaderPermutations();
+
+	/** Every distinct prefix AddPrefixes can give an asset */
+	static void GetKnownPrefixes(TArray<FString>& OutPrefixes);
+
+	static const TMap<UClass*, FString>& GetPrefixMap() { return GetDefault<UQuickAssetAction>()->PrefixMap; }
+
+	/** The name AddPrefixes gives the asset, material instances lose their M_ and _inst on the way */
+	static FString GetPrefixedName(const UObject* Asset, const FString& Prefix);
+
 private:
 	void FixupRedirectors();
+	void ConsolidateRedundantGroups(const TArray<TArray<FAssetData>>& RedundantGroups);
+	static int32 AddRedundantGroupsToReport(struct FSuperManagerResultsReport& Report, const TArray<TArray<FAssetData>>& RedundantGroups);
 
 private:
 	TMap<UClass*, FString> PrefixMap =
@@ -54,8 +74,9 @@ private:
 		{USoundWave::StaticClass(), TEXT("SW_")},
 		{UTexture::StaticClass(), TEXT("T_")},
 		{UTexture2D::StaticClass(), TEXT("T_")},
-		{UUserWidget::StaticClass(), TEXT("WBP_")},
-		{USkeletalMeshComponent::StaticClass(), TEXT("SK_")},
+		{UWidgetBlueprint::StaticClass(), TEXT("WBP_")},
+		{UAnimBlueprint::StaticClass(), TEXT("ABP_")},
+		{USkeletalMesh::StaticClass(), TEXT("SK_")},
 		{UNiagaraSystem::StaticClass(), TEXT("NS_")},
 		{UNiagaraEmitter::StaticClass(), TEXT("NE_")}
 	};
@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetActionUtility.h"
+#include "Engine/Texture.h"
+
+#include "TextureAuditAction.generated.h"
+
+/** What a texture audit found out about one texture, read from registry tags without loading it */
+struct FTextureAuditEntry
+{
+	FAssetData AssetData;
+
+	int32 Width = 0;
+	int32 Height = 0;
+	FString Format;
+	FString CompressionSettings;
+	FString LODGroup;
+	bool bHasMips = true;
+	bool bNeverStream = false;
+
+	int64 EstimatedGPUMemory = 0;
+
+	bool bOversized = false;
+	bool bNonPowerOfTwo = false;
+	bool bUncompressed = false;
+
+	bool HasIssues() const { return bOversized || bNonPowerOfTwo || bUncompressed || bNeverStream; }
+	FString DescribeIssues() const;
+};
+
+/**
+ *
+ */
+UCLASS()
+class SUPERMANAGER_API UTextureAuditAction : public UAssetActionUtility
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(CallInEditor)
+	void AuditTextures(int32 MaxAllowedSize = 2048);
+
+	UFUNCTION(CallInEditor)
+	void FixTextures(int32 MaxTextureSize = 2048, bool bCompressUncompressed = true, bool bChangeLODGroup = false, TEnumAsByte<TextureGroup> LODGroup = TEXTUREGROUP_World);
+
+	static bool AuditTexture(const FAssetData& TextureAssetData, int32 MaxAllowedSize, FTextureAuditEntry& OutEntry);
+};
@@ -0,0 +1,101 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FSuperManagerAssetSnapshot;
+
+/** What a query term looks at */
+enum class ESuperManagerQueryField : uint8
+{
+	Class,
+	Path,
+	Name,
+	Size,
+	Referencers,
+	Unused
+};
+
+enum class ESuperManagerQueryCompare : uint8
+{
+	Equal,
+	Less,
+	LessOrEqual,
+	Greater,
+	GreaterOrEqual
+};
+
+/** One term as typed, before it meets a snapshot */
+struct FSuperManagerQueryTerm
+{
+	ESuperManagerQueryField Field = ESuperManagerQueryField::Unused;
+	ESuperManagerQueryCompare Compare = ESuperManagerQueryCompare::Equal;
+	bool bNegated = false;
+
+	FString Text;
+	int64 Number = 0;
+};
+
+/**
+ * A query resolved against one snapshot: class and path terms are folded into one bit per interned class or folder,
+ * and the terms are ordered so the cheap ones that reject the most assets run first. Evaluating compacts a list of
+ * asset indices stage by stage, so the later stages only see what survived the earlier ones.
+ */
+class SUPERMANAGER_API FSuperManagerCompiledAssetQuery
+{
+public:
+	/** Snapshot asset indices matching every term, in snapshot order */
+	void Evaluate(TArray<int32>& OutAssetIndices) const;
+
+	/** The stages in the order they run, for the log */
+	FString Describe() const;
+
+private:
+	friend class FSuperManagerAssetQuery;
+
+	struct FStage
+	{
+		FSuperManagerQueryTerm Term;
+
+		/** Per class for class terms, per folder for path terms */
+		TBitArray<> Matches;
+
+		/** Share of the assets expected to pass, and the relative cost of testing one */
+		float Selectivity = 0.5f;
+		float Cost = 1.f;
+	};
+
+	const FSuperManagerAssetSnapshot* Snapshot = nullptr;
+	TArray<FStage> Stages;
+};
+
+/**
+ * Asset filters written like a search box, for instance
+ *   class:Texture2D size>4MB unused path:/Game/Env -path:/Game/Dev
+ * Terms are separated by spaces and must all hold; a leading - negates one.
+ *   class:X		the asset class is X or derives from it
+ *   path:/Game/X	the asset lives in that folder or below
+ *   name:X		the asset name contains X
+ *   size>4MB		package size on disk, with <, <=, >, >= or =, in B, KB, MB or GB
+ *   refs>0		number of packages holding a hard or soft reference to it
+ *   unused		nothing holds a hard or soft reference to it, what List Unused Assets shows
+ */
+class SUPERMANAGER_API FSuperManagerAssetQuery
+{
+public:
+	static bool Parse(const FString& QueryText, FSuperManagerAssetQuery& OutQuery, FString& OutError);
+
+	/** The snapshot has to outlive the compiled query */
+	FSuperManagerCompiledAssetQuery Compile(const FSuperManagerAssetSnapshot& Snapshot) const;
+
+	/** The terms in the order they were typed */
+	const TArray<FSuperManagerQueryTerm>& GetTerms() const { return Terms; }
+
+	/** Saved per project, shown in the Advanced Deletion options */
+	static void LoadSavedQueries(TArray<FString>& OutQueryTexts);
+	static void SaveQuery(const FString& QueryText);
+
+private:
+	TArray<FSuperManagerQueryTerm> Terms;
+};
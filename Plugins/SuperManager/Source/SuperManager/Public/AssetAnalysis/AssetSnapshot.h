@@ -0,0 +1,155 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "IO/IoHash.h"
+
+/** Flavour of a dependency edge, folded from the registry's category and property flags */
+enum class ESuperManagerDependencyKind : uint8
+{
+	None			= 0,
+	Hard			= 1 << 0,
+	Soft			= 1 << 1,
+	SearchableName	= 1 << 2,
+	Management		= 1 << 3,
+
+	// What UEditorAssetLibrary::FindPackageReferencersForAsset reports
+	Package			= Hard | Soft,
+	All				= Hard | Soft | SearchableName | Management
+};
+ENUM_CLASS_FLAGS(ESuperManagerDependencyKind);
+
+/** Strongly connected components of part of the package graph, numbered dependencies first */
+struct FSuperManagerPackageComponents
+{
+	TArray<int32> ComponentOf;
+
+	// Members in compressed rows: the packages of component i are Members[Offsets[i] .. Offsets[i + 1])
+	TArray<int32> Offsets;
+	TArray<int32> Members;
+
+	int32 Num() const { return Offsets.Num() - 1; }
+
+	TConstArrayView<int32> GetMembers(int32 Component) const
+	{
+		return TConstArrayView<int32>(Members.GetData() + Offsets[Component], Offsets[Component + 1] - Offsets[Component]);
+	}
+};
+
+/**
+ * Immutable copy of the asset registry state the SuperManager analyses run against.
+ * Captured once on the game thread, then shared read-only with worker threads.
+ */
+class SUPERMANAGER_API FSuperManagerAssetSnapshot
+{
+public:
+	/** Capture every package under /Game and keep the assets living under FolderPaths (all of /Game if empty). Game thread only. */
+	static TSharedRef<const FSuperManagerAssetSnapshot> Capture(const TArray<FString>& FolderPaths);
+
+	/** Maps and primary assets; together with anything referenced from outside /Game they seed reachability */
+	static bool IsRootAsset(const FAssetData& AssetData);
+
+	/** True when the asset lives in one of FolderPaths or below it, always true for no folders */
+	static bool IsUnderFolders(const FAssetData& AssetData, const TArray<FString>& FolderPaths);
+
+#pragma region Accessors
+	int32 NumPackages() const { return PackageNames.Num(); }
+	int32 NumAssets() const { return Assets.Num(); }
+
+	FName GetPackageName(int32 PackageIndex) const { return PackageNames[PackageIndex]; }
+	int64 GetPackageDiskSize(int32 PackageIndex) const { return PackageDiskSizes[PackageIndex]; }
+	const FIoHash& GetPackageHash(int32 PackageIndex) const { return PackageHashes[PackageIndex]; }
+	bool IsRootPackage(int32 PackageIndex) const { return RootPackages[PackageIndex]; }
+	int32 FindPackageIndex(FName PackageName) const;
+
+	const FAssetData& GetAsset(int32 AssetIndex) const { return Assets[AssetIndex]; }
+	int32 GetAssetPackageIndex(int32 AssetIndex) const { return AssetPackageIndices[AssetIndex]; }
+
+	/** Asset classes and folders interned, so filters test an index per asset instead of comparing strings */
+	int32 NumAssetClasses() const { return AssetClassPaths.Num(); }
+	const FTopLevelAssetPath& GetAssetClassPath(int32 ClassIndex) const { return AssetClassPaths[ClassIndex]; }
+	int32 GetAssetClassIndex(int32 AssetIndex) const { return AssetClassIndices[AssetIndex]; }
+
+	int32 NumAssetFolders() const { return AssetFolderPaths.Num(); }
+	FName GetAssetFolderPath(int32 FolderIndex) const { return AssetFolderPaths[FolderIndex]; }
+
+	/** INDEX_NONE for a top level folder; parents always come before their children */
+	int32 GetAssetFolderParent(int32 FolderIndex) const { return AssetFolderParents[FolderIndex]; }
+	int32 GetAssetFolderIndex(int32 AssetIndex) const { return AssetFolderIndices[AssetIndex]; }
+
+	/** Edges of every kind; the matching kinds live at the same positions in GetReferencerKinds / GetDependencyKinds */
+	TConstArrayView<int32> GetReferencers(int32 PackageIndex) const;
+	TConstArrayView<int32> GetDependencies(int32 PackageIndex) const;
+	TConstArrayView<ESuperManagerDependencyKind> GetReferencerKinds(int32 PackageIndex) const;
+	TConstArrayView<ESuperManagerDependencyKind> GetDependencyKinds(int32 PackageIndex) const;
+
+	/** Union of the kinds of every edge pointing at the package */
+	ESuperManagerDependencyKind GetIncomingKinds(int32 PackageIndex) const { return IncomingKinds[PackageIndex]; }
+#pragma endregion
+
+#pragma region Queries
+	/** The asset lists narrow to the assets under FolderPaths, on top of the folders the snapshot was captured for */
+	void ListUnusedAssets(TArray<FAssetData>& OutUnusedAssetData, const TArray<FString>& FolderPaths = TArray<FString>()) const;
+	void ListAssetsByIncomingKinds(TFunctionRef<bool(ESuperManagerDependencyKind)> Predicate, TArray<FAssetData>& OutAssetData, const TArray<FString>& FolderPaths = TArray<FString>()) const;
+	void ListUnreachableAssets(TArray<FAssetData>& OutUnreachableAssetData, const TArray<FString>& FolderPaths = TArray<FString>()) const;
+	/** Names are only counted among the assets under FolderPaths, so a clash outside of them does not count */
+	void ListSameNameAssets(TArray<FAssetData>& OutSameNameAssetData, const TArray<FString>& FolderPaths = TArray<FString>()) const;
+
+	/** Folders below FolderPath without a single asset anywhere under them, what DoesDirectoryHaveAssets calls empty */
+	void ListEmptyFolders(const FString& FolderPath, TArray<FString>& OutEmptyFolders) const;
+	void ListReferencers(FName PackageName, TArray<FName>& OutReferencers, ESuperManagerDependencyKind KindMask = ESuperManagerDependencyKind::Package) const;
+	int64 GetTotalDiskSize(const TArray<FAssetData>& AssetsToMeasure) const;
+
+	/**
+	 * Shortest chains root -> ... -> target over package and management edges, found by a bidirectional BFS.
+	 * Returns false when no root reaches the target; a root target yields the single chain { Target }.
+	 */
+	bool FindReferenceChains(int32 TargetPackageIndex, int32 MaxChains, TArray<TArray<int32>>& OutChains) const;
+
+	/**
+	 * Collapses the cycles of the graph made of the dependency edges IsFollowed accepts (iterative Tarjan).
+	 * A followed edge never leads to a component numbered higher than its own, so walking the components
+	 * from the last one down visits referencers before their dependencies.
+	 */
+	void FindComponents(TFunctionRef<bool(ESuperManagerDependencyKind Kinds, int32 DependencyIndex)> IsFollowed, FSuperManagerPackageComponents& OutComponents) const;
+#pragma endregion
+
+private:
+	int32 AddPackage(FName PackageName);
+	void BuildAssetColumns();
+
+private:
+	TArray<FName> PackageNames;
+	TArray<int64> PackageDiskSizes;
+	TArray<FIoHash> PackageHashes;
+	TMap<FName, int32> PackageIndexMap;
+
+	/** Maps, primary assets and packages referenced from outside /Game */
+	TBitArray<> RootPackages;
+
+	/** Every /Game folder the registry knows of that has no asset in it or below it */
+	TArray<FString> EmptyContentFolders;
+
+	TArray<FAssetData> Assets;
+	TArray<int32> AssetPackageIndices;
+	TArray<int32> AssetClassIndices;
+	TArray<int32> AssetFolderIndices;
+
+	TArray<FTopLevelAssetPath> AssetClassPaths;
+	TArray<FName> AssetFolderPaths;
+	TArray<int32> AssetFolderParents;
+
+	// Package graph in compressed rows: the edges of package i are Edges[Offsets[i] .. Offsets[i + 1])
+	TArray<int32> ReferencerOffsets;
+	TArray<int32> ReferencerEdges;
+	TArray<ESuperManagerDependencyKind> ReferencerEdgeKinds;
+	TArray<int32> DependencyOffsets;
+	TArray<int32> DependencyEdges;
+	TArray<ESuperManagerDependencyKind> DependencyEdgeKinds;
+
+	TArray<ESuperManagerDependencyKind> IncomingKinds;
+};
+
+using FSuperManagerAssetSnapshotRef = TSharedRef<const FSuperManagerAssetSnapshot>;
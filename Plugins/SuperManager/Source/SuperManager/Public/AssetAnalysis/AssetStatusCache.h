@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+class FSuperManagerAssetSnapshot;
+class IAssetRegistry;
+struct FPrimaryAssetId;
+
+/** What the Content Browser badges and filters show for one package */
+struct FSuperManagerAssetStatus
+{
+	/** Packages holding a hard or soft reference, what Advanced Deletion calls a referencer */
+	int32 NumReferencers = 0;
+
+	/** No referencers and not a map or primary asset */
+	bool bUnused = false;
+
+	/** No chain of package or management references leads to it from a root */
+	bool bUnreachable = false;
+};
+
+/**
+ * Per package status kept next to the Content Browser so browsing costs no registry queries.
+ * Built once from a project snapshot, then patched one package at a time from the registry callbacks:
+ * referencer counts are adjusted by diffing the old and new dependencies of the changed package,
+ * reachability is marked stale and recomputed over the cached edges once the edits settle.
+ */
+class SUPERMANAGER_API FSuperManagerAssetStatusCache
+{
+public:
+	~FSuperManagerAssetStatusCache();
+
+	void Build(const FSuperManagerAssetSnapshot& Snapshot);
+	void Reset();
+	bool IsBuilt() const { return bIsBuilt; }
+
+	/** Single map lookup; false for packages the cache does not know (or before it is built) */
+	bool GetStatus(FName PackageName, FSuperManagerAssetStatus& OutStatus) const;
+
+	/** Re-reads the dependencies of one package (and the management edges of any primary asset it holds), dropping it if no asset is left in it */
+	void UpdatePackage(FName PackageName);
+
+	/** Runs a pending reachability refresh now instead of once the edits settle */
+	void FlushReachabilityRefresh();
+
+	/** Fires after every reachability refresh, when filters have to be re-run */
+	FSimpleMulticastDelegate& OnStatusChanged() { return StatusChangedDelegate; }
+
+private:
+	struct FPackageNode
+	{
+		/** Hard and soft dependencies, each one counts as a referencer of its target */
+		TArray<FName> PackageDependencies;
+
+		/** Management edges, only followed for reachability */
+		TArray<FName> ManagementDependencies;
+
+		int32 NumReferencers = 0;
+		bool bRoot = false;
+		bool bReachable = true;
+		bool bInGame = false;
+	};
+
+	void UpdatePrimaryAssetNode(IAssetRegistry& AssetRegistry, const FPrimaryAssetId& PrimaryAssetId);
+	void SetPackageDependencies(FName PackageName, TArray<FName>&& NewPackageDependencies);
+	void RemovePackage(FName PackageName);
+
+	void RequestReachabilityRefresh();
+	bool OnReachabilityRefreshTick(float DeltaTime);
+	void RefreshReachability();
+
+private:
+	TMap<FName, FPackageNode> Nodes;
+	bool bIsBuilt = false;
+
+	FTSTicker::FDelegateHandle ReachabilityRefreshHandle;
+	FSimpleMulticastDelegate StatusChangedDelegate;
+};
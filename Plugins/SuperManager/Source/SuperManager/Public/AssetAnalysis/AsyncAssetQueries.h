@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "AssetAnalysis/AssetSnapshot.h"
+
+#include "AsyncAssetQueries.generated.h"
+
+/**
+ * Thread-safe entry points for the SuperManager analyses.
+ * Every query runs on a worker thread against an immutable snapshot, so callers never block the UI or each other.
+ */
+namespace SuperManagerQueries
+{
+	/** Game thread only; the returned snapshot can then be shared with any number of queries */
+	SUPERMANAGER_API FSuperManagerAssetSnapshotRef CaptureSnapshot(const TArray<FString>& FolderPaths);
+
+	SUPERMANAGER_API UE::Tasks::TTask<TArray<FAssetData>> ListUnusedAssets(const FSuperManagerAssetSnapshotRef& Snapshot);
+	SUPERMANAGER_API UE::Tasks::TTask<TArray<FAssetData>> ListUnreachableAssets(const FSuperManagerAssetSnapshotRef& Snapshot);
+	SUPERMANAGER_API UE::Tasks::TTask<TArray<FAssetData>> ListSameNameAssets(const FSuperManagerAssetSnapshotRef& Snapshot);
+	SUPERMANAGER_API UE::Tasks::TTask<TArray<FName>> ListReferencers(const FSuperManagerAssetSnapshotRef& Snapshot, FName PackageName);
+	SUPERMANAGER_API UE::Tasks::TTask<int64> GetTotalDiskSize(const FSuperManagerAssetSnapshotRef& Snapshot, TArray<FAssetData> AssetsToMeasure);
+}
+
+UENUM()
+enum class ESuperManagerQueryType : uint8
+{
+	Unused,
+	Unreachable,
+	SameName,
+	ReferencersOf,
+	SizeOf
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnSuperManagerQueryCompleted, const TArray<FAssetData>&, Assets, const TArray<FString>&, PackageNames, int64, TotalDiskSize);
+
+/**
+ * Blueprint and Python front end for SuperManagerQueries. Completed always fires on the game thread.
+ */
+UCLASS()
+class SUPERMANAGER_API USuperManagerAsyncQuery : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintAssignable)
+	FOnSuperManagerQueryCompleted Completed;
+
+	UFUNCTION(BlueprintCallable, Category = "SuperManager", meta = (BlueprintInternalUseOnly = "true"))
+	static USuperManagerAsyncQuery* ListUnusedAssetsAsync(const TArray<FString>& FolderPaths);
+
+	UFUNCTION(BlueprintCallable, Category = "SuperManager", meta = (BlueprintInternalUseOnly = "true"))
+	static USuperManagerAsyncQuery* ListUnreachableAssetsAsync(const TArray<FString>& FolderPaths);
+
+	UFUNCTION(BlueprintCallable, Category = "SuperManager", meta = (BlueprintInternalUseOnly = "true"))
+	static USuperManagerAsyncQuery* ListSameNameAssetsAsync(const TArray<FString>& FolderPaths);
+
+	UFUNCTION(BlueprintCallable, Category = "SuperManager", meta = (BlueprintInternalUseOnly = "true"))
+	static USuperManagerAsyncQuery* ListReferencersAsync(const FString& PackageName);
+
+	UFUNCTION(BlueprintCallable, Category = "SuperManager", meta = (BlueprintInternalUseOnly = "true"))
+	static USuperManagerAsyncQuery* GetTotalDiskSizeAsync(const TArray<FAssetData>& AssetsToMeasure);
+
+	virtual void Activate() override;
+
+private:
+	static USuperManagerAsyncQuery* CreateQuery(ESuperManagerQueryType InQueryType);
+	void FinishQuery(TArray<FAssetData>&& Assets, TArray<FString>&& PackageNames, int64 TotalDiskSize);
+
+private:
+	ESuperManagerQueryType QueryType = ESuperManagerQueryType::Unused;
+	TArray<FString> QueryFolderPaths;
+	FName QueryPackageName;
+	TArray<FAssetData> QueryAssets;
+};
@@ -0,0 +1,53 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+/** How a bulk pass loads, saves and releases assets */
+struct FSuperManagerBulkSettings
+{
+	/** Packages requested from the async loader together */
+	int32 WaveSize = 32;
+
+	/** Packages this pass loaded are unloaded once used physical memory passes this */
+	int32 MemoryCeilingMB = 4096;
+
+	/** Save what the callback reports as modified at the end of each wave */
+	bool bSaveModifiedAssets = true;
+};
+
+/** What a bulk pass did, for the end of operation report */
+struct FSuperManagerBulkStats
+{
+	int32 NumRequested = 0;
+	int32 NumLoaded = 0;
+	int32 NumFailed = 0;
+	int32 NumModified = 0;
+	int32 NumWaves = 0;
+	int32 NumUnloads = 0;
+
+	double Seconds = 0.0;
+	uint64 PeakUsedPhysical = 0;
+
+	double GetAssetsPerSecond() const { return Seconds > 0.0 ? NumLoaded / Seconds : 0.0; }
+	FString Describe() const;
+};
+
+namespace SuperManagerBulk
+{
+	/** Gets every loaded asset of a wave, fills OutModifiedAssets with those that need saving */
+	using FWaveCallback = TFunctionRef<void(const TArray<UObject*>& LoadedAssets, TArray<UObject*>& OutModifiedAssets)>;
+
+	/** Gets one loaded asset, returns true when it needs saving */
+	using FAssetCallback = TFunctionRef<bool(UObject* LoadedAsset)>;
+
+	/**
+	 * Loads AssetsData asynchronously one wave at a time, hands each wave to Callback, saves the modified assets,
+	 * and unloads the packages it loaded itself whenever memory passes the ceiling. Packages that were already loaded
+	 * or are left dirty are never unloaded. Game thread only.
+	 */
+	SUPERMANAGER_API FSuperManagerBulkStats ProcessWaves(const TArray<FAssetData>& AssetsData, FWaveCallback Callback, const FSuperManagerBulkSettings& Settings = FSuperManagerBulkSettings());
+	SUPERMANAGER_API FSuperManagerBulkStats ProcessAssets(const TArray<FAssetData>& AssetsData, FAssetCallback Callback, const FSuperManagerBulkSettings& Settings = FSuperManagerBulkSettings());
+}
@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FSuperManagerAssetSnapshot;
+
+/** A primary asset, or a package one manages, and the chunk its rules send it to */
+struct FSuperManagerChunkSeed
+{
+	int32 PackageIndex = INDEX_NONE;
+	int32 ChunkId = 0;
+	int32 Priority = 0;
+};
+
+/** A package cooked into more than one chunk */
+struct FSuperManagerChunkDuplicate
+{
+	int32 PackageIndex = INDEX_NONE;
+	TArray<int32> ChunkIds;
+	int64 DiskSize = 0;
+
+	/** Size times the copies beyond the first, what moving the package to a shared chunk saves */
+	int64 GetDuplicatedBytes() const { return DiskSize * (ChunkIds.Num() - 1); }
+};
+
+/**
+ * Chunk assignment the way the asset manager derives it at cook time: every primary asset, and every package
+ * it manages (the explicit and directory assets of a label), starts out in the chunk of its rules; chunks then
+ * flow down hard and soft dependencies until another primary asset takes over. A package reached by managers of
+ * different priorities keeps the chunks of the highest priority only.
+ * Dependency cycles are collapsed first, so the flow is one sweep over the edges in topological order.
+ */
+namespace SuperManagerChunkAnalysis
+{
+	/** Reads the primary asset rules from the asset manager. Game thread only; false while the asset manager is not up. */
+	SUPERMANAGER_API bool GatherChunkSeeds(const FSuperManagerAssetSnapshot& Snapshot, TArray<FSuperManagerChunkSeed>& OutSeeds, TBitArray<>& OutPrimaryAssetPackages);
+
+	/** Sorted chunk ids per snapshot package; empty for the packages no primary asset reaches, which are never cooked */
+	SUPERMANAGER_API void ResolveChunks(const FSuperManagerAssetSnapshot& Snapshot, const TArray<FSuperManagerChunkSeed>& Seeds, const TBitArray<>& PrimaryAssetPackages, TArray<TArray<int32>>& OutPackageChunks);
+
+	/** Packages in two chunks or more, most duplicated bytes first */
+	SUPERMANAGER_API void ListDuplicatedPackages(const FSuperManagerAssetSnapshot& Snapshot, const TArray<TArray<int32>>& PackageChunks, TArray<FSuperManagerChunkDuplicate>& OutDuplicates);
+}
@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FSuperManagerAssetSnapshot;
+
+/** What a set of packages costs once loaded */
+struct FSuperManagerMemoryEstimate
+{
+	int64 DiskBytes = 0;
+	int64 ResidentBytes = 0;
+	int32 NumPackages = 0;
+
+	void Add(int64 InDiskBytes, int64 InResidentBytes)
+	{
+		DiskBytes += InDiskBytes;
+		ResidentBytes += InResidentBytes;
+		NumPackages++;
+	}
+};
+
+/** Everything loading one map pulls in through hard references, the map package included */
+struct FSuperManagerMapLoadClosure
+{
+	int32 MapPackageIndex = INDEX_NONE;
+	FSuperManagerMemoryEstimate Total;
+
+	/** Keyed on the asset class name; packages the snapshot has no asset data for fall under "Other content" */
+	TMap<FName, FSuperManagerMemoryEstimate> PerClass;
+
+	/** Package index and resident bytes, largest first */
+	TArray<TPair<int32, int64>> LargestPackages;
+};
+
+/**
+ * Load closures of every map in the snapshot, from its cached hard dependencies.
+ * Cycles are collapsed first, then closures are built once per component, dependencies first, each as the union of
+ * the closures below it. A closure shared by many maps (a common material library, say) is computed a single time and
+ * released as soon as the last component referencing it is done, so the whole project goes in one pass.
+ * Packages outside /Game are counted but not walked into: the snapshot keeps no dependencies for them.
+ */
+namespace SuperManagerMapLoadClosure
+{
+	/**
+	 * Rough resident size from the registry tags, without loading the asset: textures from their dimensions at block
+	 * compression with a full mip chain, meshes from their vertex and triangle counts. Anything else counts its disk size.
+	 */
+	SUPERMANAGER_API int64 EstimateResidentBytes(const FAssetData& AssetData, int64 DiskBytes);
+
+	/** One closure per map, most resident bytes first, each listing up to NumLargestPackages of its heaviest packages */
+	SUPERMANAGER_API void AnalyseMaps(const FSuperManagerAssetSnapshot& Snapshot, int32 NumLargestPackages, TArray<FSuperManagerMapLoadClosure>& OutClosures);
+}
@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+class UMaterial;
+class UMaterialInstanceConstant;
+
+/** Everything the permutation estimate needs, read from the material and the registry without loading any instance */
+struct FMaterialPermutationInputs
+{
+	FString MaterialPath;
+	FGuid StateId;
+
+	TArray<FString> EnabledUsageFlags;
+	/** Enabled usage flags that add a vertex factory, which is what multiplies the shader count */
+	int32 NumVertexFactoryUsages = 0;
+	/** Enabled usage flags none of the material's referencers need */
+	TArray<FString> ClearableUsageFlags;
+	/** Every instance chained to the material, found through the registry */
+	TArray<FAssetData> Instances;
+	bool bHasQualitySwitch = false;
+
+	/** Material state plus the saved hash of every instance package, zero when an instance has unsaved changes */
+	uint64 CacheKey = 0;
+};
+
+struct FMaterialPermutationEstimate
+{
+	FString MaterialPath;
+
+	int32 NumStaticPermutations = 1;
+	int32 NumVertexFactories = 1;
+	int32 NumQualityLevels = 1;
+
+	int64 PredictedShaderCount = 0;
+	int64 PredictedDDCBytes = 0;
+
+	TArray<FString> ClearableUsageFlags;
+};
+
+namespace SuperManagerMaterials
+{
+	/**
+	 * Canonical description of everything that makes an instance compile, render or behave differently: parent, static
+	 * switches and masks, property overrides, every overridden parameter and every other property the instance declares
+	 * (physical materials, subsurface profile, lightmass settings), sorted by name.
+	 */
+	SUPERMANAGER_API FString BuildInstanceFingerprint(const UMaterialInstanceConstant* MaterialInstance);
+
+	/** The part of the fingerprint that selects a shader map: static switches, masks and property overrides */
+	SUPERMANAGER_API FString BuildStaticPermutationKey(const UMaterialInstanceConstant* MaterialInstance);
+
+	/** Loads the instances in bulk waves and groups identical fingerprints; only groups with more than one member are returned */
+	SUPERMANAGER_API void GroupRedundantInstances(const TArray<FAssetData>& InstancesData, TArray<TArray<FAssetData>>& OutRedundantGroups);
+
+	/** Game thread only: walks the registry for every instance chained to Material and its consumers, loads nothing */
+	SUPERMANAGER_API void GatherPermutationInputs(UMaterial* Material, FMaterialPermutationInputs& OutInputs);
+
+	/**
+	 * Game thread only. Estimates are cached on the inputs' cache key, so only materials whose instances changed
+	 * since the last run load those instances, in bulk waves, to read their static parameters. Sorted by predicted shader count.
+	 */
+	SUPERMANAGER_API void EstimatePermutations(const TArray<FMaterialPermutationInputs>& Inputs, TArray<FMaterialPermutationEstimate>& OutEstimates);
+}
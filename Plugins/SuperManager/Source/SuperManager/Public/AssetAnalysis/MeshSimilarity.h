@@ -0,0 +1,41 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+struct FMeshDescription;
+
+/** Geometry of a static mesh's LOD0 source, independent of its name, location in the level or import order */
+struct FSuperManagerMeshFingerprint
+{
+	int32 NumVertices = 0;
+	int32 NumTriangles = 0;
+	int32 NumMaterialSlots = 0;
+	FVector3f BoundsSize = FVector3f::ZeroVector;
+
+	/** Order independent hash of every triangle, positions quantized relative to the bounds; equal means same geometry */
+	uint64 GeometryHash = 0;
+
+	/** SimHash of coarsely quantized vertex positions; a few differing bits means near identical geometry */
+	uint64 ShapeHash = 0;
+
+	bool IsIdentical(const FSuperManagerMeshFingerprint& Other) const;
+	bool IsNearIdentical(const FSuperManagerMeshFingerprint& Other) const;
+};
+
+namespace SuperManagerMeshSimilarity
+{
+	/** Bits two ShapeHashes may differ by and still be compared in detail */
+	constexpr int32 MaxShapeHashDistance = 3;
+
+	/** Reads the mesh description only, safe on worker threads for distinct meshes */
+	SUPERMANAGER_API bool ComputeFingerprint(const FMeshDescription& MeshDescription, int32 NumMaterialSlots, FSuperManagerMeshFingerprint& OutFingerprint);
+
+	/** Loads the meshes in memory budgeted waves and fingerprints each wave on worker threads. Game thread only. */
+	SUPERMANAGER_API void FingerprintStaticMeshes(const TArray<FAssetData>& MeshesData, TArray<TOptional<FSuperManagerMeshFingerprint>>& OutFingerprints);
+
+	/** Groups of identical or near identical meshes (indices into Fingerprints), largest first */
+	SUPERMANAGER_API void GroupSimilarMeshes(const TArray<TOptional<FSuperManagerMeshFingerprint>>& Fingerprints, TArray<TArray<int32>>& OutGroups);
+}
@@ -0,0 +1,26 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Fuzzy grouping of asset names that DuplicateAssets and AddPrefixes have pulled apart.
+ * Names are normalized first, then near matches are found through a trigram inverted index:
+ * each name only probes the few rarest of its trigrams, which every name within the edit budget
+ * must share with it, and the candidates are confirmed with a banded edit distance.
+ */
+namespace SuperManagerNameSimilarity
+{
+	/** Lower case, without a known prefix, numeric or _inst suffixes and separators: "BP_ToDelete_7" -> "todelete" */
+	SUPERMANAGER_API FString NormalizeName(const FString& AssetName, const TArray<FString>& KnownPrefixes);
+
+	/** Edits allowed between two normalized names, by the length of the shorter one */
+	SUPERMANAGER_API int32 GetMaxEdits(int32 NameLength);
+
+	/** Levenshtein distance, or MaxDistance + 1 as soon as it is certain to exceed MaxDistance */
+	SUPERMANAGER_API int32 EditDistance(const FString& A, const FString& B, int32 MaxDistance);
+
+	/** Groups of indices into NormalizedNames whose names match within GetMaxEdits, largest group first */
+	SUPERMANAGER_API void GroupSimilarNames(const TArray<FString>& NormalizedNames, TArray<TArray<int32>>& OutGroups);
+}
@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "UObject/TopLevelAssetPath.h"
+
+class UFactory;
+
+/** What happens to a new asset whose name lacks the prefix its class expects */
+enum class ESuperManagerNamingMode : uint8
+{
+	Off,
+	Warn,
+	Rename
+};
+
+/**
+ * Keeps new assets in line with the PrefixMap of UQuickAssetAction as they are created or imported,
+ * so prefixes never pile up into mass renames and redirector fixups later.
+ * The expected prefix of a class is resolved once by walking up to the nearest mapped parent class and
+ * cached per class path, so checking a new asset is one map lookup. Renames wait for the next tick,
+ * until the factory or importer that created the asset is done with it.
+ */
+class SUPERMANAGER_API FSuperManagerNamingConvention
+{
+public:
+	~FSuperManagerNamingConvention();
+
+	void Register();
+	void Unregister();
+
+	ESuperManagerNamingMode GetMode() const { return Mode; }
+
+	/** Saved per project, survives editor restarts */
+	void SetMode(ESuperManagerNamingMode NewMode);
+
+	/** Empty when neither the class nor any of its parents has a prefix */
+	const FString& GetExpectedPrefix(const FTopLevelAssetPath& ClassPath);
+
+private:
+	void RegisterImportCallbacks();
+	void OnInMemoryAssetCreated(UObject* Asset);
+	void OnAssetPostImport(UFactory* Factory, UObject* Asset);
+	void QueueNewAsset(UObject* Asset);
+	bool OnPendingAssetsTick(float DeltaTime);
+
+private:
+	ESuperManagerNamingMode Mode = ESuperManagerNamingMode::Warn;
+	TMap<FTopLevelAssetPath, FString> ResolvedPrefixes;
+
+	TArray<TWeakObjectPtr<UObject>> PendingAssets;
+	FTSTicker::FDelegateHandle PendingAssetsHandle;
+};
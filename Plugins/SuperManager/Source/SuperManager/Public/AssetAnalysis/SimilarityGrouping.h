@@ -0,0 +1,22 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Grouping of near duplicates by the Hamming distance of 64 bit fingerprints.
+ * A BK-tree answers every radius query in roughly logarithmic time, so the whole pass stays well below
+ * the quadratic pair check for the tens of thousands of assets a project can hold.
+ */
+namespace SuperManagerSimilarity
+{
+	SUPERMANAGER_API int32 HammingDistance(uint64 A, uint64 B);
+
+	/**
+	 * Connected groups of fingerprints lying within MaxDistance bits of each other, largest group first.
+	 * ConfirmPair gets the final say on every candidate pair (indices into Hashes). Singletons are left out.
+	 */
+	SUPERMANAGER_API void GroupByHammingDistance(TConstArrayView<uint64> Hashes, int32 MaxDistance, TFunctionRef<bool(int32, int32)> ConfirmPair, TArray<TArray<int32>>& OutGroups);
+	SUPERMANAGER_API void GroupByHammingDistance(TConstArrayView<uint64> Hashes, int32 MaxDistance, TArray<TArray<int32>>& OutGroups);
+}
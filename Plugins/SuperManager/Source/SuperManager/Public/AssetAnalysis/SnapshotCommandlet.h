@@ -0,0 +1,28 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+
+#include "SnapshotCommandlet.generated.h"
+
+/**
+ * Snapshot export and diff for build machines:
+ *   -run=SuperManagerSnapshot -Export=<file>
+ *   -run=SuperManagerSnapshot -Base=<file> -Compare=<file> [-Report=<csv>]
+ */
+UCLASS()
+class USuperManagerSnapshotCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USuperManagerSnapshotCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	int32 ExportSnapshot(const FString& Filename);
+	int32 CompareSnapshots(const FString& BaseFilename, const FString& CompareFilename, const FString& ReportFilename);
+};
@@ -0,0 +1,119 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetAnalysis/AssetSnapshot.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/** Fixed size header at the start of every snapshot file */
+struct FSuperManagerSnapshotFileHeader
+{
+	uint32 Magic;
+	uint32 Version;
+	uint32 NumPackages;
+	uint32 NumEdges;
+	uint64 NameBytes;
+	uint64 Reserved;
+};
+static_assert(sizeof(FSuperManagerSnapshotFileHeader) == 32, "Snapshot file header layout changed, bump the version");
+
+/** One row of the package table; rows are sorted by name */
+struct FSuperManagerSnapshotFilePackage
+{
+	enum EFlags : uint32
+	{
+		Root	= 1 << 0,
+		Unused	= 1 << 1,
+		InGame	= 1 << 2
+	};
+
+	int64 DiskSize;
+	uint64 NameOffset;
+	uint32 NameLength;
+	uint32 FirstEdge;
+	uint32 NumEdges;
+	uint32 NumReferencers;
+	uint32 NumHardReferencers;
+	uint32 Flags;
+	uint8 Hash[20];
+	uint8 Padding[4];
+};
+static_assert(sizeof(FSuperManagerSnapshotFilePackage) == 64, "Snapshot file package layout changed, bump the version");
+
+/**
+ * A project snapshot written to disk, for comparing branches without rescanning either of them.
+ * Little endian, fixed width sections that are used in place from a memory mapped file:
+ *   header | packages | dependency targets (uint32) | dependency kinds (uint8) | names (UTF-8)
+ * Packages are sorted by name so two files compare in a single merge pass.
+ */
+class SUPERMANAGER_API FSuperManagerSnapshotFile
+{
+public:
+	static constexpr uint32 FileMagic = 0x4E534D53; // "SMSN"
+	static constexpr uint32 FileVersion = 1;
+
+	static bool Write(const FSuperManagerAssetSnapshot& Snapshot, const FString& Filename);
+
+	/** Maps the file (reads it when mapping is unavailable) and validates every section; nullptr with OutError set on failure */
+	static TUniquePtr<FSuperManagerSnapshotFile> Open(const FString& Filename, FString& OutError);
+
+	~FSuperManagerSnapshotFile();
+
+	int32 NumPackages() const { return int32(Header->NumPackages); }
+	const FSuperManagerSnapshotFilePackage& GetPackage(int32 PackageIndex) const { return Packages[PackageIndex]; }
+	FUtf8StringView GetPackageName(int32 PackageIndex) const;
+
+	TConstArrayView<uint32> GetDependencies(int32 PackageIndex) const;
+	TConstArrayView<ESuperManagerDependencyKind> GetDependencyKinds(int32 PackageIndex) const;
+
+private:
+	FSuperManagerSnapshotFile() = default;
+
+	bool Validate(FString& OutError);
+
+private:
+	TUniquePtr<IMappedFileHandle> MappedHandle;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	TArray64<uint8> LoadedBytes;
+
+	const uint8* Data = nullptr;
+	int64 DataSize = 0;
+
+	const FSuperManagerSnapshotFileHeader* Header = nullptr;
+	const FSuperManagerSnapshotFilePackage* Packages = nullptr;
+	const uint32* EdgeTargets = nullptr;
+	const ESuperManagerDependencyKind* EdgeKinds = nullptr;
+	const UTF8CHAR* Names = nullptr;
+};
+
+/** A package present in either snapshot of a diff */
+struct FSuperManagerSnapshotDiffEntry
+{
+	FString PackageName;
+	int64 OldDiskSize = 0;
+	int64 NewDiskSize = 0;
+	int32 OldHardReferencers = 0;
+	int32 NewHardReferencers = 0;
+};
+
+/** What changed in /Game between two snapshot files */
+struct SUPERMANAGER_API FSuperManagerSnapshotDiff
+{
+	TArray<FSuperManagerSnapshotDiffEntry> Added;
+	TArray<FSuperManagerSnapshotDiffEntry> Removed;
+	TArray<FSuperManagerSnapshotDiffEntry> NewlyUnused;
+	TArray<FSuperManagerSnapshotDiffEntry> GainedHardReferences;
+	TArray<FSuperManagerSnapshotDiffEntry> SizeChanged;
+
+	int64 OldTotalSize = 0;
+	int64 NewTotalSize = 0;
+
+	/** One linear merge over the two sorted package tables */
+	static FSuperManagerSnapshotDiff Compare(const FSuperManagerSnapshotFile& OldFile, const FSuperManagerSnapshotFile& NewFile);
+
+	FString Describe() const;
+	FString ToCSV() const;
+};
@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+/**
+ * Source control for SuperManager bulk operations: every affected file is gathered first,
+ * then each kind of provider operation is issued once for all of them.
+ * With source control disabled (the "None" provider) every call is a no-op.
+ */
+namespace SuperManagerSourceControl
+{
+	SUPERMANAGER_API bool IsAvailable();
+
+	/** Absolute package filenames, the way the provider expects them */
+	SUPERMANAGER_API void GetPackageFilenames(const TArray<FName>& PackageNames, TArray<FString>& OutFilenames);
+
+	/** One status query for all files, so the per file state lookups done by engine tools hit the provider cache */
+	SUPERMANAGER_API bool UpdateStatus(const TArray<FString>& Filenames);
+
+	/** Each issues at most one provider operation for the files in the right state and returns how many it covered */
+	SUPERMANAGER_API int32 CheckOut(const TArray<FString>& Filenames);
+	SUPERMANAGER_API int32 MarkForAdd(const TArray<FString>& Filenames);
+	SUPERMANAGER_API int32 MarkForDelete(const TArray<FString>& Filenames);
+
+	/** Deletes through ObjectTools after one status query, then marks whatever it left behind for delete in one go */
+	SUPERMANAGER_API int32 DeleteAssets(const TArray<FAssetData>& AssetsDataToDelete);
+
+	/** One status query and one checkout for the assets and every package referencing them, ahead of a rename */
+	SUPERMANAGER_API void PrepareForRename(const TArray<FAssetData>& AssetsDataToRename);
+
+	/** Provider operations issued by this module since startup, what the batching test measures */
+	SUPERMANAGER_API int32 GetNumProviderCalls();
+}
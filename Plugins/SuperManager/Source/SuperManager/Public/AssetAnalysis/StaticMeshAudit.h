@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+/** One static mesh as seen by the mesh audit, read from registry tags where possible */
+struct FStaticMeshAuditEntry
+{
+	FAssetData AssetData;
+
+	int32 NumTriangles = 0;
+	int32 NumVertices = 0;
+	int32 NumLODs = 0;
+	bool bNaniteEnabled = false;
+	FString CollisionComplexity;
+
+	bool UsesComplexAsSimple() const { return CollisionComplexity == TEXT("CTF_UseComplexAsSimple"); }
+};
+
+namespace SuperManagerMeshAudit
+{
+	/** Number of meshes loaded, rebuilt and saved before the next wave is loaded */
+	constexpr int32 DefaultWaveSize = 16;
+
+	SUPERMANAGER_API bool AuditStaticMesh(const FAssetData& MeshAssetData, FStaticMeshAuditEntry& OutEntry);
+	SUPERMANAGER_API void AuditStaticMeshes(const TArray<FAssetData>& AssetsData, TArray<TSharedPtr<FStaticMeshAuditEntry>>& OutEntries);
+
+	/** Both return the number of meshes changed; each wave is built in parallel and saved through the bulk loader */
+	SUPERMANAGER_API int32 EnableNanite(const TArray<FAssetData>& MeshesData, int32 WaveSize = DefaultWaveSize);
+	SUPERMANAGER_API int32 GenerateLODs(const TArray<FAssetData>& MeshesData, int32 NumLODs, int32 WaveSize = DefaultWaveSize);
+}
@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "IO/IoHash.h"
+
+class FTextureSource;
+
+/** Perceptual fingerprints of a texture's source art, blind to compression settings and import options */
+struct FSuperManagerTextureHash
+{
+	/** Sign of the low frequency DCT coefficients of a 32x32 luminance thumbnail */
+	uint64 PerceptualHash = 0;
+
+	/** Brightness gradient between neighbours of a 9x8 luminance thumbnail */
+	uint64 DifferenceHash = 0;
+
+	friend FArchive& operator<<(FArchive& Ar, FSuperManagerTextureHash& Hash)
+	{
+		return Ar << Hash.PerceptualHash << Hash.DifferenceHash;
+	}
+};
+
+namespace SuperManagerTextureSimilarity
+{
+	/** Decodes the top source mip strip by strip and reduces it with vector kernels; safe on worker threads for distinct textures */
+	SUPERMANAGER_API bool ComputeHash(FTextureSource& Source, FSuperManagerTextureHash& OutHash);
+}
+
+/**
+ * Texture hashes that survive between runs (Saved/SuperManager/TextureHashes.bin).
+ * Hashes are keyed by the source id, a hash of the source art, so re-imports and copies share one entry;
+ * a second map from the package saved hash lets unchanged packages skip loading altogether.
+ */
+class SUPERMANAGER_API FSuperManagerTextureHashCache
+{
+public:
+	/** Hashes every texture, loading (in memory budgeted waves) only the ones the cache cannot answer. Game thread only. */
+	void HashTextures(const TArray<FAssetData>& TexturesData, TArray<TOptional<FSuperManagerTextureHash>>& OutHashes);
+
+private:
+	void LoadFromDisk();
+	void SaveToDisk();
+	static FString GetCacheFilename();
+
+private:
+	static constexpr uint32 CacheVersion = 1;
+
+	TMap<FIoHash, FGuid> SourceIdsByPackageHash;
+	TMap<FGuid, FSuperManagerTextureHash> HashesBySourceId;
+	bool bLoadedFromDisk = false;
+};
@@ -3,6 +3,9 @@
 #pragma once
 
 #include "Widgets/SCompoundWidget.h"
+#include "AssetAnalysis/AssetSnapshot.h"
+
+class SEditableTextBox;
 
 class SAdvancedDeletionWidget : public SCompoundWidget
 {
@@ -29,8 +32,13 @@ private:
 	TSharedRef<STextBlock> ConstructTextBlock(const FString& TextContent, const FSlateFontInfo& Font, FColor Color = FColor::White, ETextJustify::Type Justify = ETextJustify::Left);
 
 	TSharedRef<SButton> ConstructButton(const TSharedPtr<FAssetData>& AssetDataToDisplay);
+	TSharedRef<SButton> ConstructWhyReferencedButton(const TSharedPtr<FAssetData>& AssetDataToDisplay);
+
+	TSharedRef<SEditableTextBox> ConstructQueryTextBox();
+	TSharedRef<SButton> ConstructSaveQueryButton();
 
 	TSharedRef<SButton> ConstructDeleteAllButton();
+	TSharedRef<SButton> ConstructConsolidateButton();
 	TSharedRef<SButton> ConstructSelectAllButton();
 	TSharedRef<SButton> ConstructDeselectAllButton();
 #pragma endregion
@@ -43,9 +51,14 @@ private:
 	void OnComboBoxSelectionChanged(TSharedPtr<FString> SelectedOption, ESelectInfo::Type InSelectInfo);
 
 	void OnCheckStateChanged(ECheckBoxState NewState, TSharedPtr<FAssetData> AssetData);
+
+	void OnQueryTextCommitted(const FText& NewText, ETextCommit::Type CommitType);
+	FReply OnSaveQueryButtonClicked();
 	
 	FReply OnDeleteButtonClicked(TSharedPtr<FAssetData> ClickedAssetData);
+	FReply OnWhyReferencedButtonClicked(TSharedPtr<FAssetData> ClickedAssetData);
 	FReply OnDeleteAllButtonClicked();
+	FReply OnConsolidateButtonClicked();
 	FReply OnSelectAllButtonClicked();
 	FReply OnDeselectAllButtonClicked();
 #pragma endregion
@@ -53,6 +66,10 @@ private:
 #pragma region HelperMethods
 	FSlateFontInfo GetEmbossedTextFont(float Size = 10.0f);
 	void RefreshAssetListView();
+	const FSuperManagerAssetSnapshot& GetAssetSnapshot();
+	void ListAssetsByIncomingKinds(TFunctionRef<bool(ESuperManagerDependencyKind)> Predicate);
+	void ListAssetsByQuery(const FString& QueryText);
+	void InvalidateAssetSnapshot();
 #pragma endregion
 
 private:
@@ -65,5 +82,13 @@ private:
 	TArray<TSharedRef<SCheckBox>> CheckBoxesArray;
 
 	TArray<TSharedPtr<FString>> ComboBoxSourceItems;
+	TSharedPtr<SComboBox<TSharedPtr<FString>>> ConstructedComboBox;
 	TSharedPtr<STextBlock> ComboDisplayTextBlock;
+	TSharedPtr<SEditableTextBox> QueryTextBox;
+
+	FString CurrentSelectedFolder;
+	TSharedPtr<const FSuperManagerAssetSnapshot> AssetSnapshot;
+
+	/** Row of each snapshot asset, so query results map back without a lookup per asset */
+	TArray<TSharedPtr<FAssetData>> SnapshotAssetRows;
 };
@@ -0,0 +1,21 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ContentBrowserFrontEndFilterExtension.h"
+
+#include "AssetStatusFilter.generated.h"
+
+/**
+ * Adds the "Unused" and "Unreachable" filters to the Content Browser filter menu.
+ * Both answer from the module's asset status cache, one map lookup per item.
+ */
+UCLASS()
+class USuperManagerAssetStatusFilterExtension : public UContentBrowserFrontEndFilterExtension
+{
+	GENERATED_BODY()
+
+public:
+	virtual void AddFrontEndFilterExtensions(TSharedPtr<class FFrontendFilterCategory> DefaultCategory, TArray<TSharedRef<class FFrontendFilter>>& InOutFilterList) const override;
+};
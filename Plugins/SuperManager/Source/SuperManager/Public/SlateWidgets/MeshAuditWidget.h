@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "Widgets/SCompoundWidget.h"
+#include "AssetAnalysis/StaticMeshAudit.h"
+
+class SMeshAuditWidget : public SCompoundWidget
+{
+	SLATE_BEGIN_ARGS(SMeshAuditWidget) {}
+
+	SLATE_ARGUMENT(TArray<FAssetData>, StaticMeshesData)
+
+	SLATE_ARGUMENT(FString, CurrentSelectedFolder)
+
+	SLATE_END_ARGS()
+
+public:
+	void Construct(const FArguments& InArgs);
+
+private:
+
+#pragma region ConstructionMethods
+	TSharedRef<SListView<TSharedPtr<FStaticMeshAuditEntry>>> ConstructMeshesListView();
+
+	TSharedRef<STextBlock> ConstructTextBlock(const FString& TextContent, const FSlateFontInfo& Font, FColor Color = FColor::White, ETextJustify::Type Justify = ETextJustify::Left);
+
+	TSharedRef<SButton> ConstructActionButton(const FString& ButtonText, FReply(SMeshAuditWidget::* OnClickedMethod)());
+#pragma endregion
+
+#pragma region EventsMethods
+	TSharedRef<ITableRow> OnGenerateRowForList(TSharedPtr<FStaticMeshAuditEntry> EntryToDisplay, const TSharedRef<STableViewBase>& OwnerTable);
+
+	void OnCheckStateChanged(ECheckBoxState NewState, TSharedPtr<FStaticMeshAuditEntry> Entry);
+
+	FReply OnEnableNaniteButtonClicked();
+	FReply OnGenerateLODsButtonClicked();
+#pragma endregion
+
+#pragma region HelperMethods
+	FSlateFontInfo GetEmbossedTextFont(float Size = 10.0f);
+	TArray<FAssetData> GetSelectedMeshesData() const;
+	void RefreshMeshListView();
+#pragma endregion
+
+private:
+	TArray<FAssetData> StaticMeshesData;
+	TArray<TSharedPtr<FStaticMeshAuditEntry>> DisplayedEntries;
+	TArray<TSharedPtr<FStaticMeshAuditEntry>> SelectedEntries;
+
+	TSharedPtr<SListView<TSharedPtr<FStaticMeshAuditEntry>>> ConstructedMeshesListView;
+};
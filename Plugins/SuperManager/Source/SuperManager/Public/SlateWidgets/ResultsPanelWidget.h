@@ -0,0 +1,90 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/STreeView.h"
+
+/** One line of a results report; ObjectPath, when set, lets the row sync the Content Browser */
+struct FSuperManagerResultItem
+{
+	FString Group;
+	FString Text;
+	FString ObjectPath;
+};
+
+/** Everything an operation wants to tell the user, shown by SSuperManagerResultsPanel */
+struct FSuperManagerResultsReport
+{
+	FString Title;
+	FString Summary;
+	TArray<TSharedPtr<FSuperManagerResultItem>> Items;
+
+	/** When bound the panel shows an inline confirm button that runs it once */
+	FString ConfirmLabel;
+	TFunction<void()> OnConfirm;
+
+	void AddItem(const FString& Group, const FString& Text, const FString& ObjectPath = FString())
+	{
+		Items.Add(MakeShared<FSuperManagerResultItem>(FSuperManagerResultItem{ Group, Text, ObjectPath }));
+	}
+};
+
+/** Tree row of the panel: a group header owning its items, or a single item */
+struct FSuperManagerResultNode
+{
+	FString Text;
+	TSharedPtr<FSuperManagerResultItem> Item;
+	TArray<TSharedPtr<FSuperManagerResultNode>> Children;
+};
+
+class SSuperManagerResultsPanel : public SCompoundWidget
+{
+	SLATE_BEGIN_ARGS(SSuperManagerResultsPanel) {}
+
+	SLATE_ARGUMENT(TSharedPtr<FSuperManagerResultsReport>, Report)
+
+	SLATE_END_ARGS()
+
+public:
+	void Construct(const FArguments& InArgs);
+	void SetReport(const TSharedPtr<FSuperManagerResultsReport>& InReport);
+
+private:
+
+#pragma region ConstructionMethods
+	TSharedRef<STreeView<TSharedPtr<FSuperManagerResultNode>>> ConstructResultsTreeView();
+
+	TSharedRef<STextBlock> ConstructTextBlock(const FString& TextContent, const FSlateFontInfo& Font, FColor Color = FColor::White, ETextJustify::Type Justify = ETextJustify::Left);
+
+	TSharedRef<SButton> ConstructActionButton(const FString& ButtonText, FReply(SSuperManagerResultsPanel::* OnClickedMethod)());
+#pragma endregion
+
+#pragma region EventsMethods
+	TSharedRef<ITableRow> OnGenerateRowForTree(TSharedPtr<FSuperManagerResultNode> NodeToDisplay, const TSharedRef<STableViewBase>& OwnerTable);
+	void OnGetChildren(TSharedPtr<FSuperManagerResultNode> Node, TArray<TSharedPtr<FSuperManagerResultNode>>& OutChildren);
+	void OnRowDoubleClick(TSharedPtr<FSuperManagerResultNode> ClickedNode);
+
+	FReply OnCopyButtonClicked();
+	FReply OnExportButtonClicked();
+	FReply OnConfirmButtonClicked();
+	FReply OnCancelButtonClicked();
+#pragma endregion
+
+#pragma region HelperMethods
+	FSlateFontInfo GetEmbossedTextFont(float Size = 10.0f);
+	void BuildNodes();
+	FString BuildReportText(bool bAsCSV) const;
+
+	FText GetTitleText() const;
+	FText GetSummaryText() const;
+	EVisibility GetConfirmVisibility() const;
+	FText GetConfirmText() const;
+#pragma endregion
+
+private:
+	TSharedPtr<FSuperManagerResultsReport> Report;
+	TArray<TSharedPtr<FSuperManagerResultNode>> RootNodes;
+
+	TSharedPtr<STreeView<TSharedPtr<FSuperManagerResultNode>>> ConstructedResultsTreeView;
+};
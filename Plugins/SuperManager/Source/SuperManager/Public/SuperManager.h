@@ -4,6 +4,13 @@
 
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
+#include "AssetAnalysis/AssetSnapshot.h"
+#include "AssetAnalysis/AssetStatusCache.h"
+#include "AssetAnalysis/TextureSimilarity.h"
+#include "AssetAnalysis/NamingConvention.h"
+
+struct FSuperManagerResultsReport;
+class SSuperManagerResultsPanel;
 
 class FSuperManagerModule : public IModuleInterface
 {
@@ -24,7 +31,21 @@ private:
 	void OnDeleteEmptyFoldersButtonCLicked();
 	void OnDeleteUnusedAssetsAndEmptyFoldersButtonCLicked();
 	void OnAdvancedDeletionButtonCLicked();
+	void OnMeshAuditButtonClicked();
+	void OnExportSnapshotButtonClicked();
+	void OnCompareSnapshotsButtonClicked();
+	void OnChunkDuplicationButtonClicked();
+	void OnMapLoadClosureButtonClicked();
 	void FixupRedirectors();
+	void AddNamingConventionMenu(class FMenuBuilder& MenuBuilder);
+
+	void DeleteEmptyFolders(const TArray<FString>& EmptyFolders);
+	bool PickSnapshotFile(const FString& DialogTitle, FString& OutFilename);
+
+public:
+	/** One registry query per asset or folder; the reference answers the snapshot queries are tested against */
+	void GatherUnusedAssets(const FString& FolderPath, TArray<FAssetData>& OutUnusedAssetsData);
+	void GatherEmptyFolders(const FString& FolderPath, TArray<FString>& OutEmptyFolders);
 
 private:
 	TArray<FString> SelectedFolderPath;
@@ -33,21 +54,80 @@ private:
 #pragma region CustomEditorTab
 private:
 	void RegisterAdvancedDeletionTab();
+	void RegisterMeshAuditTab();
+	void RegisterResultsTab();
 
 	TSharedRef<SDockTab> OnSpawnAdvancedDeletionTab(const FSpawnTabArgs& SpawnTabArgs);
+	TSharedRef<SDockTab> OnSpawnMeshAuditTab(const FSpawnTabArgs& SpawnTabArgs);
+	TSharedRef<SDockTab> OnSpawnResultsTab(const FSpawnTabArgs& SpawnTabArgs);
 
 	TArray<TSharedPtr<FAssetData>> GetAllAssetDataUnderSelectedFolder();
 
+public:
+	/** Shows the report in the results tab, opening it if needed; replaces whatever report it showed before */
+	void ShowResultsReport(const TSharedRef<FSuperManagerResultsReport>& Report);
+
+	/** One item per asset, grouped by class, double click syncs the Content Browser */
+	static void AddAssetsToReport(FSuperManagerResultsReport& Report, const TArray<FAssetData>& AssetsData);
+
+private:
+	TSharedPtr<FSuperManagerResultsReport> CurrentResultsReport;
+	TWeakPtr<SSuperManagerResultsPanel> ResultsPanel;
 #pragma endregion
 
 #pragma region ProcessDataForAdvancedDeletionWidget
 public:
 	bool DeleteSingleAsset(const FAssetData& AssetDataToDelete);
 	int32 DeleteMultipleAssets(const TArray<FAssetData>& AssetDataToDeleteArray);
+
+	/** Retargets every reference to the duplicates onto the survivor and deletes them; returns how many were merged */
+	int32 ConsolidateAssets(const FAssetData& SurvivorData, const TArray<FAssetData>& DuplicatesData);
 	void ListUnusedAssets(const TArray<TSharedPtr<FAssetData>>& AssetsDataToFilter, TArray<TSharedPtr<FAssetData>>& OutUnusedAssetData);
 	void ListSameNameAssets(const TArray<TSharedPtr<FAssetData>>& AssetsDataToFilter, TArray<TSharedPtr<FAssetData>>& OutSameNameAssetData);
+	int32 ListSimilarTextures(const TArray<TSharedPtr<FAssetData>>& AssetsDataToFilter, TArray<TSharedPtr<FAssetData>>& OutSimilarTextureData);
+	int32 ListSimilarStaticMeshes(const TArray<TSharedPtr<FAssetData>>& AssetsDataToFilter, TArray<TSharedPtr<FAssetData>>& OutSimilarMeshData);
+	int32 ListSimilarNameAssets(const TArray<TSharedPtr<FAssetData>>& AssetsDataToFilter, TArray<TSharedPtr<FAssetData>>& OutSimilarNameAssetData);
 	void SyncCBToClickedAsset(const FString& ClickedAssetPath);
 
+	/** Snapshot of all of /Game, captured on first use and dropped whenever the registry changes */
+	FSuperManagerAssetSnapshotRef GetProjectAssetSnapshot();
+
+private:
+	void RegisterAssetRegistryCallbacks();
+	void UnregisterAssetRegistryCallbacks();
+	void OnAssetAddedOrRemoved(const FAssetData& AssetData);
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+
+private:
+	TSharedPtr<const FSuperManagerAssetSnapshot> ProjectAssetSnapshot;
+	FSuperManagerTextureHashCache TextureHashCache;
+#pragma endregion
+
+#pragma region ContentBrowserAssetStatus
+public:
+	/** Unused / unreachable state of every /Game package, kept current from the registry callbacks */
+	FSuperManagerAssetStatusCache& GetAssetStatusCache() { return AssetStatusCache; }
+
+private:
+	void InitAssetStatusCache();
+	void BuildAssetStatusCache();
+	void RegisterAssetStatusIndicators();
+	void UnregisterAssetStatusIndicators();
+	TSharedRef<SWidget> OnGenerateAssetStatusIcon(const FAssetData& AssetData);
+	TSharedRef<SWidget> OnGenerateAssetStatusToolTip(const FAssetData& AssetData);
+
+private:
+	FSuperManagerAssetStatusCache AssetStatusCache;
+	FDelegateHandle AssetStatusIndicatorsHandle;
+#pragma endregion
+
+#pragma region NamingConvention
+public:
+	/** Prefix checks for newly created and imported assets, and the class to prefix lookup AddPrefixes uses */
+	FSuperManagerNamingConvention& GetNamingConvention() { return NamingConvention; }
+
+private:
+	FSuperManagerNamingConvention NamingConvention;
 #pragma endregion
 
 
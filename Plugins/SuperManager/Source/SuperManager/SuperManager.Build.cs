@@ -31,6 +31,7 @@ public class SuperManager : ModuleRules
                 "EditorScriptingUtilities",
                 "Niagara",
                 "UMG",
+                "UMGEditor",
                 "UnrealEd",
                 "AssetTools",
                 "ContentBrowser",
@@ -48,6 +49,15 @@ public class SuperManager : ModuleRules
 				"Engine",
 				"Slate",
 				"SlateCore",
+				"AssetRegistry",
+				"BlueprintGraph",
+				"SourceControl",
+				"ApplicationCore",
+				"ContentBrowserData",
+				"DesktopPlatform",
+				"ImageCore",
+				"MeshDescription",
+				"StaticMeshDescription",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);